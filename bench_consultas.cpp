@@ -0,0 +1,286 @@
+/**
+ * @file bench_consultas.cpp
+ * @brief Benchmark de latência das consultas de consumo e de alertas
+ *
+ * Para cada tamanho de base configurado, pré-carrega usuários, hidrômetros,
+ * leituras e regras de alerta e mede a distribuição de latência e as
+ * alocações de memória por chamada de:
+ * - FachadaSSMH::monitorarConsumoPorUsuario
+ * - MonitoramentoService::consultarConsumoAgregado
+ * - FachadaSSMH::verificarAlertasUsuario
+ *
+ * O resultado é emitido em JSON (stdout ou arquivo) para comparação
+ * automatizada entre commits.
+ *
+ * Uso: ./bench_consultas [--usuarios 100,1000,5000] [--hidrometros 2]
+ *                        [--leituras 48] [--consultas 500] [--saida arquivo.json]
+ */
+
+#include "src/core/fachada_ssmh.hpp"
+#include "src/usuarios/services/usuario_service.hpp"
+#include "src/monitoramento/services/monitoramento_service_factory.hpp"
+#include "src/alertas/services/alerta_service_factory.hpp"
+#include "src/utils/logger.hpp"
+#include "src/utils/benchmark.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <ctime>
+
+using namespace std;
+
+// ==================== Contagem de alocações ====================
+// Substitui o operator new global para contar alocações e bytes alocados.
+// O par new/delete usa malloc/free de forma consistente; o GCC não enxerga
+// isso ao inlinear a substituição e emite um falso positivo.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+static atomic<uint64_t> g_alocacoes{0};
+static atomic<uint64_t> g_bytesAlocados{0};
+
+void* operator new(size_t tamanho) {
+    g_alocacoes.fetch_add(1, memory_order_relaxed);
+    g_bytesAlocados.fetch_add(tamanho, memory_order_relaxed);
+    if (void* p = malloc(tamanho == 0 ? 1 : tamanho)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// ==================== Parâmetros ====================
+
+struct Parametros {
+    vector<int> tamanhosUsuarios = {100, 1000, 5000};
+    int hidrometrosPorUsuario = 2;
+    int leiturasPorHidrometro = 48;
+    int consultas = 500;
+    string arquivoSaida;
+};
+
+vector<int> lerLista(const string& texto) {
+    vector<int> valores;
+    stringstream ss(texto);
+    string item;
+    while (getline(ss, item, ',')) {
+        if (!item.empty()) valores.push_back(atoi(item.c_str()));
+    }
+    return valores;
+}
+
+bool lerParametros(int argc, char* argv[], Parametros& p) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        string valor = argv[++i];
+
+        if (arg == "--usuarios") p.tamanhosUsuarios = lerLista(valor);
+        else if (arg == "--hidrometros") p.hidrometrosPorUsuario = atoi(valor.c_str());
+        else if (arg == "--leituras") p.leiturasPorHidrometro = atoi(valor.c_str());
+        else if (arg == "--consultas") p.consultas = atoi(valor.c_str());
+        else if (arg == "--saida") p.arquivoSaida = valor;
+        else return false;
+    }
+    return !p.tamanhosUsuarios.empty() && p.hidrometrosPorUsuario > 0 &&
+           p.leiturasPorHidrometro > 0 && p.consultas > 0;
+}
+
+// ==================== Medição ====================
+
+/**
+ * @brief Resultado agregado de uma consulta em um tamanho de base
+ */
+struct ResultadoConsulta {
+    string consulta;
+    int usuarios;
+    size_t leiturasTotais;
+    size_t regrasTotais;
+    Benchmark::AmostrasLatencia latencias;
+    uint64_t alocacoes = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @brief Executa a função `consulta` para cada usuário sorteado e coleta
+ *        latência e alocações de cada chamada
+ */
+template <typename Consulta>
+void medir(ResultadoConsulta& resultado, const vector<int>& usuariosSorteados, Consulta consulta) {
+    resultado.latencias.reservar(usuariosSorteados.size());
+
+    for (int idUsuario : usuariosSorteados) {
+        uint64_t alocAntes = g_alocacoes.load(memory_order_relaxed);
+        uint64_t bytesAntes = g_bytesAlocados.load(memory_order_relaxed);
+
+        Benchmark::Cronometro cronometro;
+        consulta(idUsuario);
+        resultado.latencias.registrar(cronometro.decorridoNs());
+
+        resultado.alocacoes += g_alocacoes.load(memory_order_relaxed) - alocAntes;
+        resultado.bytes += g_bytesAlocados.load(memory_order_relaxed) - bytesAntes;
+    }
+}
+
+string paraJson(vector<ResultadoConsulta>& resultados, const Parametros& p) {
+    ostringstream json;
+    json << "{\n";
+    json << "  \"benchmark\": \"bench_consultas\",\n";
+    json << "  \"timestamp\": " << time(nullptr) << ",\n";
+    json << "  \"parametros\": {\"hidrometros_por_usuario\": " << p.hidrometrosPorUsuario
+         << ", \"leituras_por_hidrometro\": " << p.leiturasPorHidrometro
+         << ", \"consultas\": " << p.consultas << "},\n";
+    json << "  \"resultados\": [\n";
+
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        ResultadoConsulta& r = resultados[i];
+        size_t n = r.latencias.quantidade();
+        json << "    {\"consulta\": \"" << r.consulta << "\""
+             << ", \"usuarios\": " << r.usuarios
+             << ", \"leituras\": " << r.leiturasTotais
+             << ", \"regras\": " << r.regrasTotais
+             << ", \"amostras\": " << n
+             << ", \"media_ns\": " << static_cast<int64_t>(r.latencias.media())
+             << ", \"p50_ns\": " << r.latencias.percentil(50)
+             << ", \"p90_ns\": " << r.latencias.percentil(90)
+             << ", \"p99_ns\": " << r.latencias.percentil(99)
+             << ", \"max_ns\": " << r.latencias.maximo()
+             << ", \"alocacoes_por_consulta\": " << (n ? static_cast<double>(r.alocacoes) / n : 0.0)
+             << ", \"bytes_por_consulta\": " << (n ? static_cast<double>(r.bytes) / n : 0.0)
+             << "}" << (i + 1 < resultados.size() ? "," : "") << "\n";
+    }
+
+    json << "  ],\n";
+    json << "  \"pico_rss_kb\": " << Benchmark::picoMemoriaKB() << "\n";
+    json << "}\n";
+    return json.str();
+}
+
+// ==================== Execução por tamanho ====================
+
+void executarTamanho(int numUsuarios, const Parametros& p, vector<ResultadoConsulta>& resultados) {
+    auto usuarioService = make_shared<UsuarioService>();
+    auto monitoramentoService = MonitoramentoServiceFactory::criar();
+    auto repositorio = monitoramentoService->getRepositorio();
+    shared_ptr<AlertaService> alertaService;
+
+    time_t agora = time(nullptr);
+    time_t inicioLeituras = agora - static_cast<time_t>(p.leiturasPorHidrometro) * 1800;
+
+    vector<int> idsUsuarios;
+    map<int, vector<string>> hidrometrosPorUsuario;
+    size_t leiturasTotais = 0;
+    size_t regrasTotais = 0;
+
+    unique_ptr<FachadaSSMH> fachada;
+    {
+        // A carga gera uma linha de console por regra/serviço criado
+        Benchmark::SilenciarConsole silencio;
+
+        alertaService = AlertaServiceFactory::criarMinimalista();
+        fachada = make_unique<FachadaSSMH>(usuarioService, monitoramentoService, alertaService);
+
+        for (int u = 0; u < numUsuarios; ++u) {
+            Usuario usuario = usuarioService->criarUsuario({
+                {"nome", "Usuario " + to_string(u)},
+                {"email", "usuario" + to_string(u) + "@exemplo.com"}
+            });
+            idsUsuarios.push_back(usuario.getId());
+
+            for (int h = 0; h < p.hidrometrosPorUsuario; ++h) {
+                string idSha = "SHA" + to_string(u) + "_" + to_string(h);
+                usuarioService->vincularHidrometro(usuario.getId(), idSha);
+                hidrometrosPorUsuario[usuario.getId()].push_back(idSha);
+
+                int valor = 0;
+                for (int l = 0; l < p.leiturasPorHidrometro; ++l) {
+                    valor += 5 + (l % 7);
+                    repositorio->salvarLeitura(Leitura(0, idSha, valor, inicioLeituras + l * 1800));
+                    leiturasTotais++;
+                }
+            }
+
+            alertaService->salvarRegra(usuario.getId(), "LIMITE_DIARIO", "100000");
+            alertaService->salvarRegra(usuario.getId(), "DETECCAO_VAZAMENTO", "24h");
+            regrasTotais += 2;
+        }
+    }
+
+    // Mesma sequência de usuários para todas as consultas
+    mt19937 rng(1234);
+    uniform_int_distribution<size_t> sorteio(0, idsUsuarios.size() - 1);
+    vector<int> usuariosSorteados;
+    for (int i = 0; i < p.consultas; ++i) {
+        usuariosSorteados.push_back(idsUsuarios[sorteio(rng)]);
+    }
+
+    auto novoResultado = [&](const string& nome) {
+        ResultadoConsulta r;
+        r.consulta = nome;
+        r.usuarios = numUsuarios;
+        r.leiturasTotais = leiturasTotais;
+        r.regrasTotais = regrasTotais;
+        return r;
+    };
+
+    ResultadoConsulta porUsuario = novoResultado("monitorarConsumoPorUsuario");
+    medir(porUsuario, usuariosSorteados, [&](int id) {
+        fachada->monitorarConsumoPorUsuario(id, inicioLeituras, agora);
+    });
+    resultados.push_back(std::move(porUsuario));
+
+    ResultadoConsulta agregado = novoResultado("consultarConsumoAgregado");
+    medir(agregado, usuariosSorteados, [&](int id) {
+        monitoramentoService->consultarConsumoAgregado(hidrometrosPorUsuario[id], inicioLeituras, agora);
+    });
+    resultados.push_back(std::move(agregado));
+
+    // Consumo abaixo dos limites: mede o caminho de verificação sem disparo
+    ResultadoConsulta alertas = novoResultado("verificarAlertasUsuario");
+    medir(alertas, usuariosSorteados, [&](int id) {
+        fachada->verificarAlertasUsuario(id, 10.0);
+    });
+    resultados.push_back(std::move(alertas));
+}
+
+int main(int argc, char* argv[]) {
+    Parametros parametros;
+    if (!lerParametros(argc, argv, parametros)) {
+        cerr << "Uso: " << argv[0] << " [--usuarios 100,1000,5000] [--hidrometros 2]"
+             << " [--leituras 48] [--consultas 500] [--saida arquivo.json]\n";
+        return 1;
+    }
+
+    // INFO/WARNING só vão para o console fora do modo runtime
+    Logger::setRuntimeMode(true);
+
+    vector<ResultadoConsulta> resultados;
+    for (int tamanho : parametros.tamanhosUsuarios) {
+        cerr << "[bench_consultas] Base com " << tamanho << " usuários..." << endl;
+        executarTamanho(tamanho, parametros, resultados);
+    }
+
+    string json = paraJson(resultados, parametros);
+
+    if (parametros.arquivoSaida.empty()) {
+        cout << json;
+    } else {
+        ofstream arquivo(parametros.arquivoSaida);
+        arquivo << json;
+        cerr << "[bench_consultas] Resultado gravado em " << parametros.arquivoSaida << endl;
+    }
+
+    return 0;
+}
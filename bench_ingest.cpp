@@ -0,0 +1,233 @@
+/**
+ * @file bench_ingest.cpp
+ * @brief Benchmark de ingestão de leituras (throughput ponta a ponta)
+ *
+ * Gera uma carga sintética de N hidrômetros × M leituras com padrões
+ * realistas e a injeta por três caminhos, sempre com o timestamp sintético:
+ * - Fachada: FachadaSSMH::registrarLeituraManual (log + serviço + DAO)
+ * - Repositório: LeituraDAO::salvarLeitura diretamente
+ * - Fachada com o Logger em modo assíncrono
+ *
+ * Para cada caminho reporta leituras/s, latência p50/p99 e o pico de RSS,
+ * permitindo acompanhar regressões de desempenho entre commits. As métricas
+ * internas coletadas durante a execução são exportadas em bench_ingest.prom.
+ *
+ * Uso: ./bench_ingest [hidrometros] [leituras_por_hidrometro]
+ */
+
+#include "src/core/fachada_ssmh.hpp"
+#include "src/usuarios/services/usuario_service.hpp"
+#include "src/monitoramento/services/monitoramento_service_factory.hpp"
+#include "src/alertas/services/alerta_service_factory.hpp"
+#include "src/utils/logger.hpp"
+#include "src/utils/benchmark.hpp"
+#include "src/utils/metricas.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <ctime>
+
+using namespace std;
+
+// Intervalo entre leituras consecutivas de um mesmo hidrômetro
+const int INTERVALO_LEITURA_S = 15 * 60;
+
+/**
+ * @brief Leitura gerada previamente para não contaminar a medição
+ */
+struct LeituraSintetica {
+    string idSha;
+    int valor;
+    time_t dataHora;
+};
+
+enum class PerfilConsumo { NORMAL, VAZAMENTO };
+
+/**
+ * @brief Vazão típica (L/h) de uma residência ao longo do dia
+ *
+ * Madrugada praticamente sem consumo, picos pela manhã e à noite.
+ */
+double vazaoPorHora(int hora) {
+    if (hora < 5)  return 0.0;
+    if (hora < 6)  return 4.0;
+    if (hora < 9)  return 40.0;
+    if (hora < 12) return 12.0;
+    if (hora < 14) return 25.0;
+    if (hora < 18) return 8.0;
+    if (hora < 22) return 35.0;
+    return 6.0;
+}
+
+/**
+ * @brief Gera M leituras acumuladas para cada um dos N hidrômetros
+ *
+ * - Ciclo diário: vazão segue vazaoPorHora() com fator de escala por imóvel
+ * - Vazamentos: ~10% dos hidrômetros somam fluxo constante de 2-6 L/h
+ * - Outliers: ~1% das leituras trazem um pico de consumo (ex: enchimento
+ *   de piscina) ou um valor corrompido pelo OCR
+ */
+vector<LeituraSintetica> gerarCarga(int numHidrometros, int leiturasPorHidrometro,
+                                    time_t inicio, int& totalVazamentos) {
+    mt19937 rng(42);
+    uniform_real_distribution<double> escala(0.5, 1.5);
+    uniform_real_distribution<double> vazamento(2.0, 6.0);
+    uniform_real_distribution<double> uniforme(0.0, 1.0);
+    normal_distribution<double> ruido(1.0, 0.15);
+
+    vector<LeituraSintetica> carga;
+    carga.reserve(static_cast<size_t>(numHidrometros) * leiturasPorHidrometro);
+    totalVazamentos = 0;
+
+    for (int h = 0; h < numHidrometros; ++h) {
+        string idSha = "SHA" + to_string(100000 + h);
+        PerfilConsumo perfil = uniforme(rng) < 0.10 ? PerfilConsumo::VAZAMENTO
+                                                    : PerfilConsumo::NORMAL;
+        if (perfil == PerfilConsumo::VAZAMENTO) totalVazamentos++;
+
+        double fator = escala(rng);
+        double fluxoVazamento = perfil == PerfilConsumo::VAZAMENTO ? vazamento(rng) : 0.0;
+        double acumulado = 1000.0 * h;
+
+        for (int i = 0; i < leiturasPorHidrometro; ++i) {
+            time_t dataHora = inicio + static_cast<time_t>(i) * INTERVALO_LEITURA_S;
+            int hora = static_cast<int>((dataHora / 3600) % 24);
+
+            double horasIntervalo = INTERVALO_LEITURA_S / 3600.0;
+            double consumo = (vazaoPorHora(hora) * fator * max(0.0, ruido(rng)) +
+                              fluxoVazamento) * horasIntervalo;
+
+            int valorLido;
+            double sorteio = uniforme(rng);
+            if (sorteio < 0.005) {
+                // Pico real de consumo
+                acumulado += consumo + 500.0 + uniforme(rng) * 1500.0;
+                valorLido = static_cast<int>(acumulado);
+            } else if (sorteio < 0.01) {
+                // Leitura corrompida (não altera o acumulado real)
+                acumulado += consumo;
+                valorLido = static_cast<int>(uniforme(rng) * 1e6);
+            } else {
+                acumulado += consumo;
+                valorLido = static_cast<int>(acumulado);
+            }
+
+            carga.push_back({idSha, valorLido, dataHora});
+        }
+    }
+
+    return carga;
+}
+
+void imprimirResultado(const string& caminho, size_t total, double segundos,
+                       Benchmark::AmostrasLatencia& latencias) {
+    cout << "  " << left << setw(14) << caminho << right
+         << setw(10) << total
+         << setw(14) << fixed << setprecision(0) << (total / segundos)
+         << setw(12) << setprecision(2) << latencias.percentil(50) / 1000.0
+         << setw(12) << latencias.percentil(99) / 1000.0
+         << setw(12) << latencias.maximo() / 1000.0
+         << setw(12) << Benchmark::picoMemoriaKB() / 1024.0 << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int numHidrometros = argc > 1 ? atoi(argv[1]) : 100;
+    int leiturasPorHidrometro = argc > 2 ? atoi(argv[2]) : 200;
+
+    if (numHidrometros <= 0 || leiturasPorHidrometro <= 0) {
+        cerr << "Uso: " << argv[0] << " [hidrometros] [leituras_por_hidrometro]\n";
+        return 1;
+    }
+
+    // Mantém o console limpo: INFO/WARNING só vão para o console fora do modo runtime
+    Logger::setRuntimeMode(true);
+
+    int totalVazamentos = 0;
+    time_t inicio = time(nullptr) - static_cast<time_t>(leiturasPorHidrometro) * INTERVALO_LEITURA_S;
+    vector<LeituraSintetica> carga = gerarCarga(numHidrometros, leiturasPorHidrometro,
+                                                inicio, totalVazamentos);
+
+    cout << "╔═══════════════════════════════════════════════════════════════════╗\n";
+    cout << "║             BENCHMARK DE INGESTÃO DE LEITURAS - SSMH              ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════════╝\n";
+    cout << "Hidrômetros: " << numHidrometros
+         << " | Leituras/hidrômetro: " << leiturasPorHidrometro
+         << " | Total: " << carga.size()
+         << " | Com vazamento: " << totalVazamentos << "\n\n";
+
+    // Serviços são criados antes da tabela (os construtores imprimem no console)
+    auto usuarioService = make_shared<UsuarioService>();
+    auto alertaService = AlertaServiceFactory::criarMinimalista();
+    FachadaSSMH fachada(usuarioService, MonitoramentoServiceFactory::criar(), alertaService);
+    auto repositorio = MonitoramentoServiceFactory::criar()->getRepositorio();
+    cout << "\n";
+
+    cout << "  " << left << setw(14) << "Caminho" << right
+         << setw(10) << "Leituras"
+         << setw(14) << "Leituras/s"
+         << setw(12) << "p50 (us)"
+         << setw(12) << "p99 (us)"
+         << setw(12) << "max (us)"
+         << setw(12) << "RSS (MB)" << "\n";
+    cout << "  " << string(84, '-') << "\n";
+
+    // ---------- Caminho 1: Fachada ----------
+    {
+        Benchmark::AmostrasLatencia latencias;
+        latencias.reservar(carga.size());
+
+        Benchmark::Cronometro total;
+        for (const auto& leitura : carga) {
+            Benchmark::Cronometro cronometro;
+            fachada.registrarLeituraManual(leitura.idSha, leitura.valor, leitura.dataHora);
+            latencias.registrar(cronometro.decorridoNs());
+        }
+        double segundos = total.decorridoSegundos();
+
+        imprimirResultado("Fachada", carga.size(), segundos, latencias);
+    }
+
+    // ---------- Caminho 2: Repositório direto ----------
+    {
+        Benchmark::AmostrasLatencia latencias;
+        latencias.reservar(carga.size());
+
+        Benchmark::Cronometro total;
+        for (const auto& leitura : carga) {
+            Benchmark::Cronometro cronometro;
+            repositorio->salvarLeitura(Leitura(0, leitura.idSha, leitura.valor, leitura.dataHora));
+            latencias.registrar(cronometro.decorridoNs());
+        }
+        double segundos = total.decorridoSegundos();
+
+        imprimirResultado("Repositorio", carga.size(), segundos, latencias);
+    }
+
+    // ---------- Caminho 3: Fachada com log assíncrono ----------
+    {
+        Logger::getInstance().setModoAssincrono(true);
+
+        Benchmark::AmostrasLatencia latencias;
+        latencias.reservar(carga.size());
+
+        Benchmark::Cronometro total;
+        for (const auto& leitura : carga) {
+            Benchmark::Cronometro cronometro;
+            fachada.registrarLeituraManual(leitura.idSha, leitura.valor, leitura.dataHora);
+            latencias.registrar(cronometro.decorridoNs());
+        }
+        double segundos = total.decorridoSegundos();
+        Logger::getInstance().setModoAssincrono(false);
+
+        imprimirResultado("Fachada async", carga.size(), segundos, latencias);
+    }
+
+    if (RegistroMetricas::getInstance().exportarPrometheusArquivo("bench_ingest.prom")) {
+        cout << "\nMétricas internas exportadas em bench_ingest.prom\n";
+    }
+
+    cout << "\n✓ Benchmark concluído\n";
+    return 0;
+}
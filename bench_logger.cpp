@@ -0,0 +1,155 @@
+/**
+ * @file bench_logger.cpp
+ * @brief Microbenchmark do custo por linha do Logger
+ *
+ * Mede, com 1 e com N threads:
+ * - Timestamp: time + localtime_r + strftime (formatação a cada linha,
+ *   como o Logger fazia) contra o CacheTimestamp compartilhado
+ * - Logger::log síncrono em arquivo, com e sem milissegundos
+ * - Logger::log no modo assíncrono (custo para a thread que loga)
+ *
+ * Uso: ./bench_logger [iteracoes_por_thread] [threads]
+ */
+
+#include "src/utils/logger.hpp"
+#include "src/utils/cache_timestamp.hpp"
+#include "src/utils/benchmark.hpp"
+#include <cstdio>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const char* ARQUIVO_LOG = "bench_logger.log";
+
+// Evita que o compilador descarte o resultado da formatação
+volatile char sumidouro;
+
+/**
+ * @brief Executa `corpo(iteracoes)` em `numThreads` threads e devolve ns por chamada
+ */
+double medirNsPorChamada(int numThreads, int iteracoes, const function<void(int)>& corpo) {
+    Benchmark::Cronometro cronometro;
+    if (numThreads == 1) {
+        corpo(iteracoes);
+    } else {
+        vector<thread> threads;
+        for (int t = 0; t < numThreads; ++t) {
+            threads.emplace_back(corpo, iteracoes);
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    // Tempo de parede dividido pelo total: com N threads é o custo por
+    // linha visto pelo sistema (escalabilidade), não por thread
+    return static_cast<double>(cronometro.decorridoNs()) / (static_cast<double>(iteracoes) * numThreads);
+}
+
+void timestampLegado(int iteracoes) {
+    char buffer[20];
+    for (int i = 0; i < iteracoes; ++i) {
+        time_t agora = time(nullptr);
+        tm ltm;
+        localtime_r(&agora, &ltm);
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &ltm);
+        sumidouro = buffer[18];
+    }
+}
+
+CacheTimestamp cache;
+
+void timestampCache(int iteracoes) {
+    char buffer[CacheTimestamp::TAMANHO_BUFFER];
+    for (int i = 0; i < iteracoes; ++i) {
+        cache.formatarAgora(buffer, false);
+        sumidouro = buffer[18];
+    }
+}
+
+void timestampCacheMs(int iteracoes) {
+    char buffer[CacheTimestamp::TAMANHO_BUFFER];
+    for (int i = 0; i < iteracoes; ++i) {
+        cache.formatarAgora(buffer, true);
+        sumidouro = buffer[22];
+    }
+}
+
+void logarLinhas(int iteracoes) {
+    Logger& logger = Logger::getInstance();
+    const string contexto = "BenchLogger";
+    const string mensagem = "Leitura registrada para o hidrometro SHA-000123: 4521 L";
+    for (int i = 0; i < iteracoes; ++i) {
+        logger.log(LogLevel::INFO, contexto, mensagem);
+    }
+}
+
+void imprimirLinha(const string& caso, double ns1, double nsN) {
+    cout << "  " << left << setw(34) << caso << right
+         << setw(12) << fixed << setprecision(1) << ns1
+         << setw(14) << nsN << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    int iteracoes = argc > 1 ? atoi(argv[1]) : 200000;
+    int numThreads = argc > 2 ? atoi(argv[2]) : 4;
+
+    if (iteracoes <= 0 || numThreads <= 0) {
+        cerr << "Uso: " << argv[0] << " [iteracoes_por_thread] [threads]\n";
+        return 1;
+    }
+
+    // Só o arquivo recebe as linhas: INFO não vai para o console em modo runtime
+    Logger::setRuntimeMode(true);
+    remove(ARQUIVO_LOG);
+    Logger& logger = Logger::getInstance();
+    logger.setArquivoLog(ARQUIVO_LOG);
+
+    cout << "╔═══════════════════════════════════════════════════════════════════╗\n";
+    cout << "║                 MICROBENCHMARK DO LOGGER - SSMH                   ║\n";
+    cout << "╚═══════════════════════════════════════════════════════════════════╝\n";
+    cout << "Iterações por thread: " << iteracoes << " | Threads: " << numThreads << "\n\n";
+
+    cout << "  " << left << setw(34) << "Caso (ns/linha)" << right
+         << setw(12) << "1 thread" << setw(14) << (to_string(numThreads) + " threads") << "\n";
+    cout << "  " << string(60, '-') << "\n";
+
+    auto medir = [&](const string& caso, const function<void(int)>& corpo) {
+        double ns1 = medirNsPorChamada(1, iteracoes, corpo);
+        double nsN = medirNsPorChamada(numThreads, iteracoes, corpo);
+        imprimirLinha(caso, ns1, nsN);
+        return ns1;
+    };
+
+    double legado = medir("timestamp: localtime + strftime", timestampLegado);
+    double cacheado = medir("timestamp: CacheTimestamp", timestampCache);
+    medir("timestamp: CacheTimestamp (.mmm)", timestampCacheMs);
+
+    medir("Logger::log síncrono (arquivo)", logarLinhas);
+    logger.setTimestampMilissegundos(true);
+    medir("Logger::log síncrono (.mmm)", logarLinhas);
+    logger.setTimestampMilissegundos(false);
+
+    logger.setModoAssincrono(true, 1 << 20);
+    medir("Logger::log assíncrono", [&](int n) {
+        logarLinhas(n);
+        logger.descarregar();
+    });
+    logger.setModoAssincrono(false);
+    if (logger.getMensagensDescartadas() > 0) {
+        cout << "  (assíncrono: " << logger.getMensagensDescartadas() << " mensagens descartadas)\n";
+    }
+
+    logger.fecharArquivo();
+    remove(ARQUIVO_LOG);
+
+    cout << "\nTimestamp em cache: " << fixed << setprecision(1)
+         << (cacheado > 0 ? legado / cacheado : 0.0) << "x mais rápido (1 thread)\n";
+    cout << "\n✓ Benchmark concluído\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file logdecode.cpp
+ * @brief Converte logs binários do Logger (modo binário) para o formato texto
+ *
+ * Cada registro é impresso como no arquivo texto:
+ *   [AAAA-MM-DD HH:MM:SS] [NÍVEL] [contexto] mensagem
+ *
+ * Arquivos rotacionados podem ser passados juntos, do mais antigo para o
+ * mais recente (ex: ./logdecode ssmh.blog.2 ssmh.blog.1 ssmh.blog).
+ *
+ * Uso: ./logdecode [--ms] arquivo.blog [arquivo.blog ...]
+ */
+
+#include "src/utils/log_binario.hpp"
+#include "src/utils/logger.hpp"
+#include <cstdio>
+#include <ctime>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+string formatarTimestamp(int64_t timestampNs, bool comMilissegundos) {
+    time_t segundos = static_cast<time_t>(timestampNs / 1000000000);
+    tm ltm;
+    localtime_r(&segundos, &ltm);
+
+    char texto[32];
+    size_t n = strftime(texto, sizeof(texto), "%Y-%m-%d %H:%M:%S", &ltm);
+    if (comMilissegundos) {
+        snprintf(texto + n, sizeof(texto) - n, ".%03d",
+                 static_cast<int>((timestampNs / 1000000) % 1000));
+    }
+    return texto;
+}
+
+int main(int argc, char* argv[]) {
+    bool comMilissegundos = false;
+    vector<string> arquivos;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--ms") {
+            comMilissegundos = true;
+        } else {
+            arquivos.push_back(arg);
+        }
+    }
+
+    if (arquivos.empty()) {
+        cerr << "Uso: " << argv[0] << " [--ms] arquivo.blog [arquivo.blog ...]\n";
+        return 1;
+    }
+
+    int status = 0;
+    for (const auto& caminho : arquivos) {
+        try {
+            LeitorLogBinario leitor(caminho);
+            LeitorLogBinario::Registro registro;
+            while (leitor.proximo(registro)) {
+                cout << "[" << formatarTimestamp(registro.timestampNs, comMilissegundos) << "] ["
+                     << Logger::nomeNivel(static_cast<LogLevel>(registro.nivel)) << "] ["
+                     << registro.contexto << "] " << registro.mensagem << "\n";
+            }
+        } catch (const exception& e) {
+            cerr << "[logdecode] " << e.what() << endl;
+            status = 1;
+        }
+    }
+
+    return status;
+}
@@ -0,0 +1,47 @@
+#ifndef PARAMETROS_REGRA_HPP
+#define PARAMETROS_REGRA_HPP
+
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Parâmetros de uma regra de alerta já convertidos do texto configurado
+ *
+ * Preenchidos uma única vez, ao salvar a regra, pela estratégia responsável
+ * (EstrategiaAnaliseConsumo::compilarParametros); a avaliação lê os campos
+ * diretamente, sem voltar a interpretar o texto. Cada estratégia usa apenas
+ * os campos do seu tipo.
+ */
+struct ParametrosRegra {
+    double limiteLitros = 0.0;          // LIMITE_DIARIO: consumo máximo no dia
+    double percentualDesvio = 0.0;      // MEDIA_MOVEL: % tolerado acima da média
+    int periodoHoras = 0;               // DETECCAO_VAZAMENTO: duração do fluxo contínuo
+    double valorExpressao = 0.0;        // ExpressaoStrategy: valor da variável `parametro`
+    double referenciaSeveridade = 0.0;  // Base do excesso percentual (0 = severidade MEDIA)
+};
+
+/**
+ * @brief Converte `texto` em número exigindo que seja consumido por inteiro
+ *
+ * @param sufixo Sufixo opcional aceito após o número (ex: 'h' em "24h"); '\0' para nenhum
+ * @throws std::invalid_argument se o texto não for um número finito
+ */
+inline double converterParametroNumerico(const std::string& texto, char sufixo = '\0') {
+    const char* inicio = texto.c_str();
+    char* fim = nullptr;
+    errno = 0;
+    double valor = std::strtod(inicio, &fim);
+
+    if (fim != inicio && sufixo != '\0' && *fim == sufixo) {
+        ++fim;
+    }
+    if (fim == inicio || *fim != '\0' || errno == ERANGE || !std::isfinite(valor)) {
+        throw std::invalid_argument("valor numérico inválido: '" + texto + "'");
+    }
+    return valor;
+}
+
+#endif // PARAMETROS_REGRA_HPP
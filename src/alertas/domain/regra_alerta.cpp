@@ -22,11 +22,11 @@ int RegraAlerta::getUsuarioId() const {
     return usuarioId;
 }
 
-std::string RegraAlerta::getTipoEstrategia() const {
+const std::string& RegraAlerta::getTipoEstrategia() const {
     return tipoEstrategia;
 }
 
-std::string RegraAlerta::getValorParametro() const {
+const std::string& RegraAlerta::getValorParametro() const {
     return valorParametro;
 }
 
@@ -38,6 +38,10 @@ time_t RegraAlerta::getDataCriacao() const {
     return dataCriacao;
 }
 
+const ParametrosRegra& RegraAlerta::getParametros() const {
+    return parametros;
+}
+
 // Setters
 void RegraAlerta::setId(int id) {
     this->id = id;
@@ -63,6 +67,10 @@ void RegraAlerta::setDataCriacao(time_t dataCriacao) {
     this->dataCriacao = dataCriacao;
 }
 
+void RegraAlerta::setParametros(const ParametrosRegra& parametros) {
+    this->parametros = parametros;
+}
+
 // Métodos auxiliares
 std::string RegraAlerta::toString() const {
     std::stringstream ss;
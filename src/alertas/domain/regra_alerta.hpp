@@ -1,6 +1,7 @@
 #ifndef REGRA_ALERTA_HPP
 #define REGRA_ALERTA_HPP
 
+#include "parametros_regra.hpp"
 #include <string>
 #include <ctime>
 
@@ -18,6 +19,7 @@ private:
     std::string valorParametro;  // Valor de ajuste (ex: "70" para limite, "24h" para vazamento)
     bool ativo;
     time_t dataCriacao;
+    ParametrosRegra parametros;  // valorParametro já interpretado pela estratégia
 
 public:
     // Construtores
@@ -28,10 +30,11 @@ public:
     // Getters
     int getId() const;
     int getUsuarioId() const;
-    std::string getTipoEstrategia() const;
-    std::string getValorParametro() const;
+    const std::string& getTipoEstrategia() const;
+    const std::string& getValorParametro() const;
     bool isAtivo() const;
     time_t getDataCriacao() const;
+    const ParametrosRegra& getParametros() const;
 
     // Setters
     void setId(int id);
@@ -40,6 +43,7 @@ public:
     void setValorParametro(const std::string& valorParametro);
     void setAtivo(bool ativo);
     void setDataCriacao(time_t dataCriacao);
+    void setParametros(const ParametrosRegra& parametros);
 
     // Métodos auxiliares
     std::string toString() const;
@@ -0,0 +1,81 @@
+#include "cache_tokens_oauth.hpp"
+#include <exception>
+#include <iterator>
+
+CacheTokensOAuth& CacheTokensOAuth::getInstance() {
+    // Nunca destruído, como o pool de conexões
+    static CacheTokensOAuth* instancia = new CacheTokensOAuth();
+    return *instancia;
+}
+
+bool CacheTokensOAuth::obter(const std::string& chave, const Renovador& renovar, std::string& token) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        Entrada& entrada = entradas_[chave];
+        auto agora = std::chrono::steady_clock::now();
+        bool valido = !entrada.token.empty() && agora < entrada.expira;
+
+        if (valido && agora < entrada.expira - margemRenovacao_) {
+            token = entrada.token;
+            return true;
+        }
+
+        if (entrada.renovando) {
+            if (valido) {
+                token = entrada.token;  // Outra thread já renova; o atual ainda serve
+                return true;
+            }
+            cvRenovacao_.wait(lock);
+            continue;
+        }
+
+        // Esta thread renova, sem segurar o lock durante a requisição
+        entrada.renovando = true;
+        lock.unlock();
+
+        std::string novo;
+        long validadeSegundos = 0;
+        bool ok = false;
+        try {
+            ok = renovar(novo, validadeSegundos) && !novo.empty() && validadeSegundos > 0;
+        } catch (const std::exception&) {
+            ok = false;
+        }
+
+        lock.lock();
+        Entrada& atualizada = entradas_[chave];
+        atualizada.renovando = false;
+        if (ok) {
+            atualizada.token = novo;
+            atualizada.expira = std::chrono::steady_clock::now() + std::chrono::seconds(validadeSegundos);
+            ++renovacoes_;
+        }
+        cvRenovacao_.notify_all();
+
+        // Se a renovação falhou, o token anterior ainda pode estar válido
+        if (!atualizada.token.empty() && std::chrono::steady_clock::now() < atualizada.expira) {
+            token = atualizada.token;
+            return true;
+        }
+        return false;
+    }
+}
+
+void CacheTokensOAuth::setMargemRenovacao(std::chrono::seconds margem) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    margemRenovacao_ = margem;
+}
+
+void CacheTokensOAuth::limpar() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Entradas em renovação continuam: a thread que renova ainda vai preenchê-las
+    for (auto it = entradas_.begin(); it != entradas_.end(); ) {
+        it = it->second.renovando ? std::next(it) : entradas_.erase(it);
+    }
+}
+
+uint64_t CacheTokensOAuth::getRenovacoes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return renovacoes_;
+}
@@ -0,0 +1,62 @@
+#ifndef CACHE_TOKENS_OAUTH_HPP
+#define CACHE_TOKENS_OAUTH_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Cache de access tokens OAuth2 compartilhado pelo processo
+ *
+ * Todas as instâncias que usam as mesmas credenciais (mesma chave)
+ * compartilham o token. A renovação é proativa: a partir de
+ * `margemRenovacao` antes de expirar, a primeira thread que pedir o token
+ * o renova enquanto as demais continuam usando o atual, ainda válido. Só
+ * quando não há token válido as threads esperam pela renovação em curso,
+ * que é sempre uma só por chave.
+ */
+class CacheTokensOAuth {
+public:
+    /**
+     * @brief Obtém um token novo; preenche o token e a validade em segundos
+     */
+    using Renovador = std::function<bool(std::string& token, long& validadeSegundos)>;
+
+    static CacheTokensOAuth& getInstance();
+
+    /**
+     * @brief Devolve em `token` um access token válido para `chave`
+     * @return false se não houver token válido e a renovação falhar
+     */
+    bool obter(const std::string& chave, const Renovador& renovar, std::string& token);
+
+    void setMargemRenovacao(std::chrono::seconds margem);
+
+    /**
+     * @brief Esquece todos os tokens
+     */
+    void limpar();
+
+    uint64_t getRenovacoes() const;
+
+private:
+    CacheTokensOAuth() = default;
+
+    struct Entrada {
+        std::string token;
+        std::chrono::steady_clock::time_point expira;
+        bool renovando = false;
+    };
+
+    mutable std::mutex mutex_;
+    std::condition_variable cvRenovacao_;
+    std::map<std::string, Entrada> entradas_;
+    std::chrono::seconds margemRenovacao_{300};
+    uint64_t renovacoes_ = 0;
+};
+
+#endif // CACHE_TOKENS_OAUTH_HPP
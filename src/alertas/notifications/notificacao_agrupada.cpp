@@ -0,0 +1,123 @@
+#include "notificacao_agrupada.hpp"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+NotificacaoAgrupada::NotificacaoAgrupada(std::shared_ptr<NotificacaoStrategy> canal,
+                                         std::chrono::milliseconds janela,
+                                         size_t maxPorResumo)
+    : canal_(std::move(canal)),
+      janela_(janela),
+      maxPorResumo_(std::max<size_t>(1, maxPorResumo)),
+      fila_([this](Envio& envio) { enviarGrupo(envio); }) {
+    if (!canal_) {
+        throw std::invalid_argument("NotificacaoAgrupada: canal não pode ser nulo");
+    }
+}
+
+bool NotificacaoAgrupada::enviar(const std::string& mensagem, const std::string& destinatario) {
+    bool novo;
+    bool cheio;
+    Envio envio;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, criado] = grupos_.try_emplace(destinatario);
+        Grupo& grupo = it->second;
+        if (criado) {
+            grupo.geracao = ++geracoes_;
+        }
+        grupo.mensagens.push_back(mensagem);
+        novo = criado;
+        cheio = grupo.mensagens.size() == maxPorResumo_;
+        envio = {destinatario, grupo.geracao};
+    }
+    // O pedido que chegar depois do grupo enviado é ignorado (ver enviarGrupo)
+    if (novo) {
+        fila_.enfileirar(envio, std::chrono::steady_clock::now() + janela_);
+    }
+    if (cheio) {
+        fila_.enfileirar(std::move(envio));
+    }
+    return true;
+}
+
+std::string NotificacaoAgrupada::getNomeCanal() const {
+    return canal_->getNomeCanal() + "_RESUMO";
+}
+
+bool NotificacaoAgrupada::isDisponivel() const {
+    return canal_->isDisponivel();
+}
+
+void NotificacaoAgrupada::descarregar() {
+    std::map<std::string, Grupo> prontos;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prontos.swap(grupos_);
+    }
+    for (const auto& [destinatario, grupo] : prontos) {
+        enviarResumo(destinatario, grupo.mensagens);
+    }
+}
+
+uint64_t NotificacaoAgrupada::getResumosEnviados() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resumosEnviados_;
+}
+
+uint64_t NotificacaoAgrupada::getMensagensAgrupadas() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return mensagensAgrupadas_;
+}
+
+uint64_t NotificacaoAgrupada::getFalhasEnvio() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return falhasEnvio_;
+}
+
+void NotificacaoAgrupada::enviarGrupo(Envio& envio) {
+    std::vector<std::string> mensagens;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = grupos_.find(envio.destinatario);
+        if (it == grupos_.end() || it->second.geracao != envio.geracao) {
+            return;  // já enviado (grupo cheio ou descarregar())
+        }
+        mensagens = std::move(it->second.mensagens);
+        grupos_.erase(it);
+    }
+    enviarResumo(envio.destinatario, mensagens);
+}
+
+void NotificacaoAgrupada::enviarResumo(const std::string& destinatario,
+                                       const std::vector<std::string>& mensagens) {
+    if (mensagens.empty()) {
+        return;
+    }
+
+    const std::string texto = mensagens.size() == 1 ? mensagens.front() : formatarResumo(mensagens);
+    bool enviado = false;
+    try {
+        enviado = canal_->enviar(texto, destinatario);
+    } catch (const std::exception& e) {
+        std::cerr << "[RESUMO] Erro ao enviar para " << destinatario << ": " << e.what() << std::endl;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (enviado) {
+        ++resumosEnviados_;
+        mensagensAgrupadas_ += mensagens.size();
+    } else {
+        ++falhasEnvio_;
+    }
+}
+
+std::string NotificacaoAgrupada::formatarResumo(const std::vector<std::string>& mensagens) const {
+    std::ostringstream resumo;
+    resumo << "Resumo de " << mensagens.size() << " alertas de consumo:\r\n\r\n";
+    for (size_t i = 0; i < mensagens.size(); ++i) {
+        resumo << (i + 1) << ". " << mensagens[i] << "\r\n\r\n";
+    }
+    return resumo.str();
+}
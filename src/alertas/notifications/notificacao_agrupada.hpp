@@ -0,0 +1,81 @@
+#ifndef NOTIFICACAO_AGRUPADA_HPP
+#define NOTIFICACAO_AGRUPADA_HPP
+
+#include "notificacao_strategy.hpp"
+#include "../../utils/fila_trabalho.hpp"
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Decorator que agrupa notificações por destinatário em resumos
+ * 
+ * enviar() apenas guarda a mensagem no grupo do destinatário. Quando a
+ * primeira mensagem do grupo completa a janela configurada (ou o grupo
+ * atinge `maxPorResumo`), uma FilaTrabalho envia todas de uma vez pelo
+ * canal decorado, como um único resumo. Num evento que gera milhares de
+ * alertas, cada destinatário recebe poucos emails em vez de um por alerta.
+ * 
+ * Grupos com uma única mensagem são enviados sem o cabeçalho de resumo.
+ * O destrutor envia o que estiver pendente.
+ */
+class NotificacaoAgrupada : public NotificacaoStrategy {
+public:
+    NotificacaoAgrupada(std::shared_ptr<NotificacaoStrategy> canal,
+                        std::chrono::milliseconds janela = std::chrono::seconds(60),
+                        size_t maxPorResumo = 200);
+
+    NotificacaoAgrupada(const NotificacaoAgrupada&) = delete;
+    NotificacaoAgrupada& operator=(const NotificacaoAgrupada&) = delete;
+
+    /**
+     * @brief Acrescenta a mensagem ao resumo do destinatário (não envia)
+     */
+    bool enviar(const std::string& mensagem, const std::string& destinatario) override;
+    std::string getNomeCanal() const override;
+    bool isDisponivel() const override;
+
+    /**
+     * @brief Envia agora, na thread chamadora, todos os grupos pendentes
+     */
+    void descarregar();
+
+    uint64_t getResumosEnviados() const;
+    uint64_t getMensagensAgrupadas() const;
+    uint64_t getFalhasEnvio() const;
+
+private:
+    struct Grupo {
+        std::vector<std::string> mensagens;
+        uint64_t geracao;  // distingue o grupo de outro mais novo do mesmo destinatário
+    };
+
+    // Pedido de envio de um grupo: no prazo da janela, ou imediato se encheu
+    struct Envio {
+        std::string destinatario;
+        uint64_t geracao;
+    };
+
+    void enviarGrupo(Envio& envio);
+    void enviarResumo(const std::string& destinatario, const std::vector<std::string>& mensagens);
+    std::string formatarResumo(const std::vector<std::string>& mensagens) const;
+
+    std::shared_ptr<NotificacaoStrategy> canal_;
+    std::chrono::milliseconds janela_;
+    size_t maxPorResumo_;
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Grupo> grupos_;
+    uint64_t geracoes_ = 0;
+
+    uint64_t resumosEnviados_ = 0;
+    uint64_t mensagensAgrupadas_ = 0;
+    uint64_t falhasEnvio_ = 0;
+
+    FilaTrabalho<Envio> fila_;
+};
+
+#endif // NOTIFICACAO_AGRUPADA_HPP
@@ -1,9 +1,12 @@
 #include "notificacao_email.hpp"
+#include "cache_tokens_oauth.hpp"
+#include "pool_conexoes_curl.hpp"
 #include <iostream>
 #include <regex>
 #include <sstream>
 #include <ctime>
 #include <iomanip>
+#include <cstdlib>
 #include <cstring>
 #include <curl/curl.h>
 
@@ -18,10 +21,12 @@ NotificacaoEmail::NotificacaoEmail()
       remetente("alertas@cagepa.com.br"), 
       nomeRemetente("Sistema SSMH - Alertas"),
       configurado(false),
-      tokenExpiry(0),
+      endpointToken("https://oauth2.googleapis.com/token"),
       verifySSL(true),
       verbose(false),
-      timeout(30) {
+      timeout(30),
+      usarTLS(true),
+      usarOAuth2(true) {
     
     // Tenta carregar configuração do arquivo
     carregarConfiguracao();
@@ -33,10 +38,12 @@ NotificacaoEmail::NotificacaoEmail(const std::string& servidor, int porta, const
       remetente(remetente),
       nomeRemetente("Sistema SSMH - Alertas"),
       configurado(false),
-      tokenExpiry(0),
+      endpointToken("https://oauth2.googleapis.com/token"),
       verifySSL(true),
       verbose(false),
-      timeout(30) {
+      timeout(30),
+      usarTLS(true),
+      usarOAuth2(true) {
     
     // Tenta carregar configuração OAuth2
     carregarConfiguracao();
@@ -54,13 +61,15 @@ NotificacaoEmail::NotificacaoEmail(const std::string& remetente,
       clientId(clientId),
       clientSecret(clientSecret),
       refreshToken(refreshToken),
-      tokenExpiry(0),
+      endpointToken("https://oauth2.googleapis.com/token"),
       verifySSL(true),
       verbose(false),
-      timeout(30) {}
+      timeout(30),
+      usarTLS(true),
+      usarOAuth2(true) {}
 
 NotificacaoEmail::~NotificacaoEmail() {
-    // Limpeza se necessário
+    // Conexões pertencem ao PoolConexoesCurl e continuam disponíveis
 }
 
 bool NotificacaoEmail::carregarConfiguracao() {
@@ -121,6 +130,24 @@ void NotificacaoEmail::configurarRemetente(const std::string& email, const std::
     this->nomeRemetente = nome;
 }
 
+void NotificacaoEmail::configurarServidor(const std::string& servidor, int porta, bool usarTLS) {
+    this->servidor = servidor;
+    this->porta = porta;
+    this->usarTLS = usarTLS;
+}
+
+void NotificacaoEmail::configurarEndpointToken(const std::string& url) {
+    this->endpointToken = url;
+}
+
+void NotificacaoEmail::configurarServidorSemAutenticacao(const std::string& servidor, int porta) {
+    this->servidor = servidor;
+    this->porta = porta;
+    this->usarTLS = false;
+    this->usarOAuth2 = false;
+    this->configurado = true;
+}
+
 bool NotificacaoEmail::enviar(const std::string& mensagem, const std::string& destinatario) {
     if (!isDisponivel()) {
         std::cerr << "[EMAIL] ⚠ Email não configurado - usando modo simulação" << std::endl;
@@ -154,38 +181,44 @@ std::string NotificacaoEmail::getNomeCanal() const {
 }
 
 bool NotificacaoEmail::isDisponivel() const {
+    if (!usarOAuth2) {
+        return configurado;
+    }
     return configurado && !clientId.empty() && !clientSecret.empty() && !refreshToken.empty();
 }
 
 bool NotificacaoEmail::validarEmail(const std::string& email) const {
-    const std::regex pattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
+    static const std::regex pattern(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
     return std::regex_match(email, pattern);
 }
 
-bool NotificacaoEmail::tokenValido() const {
-    if (accessToken.empty()) return false;
-    
-    time_t agora = time(nullptr);
-    return agora < tokenExpiry;
+bool NotificacaoEmail::obterAccessToken(std::string& token) {
+    // Compartilhado por todas as instâncias com as mesmas credenciais
+    std::string chave = endpointToken + "|" + clientId + "|" + refreshToken;
+    return CacheTokensOAuth::getInstance().obter(chave,
+        [this](std::string& novoToken, long& validadeSegundos) {
+            return requisitarAccessToken(novoToken, validadeSegundos);
+        },
+        token);
 }
 
-bool NotificacaoEmail::obterAccessToken() {
-    if (tokenValido()) {
-        if (verbose) {
-            std::cout << "[EMAIL] ℹ Access token ainda válido" << std::endl;
-        }
-        return true;
-    }
-    
+size_t NotificacaoEmail::writeCallback(char *ptr, size_t size, size_t nmemb, void *userdata) {
+    std::string* str = static_cast<std::string*>(userdata);
+    str->append(ptr, size * nmemb);
+    return size * nmemb;
+}
+
+bool NotificacaoEmail::requisitarAccessToken(std::string& token, long& validadeSegundos) {
     if (verbose) {
         std::cout << "[EMAIL] ℹ Obtendo novo access token..." << std::endl;
     }
     
-    CURL *curl = curl_easy_init();
-    if (!curl) {
+    PoolConexoesCurl::Conexao conexao = PoolConexoesCurl::getInstance().adquirir(endpointToken);
+    if (!conexao) {
         std::cerr << "[EMAIL] ✗ Falha ao inicializar CURL" << std::endl;
         return false;
     }
+    CURL *curl = conexao.get();
     
     std::string responseData;
     std::string postFields = 
@@ -194,35 +227,39 @@ bool NotificacaoEmail::obterAccessToken() {
         "&refresh_token=" + refreshToken +
         "&grant_type=refresh_token";
     
-    curl_easy_setopt(curl, CURLOPT_URL, "https://oauth2.googleapis.com/token");
+    curl_easy_setopt(curl, CURLOPT_URL, endpointToken.c_str());
     curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postFields.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, 
-        +[](char *ptr, size_t size, size_t nmemb, void *userdata) -> size_t {
-            std::string* str = static_cast<std::string*>(userdata);
-            str->append(ptr, size * nmemb);
-            return size * nmemb;
-        });
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
     curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseData);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, timeout);
     
     if (verbose) {
         curl_easy_setopt(curl, CURLOPT_VERBOSE, 1L);
     }
     
     CURLcode res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
     
     if (res != CURLE_OK) {
         std::cerr << "[EMAIL] ✗ Erro ao obter access token: " << curl_easy_strerror(res) << std::endl;
+        conexao.descartar();
         return false;
     }
     
-    // Parse JSON simples (procura "access_token":"...")
+    // Parse JSON simples (procura "access_token":"..." e "expires_in":N)
     size_t pos = responseData.find("\"access_token\"");
     if (pos != std::string::npos) {
         size_t start = responseData.find("\"", pos + 15) + 1;
         size_t end = responseData.find("\"", start);
-        accessToken = responseData.substr(start, end - start);
-        tokenExpiry = time(nullptr) + 3300; // 55 minutos (tokens válidos por 1h)
+        token = responseData.substr(start, end - start);
+        
+        validadeSegundos = 3600; // Padrão do Google quando a resposta não informa
+        size_t posValidade = responseData.find("\"expires_in\"");
+        if (posValidade != std::string::npos) {
+            size_t inicioNumero = responseData.find_first_of("0123456789", posValidade + 12);
+            if (inicioNumero != std::string::npos) {
+                validadeSegundos = std::strtol(responseData.c_str() + inicioNumero, nullptr, 10);
+            }
+        }
         
         if (verbose) {
             std::cout << "[EMAIL] ✓ Access token obtido com sucesso" << std::endl;
@@ -326,21 +363,24 @@ size_t NotificacaoEmail::readCallback(char *ptr, size_t size, size_t nmemb, void
 
 bool NotificacaoEmail::enviarSMTP(const std::string& mensagem, const std::string& destinatario) {
     // Obtém access token
-    if (!obterAccessToken()) {
+    std::string accessToken;
+    if (usarOAuth2 && !obterAccessToken(accessToken)) {
         std::cerr << "[EMAIL] ✗ Não foi possível obter access token" << std::endl;
         return false;
     }
     
-    CURL *curl = curl_easy_init();
-    if (!curl) {
-        std::cerr << "[EMAIL] ✗ Falha ao inicializar CURL" << std::endl;
-        return false;
-    }
-    
     // Construir URL e mensagem
     std::string url = "smtp://" + servidor + ":" + std::to_string(porta);
     std::string emailData = construirMensagemEmail(mensagem, destinatario);
     
+    // Sessão SMTP já aberta (de qualquer instância) com o mesmo servidor e remetente
+    PoolConexoesCurl::Conexao conexao = PoolConexoesCurl::getInstance().adquirir(url + "|" + remetente);
+    if (!conexao) {
+        std::cerr << "[EMAIL] ✗ Falha ao inicializar CURL" << std::endl;
+        return false;
+    }
+    CURL *curl = conexao.get();
+    
     EmailPayload payload;
     payload.data = emailData.c_str();
     payload.bytesRead = 0;
@@ -348,11 +388,15 @@ bool NotificacaoEmail::enviarSMTP(const std::string& mensagem, const std::string
     
     // Configurar CURL
     curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+    if (usarTLS) {
+        curl_easy_setopt(curl, CURLOPT_USE_SSL, CURLUSESSL_ALL);
+    }
     
     // OAuth2 XOAUTH2
-    curl_easy_setopt(curl, CURLOPT_XOAUTH2_BEARER, accessToken.c_str());
-    curl_easy_setopt(curl, CURLOPT_USERNAME, remetente.c_str());
+    if (usarOAuth2) {
+        curl_easy_setopt(curl, CURLOPT_XOAUTH2_BEARER, accessToken.c_str());
+        curl_easy_setopt(curl, CURLOPT_USERNAME, remetente.c_str());
+    }
     
     // Remetente e destinatário
     curl_easy_setopt(curl, CURLOPT_MAIL_FROM, remetente.c_str());
@@ -380,12 +424,12 @@ bool NotificacaoEmail::enviarSMTP(const std::string& mensagem, const std::string
     std::cout << "[EMAIL] 📧 Enviando email para " << destinatario << "..." << std::endl;
     CURLcode res = curl_easy_perform(curl);
     
-    // Limpeza
+    // Limpeza (a conexão volta ao pool para o próximo envio)
     curl_slist_free_all(recipients);
-    curl_easy_cleanup(curl);
     
     if (res != CURLE_OK) {
         std::cerr << "[EMAIL] ✗ Erro ao enviar: " << curl_easy_strerror(res) << std::endl;
+        conexao.descartar();
         return false;
     }
     
@@ -14,6 +14,11 @@
  * - Refresh token automático
  * 
  * Configurações são carregadas do arquivo config/email_config.hpp
+ * 
+ * As conexões SMTP e HTTP vêm do PoolConexoesCurl e o access token do
+ * CacheTokensOAuth, ambos do processo: N emails, de quantas instâncias
+ * forem, custam um handshake e uma obtenção de token. Uma conexão com
+ * erro é descartada e refeita no envio seguinte.
  */
 class NotificacaoEmail : public NotificacaoStrategy {
 private:
@@ -28,13 +33,16 @@ private:
     std::string clientId;
     std::string clientSecret;
     std::string refreshToken;
-    std::string accessToken;
-    long tokenExpiry;
+    std::string endpointToken;
     
     // Configurações gerais
     bool verifySSL;
     bool verbose;
     long timeout;
+    
+    // false em servidores locais sem TLS nem autenticação (ver configurarServidorSemAutenticacao)
+    bool usarTLS;
+    bool usarOAuth2;
 
 public:
     NotificacaoEmail();
@@ -43,6 +51,9 @@ public:
                      const std::string& clientSecret, const std::string& refreshToken);
     ~NotificacaoEmail();
 
+    NotificacaoEmail(const NotificacaoEmail&) = delete;
+    NotificacaoEmail& operator=(const NotificacaoEmail&) = delete;
+
     bool enviar(const std::string& mensagem, const std::string& destinatario) override;
     std::string getNomeCanal() const override;
     bool isDisponivel() const override;
@@ -52,6 +63,23 @@ public:
                           const std::string& refreshToken);
     void configurarRemetente(const std::string& email, const std::string& nome);
     
+    /**
+     * @brief Servidor SMTP (mantém a autenticação OAuth2)
+     */
+    void configurarServidor(const std::string& servidor, int porta, bool usarTLS = true);
+    
+    /**
+     * @brief URL de obtenção do access token (padrão: endpoint do Google)
+     */
+    void configurarEndpointToken(const std::string& url);
+    
+    /**
+     * @brief Envia por um relay SMTP sem TLS e sem autenticação
+     * 
+     * Para relays internos e para testes contra um servidor SMTP local.
+     */
+    void configurarServidorSemAutenticacao(const std::string& servidor, int porta);
+    
     // Carrega configurações do arquivo config/email_config.hpp
     bool carregarConfiguracao();
 
@@ -60,16 +88,17 @@ private:
     bool enviarSMTP(const std::string& mensagem, const std::string& destinatario);
     
     // OAuth2 methods
-    bool obterAccessToken();
-    bool tokenValido() const;
+    bool obterAccessToken(std::string& token);
+    bool requisitarAccessToken(std::string& token, long& validadeSegundos);
     
     // SMTP helpers
     std::string construirMensagemEmail(const std::string& mensagem, 
                                         const std::string& destinatario) const;
     std::string base64Encode(const std::string& input) const;
     
-    // CURL callback
+    // CURL callbacks
     static size_t readCallback(char *ptr, size_t size, size_t nmemb, void *userp);
+    static size_t writeCallback(char *ptr, size_t size, size_t nmemb, void *userdata);
     
     // Estrutura para payload do email
     struct EmailPayload {
@@ -1,15 +1,41 @@
 #include "notificacao_windows_popup.hpp"
+#include <algorithm>
+#include <cerrno>
 #include <iostream>
 #include <cstdlib>
+#include <limits>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+NotificacaoWindowsPopup::NotificacaoWindowsPopup()
+    : NotificacaoWindowsPopup(Configuracao()) {}
+
+NotificacaoWindowsPopup::NotificacaoWindowsPopup(Configuracao configuracao)
+    : configuracao_(std::move(configuracao)),
+      notificadorNativo_(false),
+      fila_([this](std::vector<Pendente>& pendentes, uint64_t excedentes) {
+                exibirLote(pendentes, excedentes);
+            },
+            {configuracao_.capacidadeFila, PoliticaFilaCheia::DESCARTAR_NOVO,
+             std::numeric_limits<size_t>::max(),
+             std::max<size_t>(1, configuracao_.maxPopupsPorJanela), configuracao_.janela}) {
+#ifdef __linux__
+    notificadorNativo_ = localizarNoPath(configuracao_.comando);
+#endif
+}
 
 bool NotificacaoWindowsPopup::enviar(const std::string& mensagem, const std::string& destinatario) {
-    if (isWindows()) {
-        return enviarWindows(mensagem, destinatario);
-    } else if (isLinux()) {
-        return enviarLinux(mensagem, destinatario);
-    } else {
-        return enviarFallback(mensagem, destinatario);
-    }
+    // Fila cheia: o alerta só entra na contagem do próximo resumo
+    fila_.enfileirar({mensagem, destinatario});
+    return true;
 }
 
 std::string NotificacaoWindowsPopup::getNomeCanal() const {
@@ -20,82 +46,147 @@ bool NotificacaoWindowsPopup::isDisponivel() const {
     return true; // Sempre disponível (com fallback)
 }
 
-bool NotificacaoWindowsPopup::isWindows() const {
-#ifdef _WIN32
-    return true;
-#else
-    return false;
-#endif
+void NotificacaoWindowsPopup::aguardar() {
+    fila_.aguardar();
 }
 
-bool NotificacaoWindowsPopup::isLinux() const {
-#ifdef __linux__
-    return true;
+void NotificacaoWindowsPopup::exibirLote(std::vector<Pendente>& pendentes, uint64_t excedentes) {
+    // Destinatários distintos do lote, na ordem de chegada (os excedentes não têm registro)
+    const size_t MAX_DESTINATARIOS_LISTADOS = 10;
+    std::vector<std::string> destinatarios;
+    for (const auto& pendente : pendentes) {
+        if (std::find(destinatarios.begin(), destinatarios.end(), pendente.destinatario) ==
+            destinatarios.end()) {
+            destinatarios.push_back(pendente.destinatario);
+        }
+    }
+    std::string listaDestinatarios;
+    for (size_t i = 0; i < destinatarios.size() && i < MAX_DESTINATARIOS_LISTADOS; ++i) {
+        listaDestinatarios += (i > 0 ? ", " : "") + destinatarios[i];
+    }
+    if (destinatarios.size() > MAX_DESTINATARIOS_LISTADOS) {
+        listaDestinatarios += " e mais " + std::to_string(destinatarios.size() - MAX_DESTINATARIOS_LISTADOS);
+    }
+
+    size_t total = pendentes.size() + excedentes;
+    const Pendente& ultimo = pendentes.back();
+    std::string titulo = "⚠️ Alerta de Consumo";
+    std::string corpo = "Usuário: " + ultimo.destinatario + "\n" + ultimo.mensagem;
+    if (total > 1) {
+        std::ostringstream resumo;
+        resumo << total << " novos alertas de consumo para " << listaDestinatarios
+               << ". Último:\n" << corpo;
+        titulo = "⚠️ " + std::to_string(total) + " Alertas de Consumo";
+        corpo = resumo.str();
+    }
+
+    if (exibir(titulo, corpo, listaDestinatarios)) {
+        popupsExibidos_.fetch_add(1, std::memory_order_relaxed);
+        alertasExibidos_.fetch_add(total, std::memory_order_relaxed);
+    } else {
+        falhas_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool NotificacaoWindowsPopup::exibir(const std::string& titulo, const std::string& corpo,
+                                     const std::string& destinatario) {
+#ifdef _WIN32
+    return exibirWindows(titulo, corpo);
 #else
-    return false;
+    if (notificadorNativo_ && exibirLinux(titulo, corpo)) {
+        std::cout << "[NOTIFICAÇÃO] Popup enviado para " << destinatario << std::endl;
+        return true;
+    }
+    // Sem notificador, ou se falhou, usa fallback
+    return exibirFallback(corpo, destinatario);
 #endif
 }
 
-bool NotificacaoWindowsPopup::enviarWindows(const std::string& mensagem, const std::string& destinatario) {
+bool NotificacaoWindowsPopup::exibirWindows(const std::string& titulo, const std::string& corpo) {
 #ifdef _WIN32
     // Em Windows, usa MessageBox
-    std::string titulo = "Alerta de Consumo - Usuario: " + destinatario;
-    std::string comando = "msg * \"" + titulo + ": " + mensagem + "\"";
+    std::string comando = "msg * \"" + titulo + ": " + corpo + "\"";
     int resultado = system(comando.c_str());
     return resultado == 0;
 #else
+    (void)titulo;
+    (void)corpo;
     return false;
 #endif
 }
 
-bool NotificacaoWindowsPopup::enviarLinux(const std::string& mensagem, const std::string& destinatario) {
+bool NotificacaoWindowsPopup::exibirLinux(const std::string& titulo, const std::string& corpo) {
 #ifdef __linux__
-    if (!notifySendDisponivel()) {
-        return enviarFallback(mensagem, destinatario);
-    }
-    
-    // Usa notify-send para exibir notificação nativa do Linux
-    std::string titulo = "⚠️ Alerta de Consumo";
-    std::string corpo = "Usuário: " + destinatario + "\n" + mensagem;
-    
-    // Escapa aspas na mensagem
-    std::string corpoEscapado = corpo;
-    size_t pos = 0;
-    while ((pos = corpoEscapado.find("\"", pos)) != std::string::npos) {
-        corpoEscapado.replace(pos, 1, "'");
-        pos += 1;
+    // Argumentos passados direto ao processo: sem shell, sem escapar aspas
+    std::string tempo = std::to_string(configuracao_.tempoExibicao.count());
+    std::vector<char*> argumentos = {
+        const_cast<char*>(configuracao_.comando.c_str()),
+        const_cast<char*>("-u"), const_cast<char*>("critical"),
+        const_cast<char*>("-t"), const_cast<char*>(tempo.c_str()),
+        const_cast<char*>(titulo.c_str()), const_cast<char*>(corpo.c_str()),
+        nullptr
+    };
+
+    posix_spawn_file_actions_t acoes;
+    posix_spawn_file_actions_init(&acoes);
+    posix_spawn_file_actions_addopen(&acoes, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&acoes, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    pid_t pid;
+    int erro = posix_spawnp(&pid, configuracao_.comando.c_str(), &acoes, nullptr,
+                            argumentos.data(), environ);
+    posix_spawn_file_actions_destroy(&acoes);
+    if (erro != 0) {
+        return false;
     }
-    
-    // Comando notify-send com urgência crítica e tempo de exibição de 10 segundos
-    std::string comando = "notify-send -u critical -t 10000 \"" + titulo + "\" \"" + corpoEscapado + "\"";
-    int resultado = system(comando.c_str());
-    
-    if (resultado == 0) {
-        std::cout << "[NOTIFICAÇÃO] Popup enviado para " << destinatario << std::endl;
-        return true;
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
     }
-    
-    // Se falhou, usa fallback
-    return enviarFallback(mensagem, destinatario);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
 #else
+    (void)titulo;
+    (void)corpo;
     return false;
 #endif
 }
 
-bool NotificacaoWindowsPopup::notifySendDisponivel() const {
-    // Verifica se notify-send está disponível no sistema
-    int resultado = system("which notify-send > /dev/null 2>&1");
-    return resultado == 0;
+bool NotificacaoWindowsPopup::localizarNoPath(const std::string& comando) {
+#ifdef _WIN32
+    (void)comando;
+    return false;
+#else
+    if (comando.find('/') != std::string::npos) {
+        return access(comando.c_str(), X_OK) == 0;
+    }
+    const char* path = std::getenv("PATH");
+    if (!path) {
+        return false;
+    }
+
+    std::istringstream diretorios(path);
+    std::string diretorio;
+    while (std::getline(diretorios, diretorio, ':')) {
+        std::string caminho = (diretorio.empty() ? "." : diretorio) + "/" + comando;
+        if (access(caminho.c_str(), X_OK) == 0) {
+            return true;
+        }
+    }
+    return false;
+#endif
 }
 
-bool NotificacaoWindowsPopup::enviarFallback(const std::string& mensagem, const std::string& destinatario) {
-    // Em sistemas não-Windows, exibe no console de forma destacada
+bool NotificacaoWindowsPopup::exibirFallback(const std::string& corpo, const std::string& destinatario) {
+    // Sem popup nativo, exibe no console de forma destacada
     std::cout << "\n"
               << "┌─────────────────────────────────────────────────────────────┐\n"
               << "│                   💬 POPUP SIMULADO                         │\n"
               << "├─────────────────────────────────────────────────────────────┤\n"
               << "│ Para: " << destinatario << "\n"
-              << "│ Mensagem: " << mensagem << "\n"
+              << "│ Mensagem: " << corpo << "\n"
               << "└─────────────────────────────────────────────────────────────┘\n"
               << std::endl;
     return true;
@@ -2,26 +2,91 @@
 #define NOTIFICACAO_WINDOWS_POPUP_HPP
 
 #include "notificacao_strategy.hpp"
+#include "../../utils/fila_trabalho.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
 
 /**
  * @brief Estratégia que exibe notificações como popup do Windows
- * 
+ *
  * Em ambientes Windows, usa a API nativa para exibir notificações.
- * Em outros sistemas, faz fallback para console com mensagem especial.
+ * No Linux, usa o notify-send; sem ele, ou em outros sistemas, faz
+ * fallback para console com mensagem especial.
+ *
+ * enviar() apenas enfileira o popup; a thread de uma FilaTrabalho o
+ * exibe, então a avaliação das regras não espera pelo processo do
+ * notificador. No Linux
+ * o notify-send é executado com posix_spawnp, sem shell, e sua presença
+ * no PATH é verificada uma única vez, na construção.
+ *
+ * São exibidos no máximo `maxPopupsPorJanela` popups por `janela`; os
+ * alertas que chegam enquanto o limite está esgotado viram um único
+ * popup de resumo, que lista os destinatários distintos e detalha o
+ * último alerta. O destrutor exibe o que estiver pendente.
  */
 class NotificacaoWindowsPopup : public NotificacaoStrategy {
 public:
+    struct Configuracao {
+        std::string comando = "notify-send";
+        size_t maxPopupsPorJanela = 3;
+        std::chrono::milliseconds janela{1000};
+        size_t capacidadeFila = 256;  // além disso, só a contagem entra no resumo
+        std::chrono::milliseconds tempoExibicao{10000};
+    };
+
+    NotificacaoWindowsPopup();
+    explicit NotificacaoWindowsPopup(Configuracao configuracao);
+
+    NotificacaoWindowsPopup(const NotificacaoWindowsPopup&) = delete;
+    NotificacaoWindowsPopup& operator=(const NotificacaoWindowsPopup&) = delete;
+
+    /**
+     * @brief Enfileira o popup (não bloqueia)
+     */
     bool enviar(const std::string& mensagem, const std::string& destinatario) override;
     std::string getNomeCanal() const override;
     bool isDisponivel() const override;
 
+    /**
+     * @brief Bloqueia até a fila esvaziar e o popup em andamento terminar
+     */
+    void aguardar();
+
+    /**
+     * @brief true se o notificador nativo foi encontrado na construção
+     */
+    bool isNotificadorNativo() const { return notificadorNativo_; }
+
+    uint64_t getPopupsExibidos() const { return popupsExibidos_.load(std::memory_order_relaxed); }
+    // Inclui os agrupados em resumos
+    uint64_t getAlertasExibidos() const { return alertasExibidos_.load(std::memory_order_relaxed); }
+    uint64_t getFalhas() const { return falhas_.load(std::memory_order_relaxed); }
+
 private:
-    bool isWindows() const;
-    bool isLinux() const;
-    bool enviarWindows(const std::string& mensagem, const std::string& destinatario);
-    bool enviarLinux(const std::string& mensagem, const std::string& destinatario);
-    bool enviarFallback(const std::string& mensagem, const std::string& destinatario);
-    bool notifySendDisponivel() const;
+    struct Pendente {
+        std::string mensagem;
+        std::string destinatario;
+    };
+
+    void exibirLote(std::vector<Pendente>& pendentes, uint64_t excedentes);
+    bool exibir(const std::string& titulo, const std::string& corpo, const std::string& destinatario);
+    bool exibirWindows(const std::string& titulo, const std::string& corpo);
+    bool exibirLinux(const std::string& titulo, const std::string& corpo);
+    bool exibirFallback(const std::string& corpo, const std::string& destinatario);
+    static bool localizarNoPath(const std::string& comando);
+
+    Configuracao configuracao_;
+    bool notificadorNativo_;
+
+    std::atomic<uint64_t> popupsExibidos_{0};
+    std::atomic<uint64_t> alertasExibidos_{0};
+    std::atomic<uint64_t> falhas_{0};
+
+    // Cada lote (tudo o que estiver pendente) vira um popup
+    FilaTrabalho<Pendente> fila_;
 };
 
 #endif // NOTIFICACAO_WINDOWS_POPUP_HPP
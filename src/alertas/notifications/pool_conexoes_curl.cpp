@@ -0,0 +1,134 @@
+#include "pool_conexoes_curl.hpp"
+#include <utility>
+
+// ==================== Conexao ====================
+
+PoolConexoesCurl::Conexao::Conexao(PoolConexoesCurl* pool, std::string chave, CURL* handle)
+    : pool_(pool), chave_(std::move(chave)), handle_(handle) {}
+
+PoolConexoesCurl::Conexao::~Conexao() {
+    liberar(true);
+}
+
+PoolConexoesCurl::Conexao::Conexao(Conexao&& outra) noexcept
+    : pool_(outra.pool_), chave_(std::move(outra.chave_)), handle_(outra.handle_) {
+    outra.handle_ = nullptr;
+}
+
+PoolConexoesCurl::Conexao& PoolConexoesCurl::Conexao::operator=(Conexao&& outra) noexcept {
+    if (this != &outra) {
+        liberar(true);
+        pool_ = outra.pool_;
+        chave_ = std::move(outra.chave_);
+        handle_ = outra.handle_;
+        outra.handle_ = nullptr;
+    }
+    return *this;
+}
+
+void PoolConexoesCurl::Conexao::descartar() {
+    liberar(false);
+}
+
+void PoolConexoesCurl::Conexao::liberar(bool saudavel) {
+    if (handle_) {
+        pool_->devolver(chave_, handle_, saudavel);
+        handle_ = nullptr;
+    }
+}
+
+// ==================== PoolConexoesCurl ====================
+
+PoolConexoesCurl& PoolConexoesCurl::getInstance() {
+    // Nunca destruído: threads de notificação podem enviar durante o encerramento
+    static PoolConexoesCurl* instancia = new PoolConexoesCurl();
+    return *instancia;
+}
+
+PoolConexoesCurl::PoolConexoesCurl() {
+    // curl_easy_init faria a inicialização global sob demanda, sem proteção entre threads
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+}
+
+PoolConexoesCurl::Conexao PoolConexoesCurl::adquirir(const std::string& chave) {
+    std::vector<CURL*> expirados;
+    CURL* handle = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = ociosos_.find(chave);
+        if (it != ociosos_.end()) {
+            auto limite = std::chrono::steady_clock::now() - tempoMaximoOcioso_;
+            auto& lista = it->second;
+            while (!lista.empty() && !handle) {
+                Ocioso ocioso = lista.back();
+                lista.pop_back();
+                if (ocioso.desde < limite) {
+                    expirados.push_back(ocioso.handle);
+                } else {
+                    handle = ocioso.handle;
+                    ++handlesReutilizados_;
+                }
+            }
+        }
+        if (!handle) {
+            ++handlesCriados_;
+        }
+    }
+
+    // Fechar pode enviar QUIT ao servidor: fora do lock
+    for (CURL* expirado : expirados) {
+        curl_easy_cleanup(expirado);
+    }
+
+    if (handle) {
+        curl_easy_reset(handle);
+    } else {
+        handle = curl_easy_init();
+    }
+    return Conexao(this, chave, handle);
+}
+
+void PoolConexoesCurl::devolver(const std::string& chave, CURL* handle, bool saudavel) {
+    if (saudavel) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& lista = ociosos_[chave];
+        if (lista.size() < maxOciosasPorChave_) {
+            lista.push_back({handle, std::chrono::steady_clock::now()});
+            return;
+        }
+    }
+    curl_easy_cleanup(handle);
+}
+
+void PoolConexoesCurl::setMaxOciosasPorChave(size_t maximo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxOciosasPorChave_ = maximo;
+}
+
+void PoolConexoesCurl::setTempoMaximoOcioso(std::chrono::seconds tempo) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tempoMaximoOcioso_ = tempo;
+}
+
+void PoolConexoesCurl::limpar() {
+    std::map<std::string, std::vector<Ocioso>> fechar;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fechar.swap(ociosos_);
+    }
+    for (auto& entrada : fechar) {
+        for (auto& ocioso : entrada.second) {
+            curl_easy_cleanup(ocioso.handle);
+        }
+    }
+}
+
+uint64_t PoolConexoesCurl::getHandlesCriados() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handlesCriados_;
+}
+
+uint64_t PoolConexoesCurl::getHandlesReutilizados() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return handlesReutilizados_;
+}
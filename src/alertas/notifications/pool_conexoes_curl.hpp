@@ -0,0 +1,91 @@
+#ifndef POOL_CONEXOES_CURL_HPP
+#define POOL_CONEXOES_CURL_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <curl/curl.h>
+
+/**
+ * @brief Pool de handles curl compartilhado pelo processo (keep-alive)
+ *
+ * Um handle curl guarda as conexões que abriu; devolvê-lo ao pool em vez
+ * de destruí-lo mantém a conexão (TCP, TLS e sessão SMTP/HTTP) aberta para
+ * o próximo envio ao mesmo destino, de qualquer instância e qualquer
+ * thread. A chave identifica o destino (ex: "smtp://host:587|remetente").
+ *
+ * Cada handle é usado por uma thread de cada vez: adquirir() entrega um
+ * handle ocioso da chave (após curl_easy_reset, que preserva a conexão) ou
+ * cria outro. Handles ociosos há mais de `tempoMaximoOcioso` são fechados
+ * na próxima aquisição, e no máximo `maxOciosasPorChave` ficam guardados.
+ */
+class PoolConexoesCurl {
+public:
+    /**
+     * @brief Handle emprestado do pool; devolvido ao sair de escopo
+     */
+    class Conexao {
+    public:
+        Conexao(PoolConexoesCurl* pool, std::string chave, CURL* handle);
+        ~Conexao();
+        Conexao(Conexao&& outra) noexcept;
+        Conexao& operator=(Conexao&& outra) noexcept;
+        Conexao(const Conexao&) = delete;
+        Conexao& operator=(const Conexao&) = delete;
+
+        CURL* get() const { return handle_; }
+        explicit operator bool() const { return handle_ != nullptr; }
+
+        /**
+         * @brief Fecha o handle em vez de devolvê-lo (ex: após erro de transferência)
+         */
+        void descartar();
+
+    private:
+        void liberar(bool saudavel);
+
+        PoolConexoesCurl* pool_;
+        std::string chave_;
+        CURL* handle_;
+    };
+
+    static PoolConexoesCurl& getInstance();
+
+    /**
+     * @brief Empresta um handle para `chave` (vazio se curl_easy_init falhar)
+     */
+    Conexao adquirir(const std::string& chave);
+
+    void setMaxOciosasPorChave(size_t maximo);
+    void setTempoMaximoOcioso(std::chrono::seconds tempo);
+
+    /**
+     * @brief Fecha todos os handles ociosos
+     */
+    void limpar();
+
+    uint64_t getHandlesCriados() const;
+    uint64_t getHandlesReutilizados() const;
+
+private:
+    PoolConexoesCurl();
+
+    struct Ocioso {
+        CURL* handle;
+        std::chrono::steady_clock::time_point desde;
+    };
+
+    void devolver(const std::string& chave, CURL* handle, bool saudavel);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::vector<Ocioso>> ociosos_;
+    size_t maxOciosasPorChave_ = 4;
+    std::chrono::seconds tempoMaximoOcioso_{120};
+    uint64_t handlesCriados_ = 0;
+    uint64_t handlesReutilizados_ = 0;
+};
+
+#endif // POOL_CONEXOES_CURL_HPP
@@ -0,0 +1,55 @@
+#include "observer_assincrono.hpp"
+#include "../../utils/metricas.hpp"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+ObserverAssincrono::ObserverAssincrono(std::shared_ptr<AlertObserver> observer)
+    : ObserverAssincrono(std::move(observer), Configuracao()) {}
+
+ObserverAssincrono::ObserverAssincrono(std::shared_ptr<AlertObserver> observer,
+                                       Configuracao configuracao)
+    : observer_(std::move(observer)),
+      configuracao_(configuracao),
+      fila_([this](AlertaAtivo& alerta) { entregar(alerta); },
+            {configuracao.capacidadeFila, configuracao.politica}) {
+    if (!observer_) {
+        throw std::invalid_argument("ObserverAssincrono: observer não pode ser nulo");
+    }
+    configuracao_.maxTentativas = std::max(1, configuracao_.maxTentativas);
+}
+
+void ObserverAssincrono::atualizar(const AlertaAtivo& alerta) {
+    static ContadorMetrica& descartadas =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_notificacoes_descartadas_total");
+
+    if (!fila_.enfileirar(alerta)) {
+        descartadas.incrementar();
+    }
+}
+
+std::string ObserverAssincrono::getNome() const {
+    return observer_->getNome() + " (assíncrono)";
+}
+
+void ObserverAssincrono::aguardar() {
+    fila_.aguardar();
+}
+
+void ObserverAssincrono::entregar(const AlertaAtivo& alerta) {
+    for (int tentativa = 1; ; ++tentativa) {
+        try {
+            observer_->atualizar(alerta);
+            entregues_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } catch (const std::exception& e) {
+            if (tentativa >= configuracao_.maxTentativas) {
+                falhas_.fetch_add(1, std::memory_order_relaxed);
+                std::cerr << "[ALERTA_SERVICE] Erro ao notificar " << observer_->getNome()
+                          << " após " << tentativa << " tentativas: " << e.what() << std::endl;
+                return;
+            }
+        }
+        std::this_thread::sleep_for(configuracao_.esperaEntreTentativas);
+    }
+}
@@ -0,0 +1,68 @@
+#ifndef OBSERVER_ASSINCRONO_HPP
+#define OBSERVER_ASSINCRONO_HPP
+
+#include "alert_observer.hpp"
+#include "../../utils/fila_trabalho.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Decorator que entrega alertas a outro observer numa thread própria
+ * 
+ * atualizar() apenas copia o alerta para uma fila limitada e retorna; uma
+ * thread dedicada chama o observer decorado. Assim um observer lento
+ * (ex: email com timeout de 30s) não segura a avaliação das regras nem os
+ * demais observers.
+ * 
+ * Uma entrega que lança exceção é repetida até `maxTentativas` vezes, com
+ * espera entre as tentativas; depois disso o alerta é contado como falha.
+ * O destrutor entrega o que ainda estiver na fila antes de encerrar.
+ * A fila e a thread são uma FilaTrabalho.
+ */
+class ObserverAssincrono : public AlertObserver {
+public:
+    struct Configuracao {
+        size_t capacidadeFila = 256;
+        PoliticaFilaCheia politica = PoliticaFilaCheia::DESCARTAR_MAIS_ANTIGO;
+        int maxTentativas = 3;
+        std::chrono::milliseconds esperaEntreTentativas{200};
+    };
+
+    explicit ObserverAssincrono(std::shared_ptr<AlertObserver> observer);
+    ObserverAssincrono(std::shared_ptr<AlertObserver> observer, Configuracao configuracao);
+
+    ObserverAssincrono(const ObserverAssincrono&) = delete;
+    ObserverAssincrono& operator=(const ObserverAssincrono&) = delete;
+
+    /**
+     * @brief Enfileira o alerta (não bloqueia)
+     */
+    void atualizar(const AlertaAtivo& alerta) override;
+    std::string getNome() const override;
+
+    /**
+     * @brief Bloqueia até a fila esvaziar e a entrega em andamento terminar
+     */
+    void aguardar();
+
+    const std::shared_ptr<AlertObserver>& getObserver() const { return observer_; }
+
+    uint64_t getEntregues() const { return entregues_.load(std::memory_order_relaxed); }
+    uint64_t getDescartados() const { return fila_.getDescartados(); }
+    uint64_t getFalhas() const { return falhas_.load(std::memory_order_relaxed); }
+
+private:
+    void entregar(const AlertaAtivo& alerta);
+
+    std::shared_ptr<AlertObserver> observer_;
+    Configuracao configuracao_;
+
+    std::atomic<uint64_t> entregues_{0};
+    std::atomic<uint64_t> falhas_{0};
+
+    FilaTrabalho<AlertaAtivo> fila_;
+};
+
+#endif // OBSERVER_ASSINCRONO_HPP
@@ -1,41 +1,124 @@
 #include "painel_observer.hpp"
+#include <algorithm>
 #include <iostream>
+#include <thread>
 
-PainelObserver::PainelObserver(size_t maxAlertas) 
-    : maxAlertasArmazenados(maxAlertas) {}
+PainelObserver::PainelObserver(size_t maxAlertas)
+    : buffer(maxAlertas) {}
 
 void PainelObserver::atualizar(const AlertaAtivo& alerta) {
-    // Adiciona o alerta à lista
-    alertasRecentes.push_back(alerta);
+    // Log para debug
+    std::cout << "[PAINEL] Novo alerta recebido: " << alerta.getMensagem() << std::endl;
 
-    // Remove alertas antigos se exceder o limite
-    if (alertasRecentes.size() > maxAlertasArmazenados) {
-        alertasRecentes.erase(alertasRecentes.begin());
+    if (buffer.empty()) {
+        return;
     }
 
-    // Log para debug
-    std::cout << "[PAINEL] Novo alerta recebido: " << alerta.getMensagem() << std::endl;
+    // Alocação e destruição do alerta sobrescrito ficam fora da seção de escrita
+    AlertaCompartilhado novo = std::make_shared<const AlertaAtivo>(alerta);
+    AlertaCompartilhado sobrescrito;
+
+    std::lock_guard<std::mutex> lock(mutexEscrita);
+    uint64_t seq = sequencia.load(std::memory_order_relaxed);
+    sequencia.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t posicao = fim.load(std::memory_order_relaxed);
+    sobrescrito = std::atomic_exchange_explicit(&buffer[posicao % buffer.size()], std::move(novo),
+                                                std::memory_order_relaxed);
+    fim.store(posicao + 1, std::memory_order_relaxed);
+
+    sequencia.store(seq + 2, std::memory_order_release);
 }
 
 std::string PainelObserver::getNome() const {
     return "PainelObserver";
 }
 
+void PainelObserver::lerConsistente(std::vector<AlertaCompartilhado>& destino,
+                                    bool somenteUltimo) const {
+    for (;;) {
+        uint64_t seq = sequencia.load(std::memory_order_acquire);
+        if (seq & 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        destino.clear();
+        uint64_t ultimo = fim.load(std::memory_order_relaxed);
+        uint64_t primeiro = std::max(inicio.load(std::memory_order_relaxed),
+                                     ultimo - std::min<uint64_t>(ultimo, buffer.size()));
+        if (somenteUltimo && ultimo > primeiro) {
+            primeiro = ultimo - 1;
+        }
+        for (uint64_t i = primeiro; i < ultimo; ++i) {
+            destino.push_back(std::atomic_load_explicit(&buffer[i % buffer.size()],
+                                                        std::memory_order_relaxed));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequencia.load(std::memory_order_relaxed) == seq) {
+            return;
+        }
+    }
+}
+
+std::vector<PainelObserver::AlertaCompartilhado> PainelObserver::getSnapshot() const {
+    std::vector<AlertaCompartilhado> snapshot;
+    snapshot.reserve(buffer.size());
+    lerConsistente(snapshot, false);
+    return snapshot;
+}
+
 std::vector<AlertaAtivo> PainelObserver::getAlertasRecentes() const {
-    return alertasRecentes;
+    std::vector<AlertaAtivo> alertas;
+    for (const auto& alerta : getSnapshot()) {
+        alertas.push_back(*alerta);
+    }
+    return alertas;
 }
 
 size_t PainelObserver::getQuantidadeAlertas() const {
-    return alertasRecentes.size();
+    for (;;) {
+        uint64_t seq = sequencia.load(std::memory_order_acquire);
+        uint64_t ultimo = fim.load(std::memory_order_relaxed);
+        uint64_t primeiro = inicio.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(seq & 1) && sequencia.load(std::memory_order_relaxed) == seq) {
+            return static_cast<size_t>(std::min<uint64_t>(ultimo - primeiro, buffer.size()));
+        }
+        std::this_thread::yield();
+    }
+}
+
+uint64_t PainelObserver::getVersao() const {
+    return sequencia.load(std::memory_order_acquire) / 2;
 }
 
 void PainelObserver::limparAlertas() {
-    alertasRecentes.clear();
+    std::vector<AlertaCompartilhado> removidos;
+    removidos.reserve(buffer.size());
+
+    std::lock_guard<std::mutex> lock(mutexEscrita);
+    uint64_t seq = sequencia.load(std::memory_order_relaxed);
+    sequencia.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (auto& posicao : buffer) {
+        removidos.push_back(std::atomic_exchange_explicit(&posicao, AlertaCompartilhado(),
+                                                          std::memory_order_relaxed));
+    }
+    inicio.store(fim.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    sequencia.store(seq + 2, std::memory_order_release);
 }
 
 AlertaAtivo PainelObserver::getUltimoAlerta() const {
-    if (alertasRecentes.empty()) {
+    std::vector<AlertaCompartilhado> ultimo;
+    ultimo.reserve(1);
+    lerConsistente(ultimo, true);
+    if (ultimo.empty()) {
         return AlertaAtivo();
     }
-    return alertasRecentes.back();
+    return *ultimo.front();
 }
@@ -2,21 +2,35 @@
 #define PAINEL_OBSERVER_HPP
 
 #include "alert_observer.hpp"
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 /**
  * @brief Observer que atualiza o painel/interface com novos alertas
- * 
- * Este observer mantém uma lista de alertas ativos que podem ser
- * consultados pela interface gráfica do sistema.
+ *
+ * Este observer mantém os últimos alertas recebidos para consulta pela
+ * interface gráfica do sistema.
+ *
+ * Os alertas ficam num buffer circular de capacidade fixa: atualizar() é
+ * O(1) e sobrescreve o mais antigo quando cheio. A leitura é um seqlock:
+ * o leitor copia os ponteiros e repete se uma escrita aconteceu no meio;
+ * o escritor nunca espera um snapshot inteiro. Os alertas são imutáveis e
+ * compartilhados, então um snapshot não copia mensagens.
+ *
+ * Cada posição é copiada com std::atomic_load/atomic_exchange sobre
+ * shared_ptr, que não é lock-free: a libstdc++ protege cada cópia com um
+ * mutex de um pool global, indexado pelo endereço. Leitor e escritor
+ * podem, portanto, esperar um pelo outro (ou por outro shared_ptr
+ * atômico do processo que caia no mesmo mutex), mas só pelo tempo de
+ * copiar um ponteiro e ajustar a contagem de referências.
  */
 class PainelObserver : public AlertObserver {
-private:
-    std::vector<AlertaAtivo> alertasRecentes;
-    size_t maxAlertasArmazenados;
-
 public:
+    using AlertaCompartilhado = std::shared_ptr<const AlertaAtivo>;
+
     PainelObserver(size_t maxAlertas = 100);
 
     void atualizar(const AlertaAtivo& alerta) override;
@@ -27,6 +41,29 @@ public:
     size_t getQuantidadeAlertas() const;
     void limparAlertas();
     AlertaAtivo getUltimoAlerta() const;
+
+    /**
+     * @brief Alertas recentes, do mais antigo ao mais novo, sem copiá-los
+     */
+    std::vector<AlertaCompartilhado> getSnapshot() const;
+
+    /**
+     * @brief Muda a cada alerta recebido ou limpeza; o painel pode pular
+     * o snapshot enquanto a versão for a mesma da última consulta
+     */
+    uint64_t getVersao() const;
+
+private:
+    /**
+     * @brief Lê [inicio, fim) do buffer de forma consistente
+     */
+    void lerConsistente(std::vector<AlertaCompartilhado>& destino, bool somenteUltimo) const;
+
+    std::vector<AlertaCompartilhado> buffer;  // capacidade fixa
+    std::atomic<uint64_t> sequencia{0};       // ímpar: escrita em andamento
+    std::atomic<uint64_t> fim{0};             // total de alertas já escritos
+    std::atomic<uint64_t> inicio{0};          // posição da última limpeza
+    std::mutex mutexEscrita;                  // só entre escritores
 };
 
 #endif // PAINEL_OBSERVER_HPP
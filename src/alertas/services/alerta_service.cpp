@@ -3,10 +3,21 @@
 #include "../strategies/media_movel_strategy.hpp"
 #include "../strategies/deteccao_vazamento_strategy.hpp"
 #include "../notifications/notificacao_console_log.hpp"
+#include "../../utils/metricas.hpp"
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 #include <ctime>
+#include <typeinfo>
+
+namespace {
+
+const char* const TIPO_LIMITE_DIARIO = "LIMITE_DIARIO";
+
+} // namespace
 
 AlertaService::AlertaService() 
     : proximoIdRegra(1), proximoIdAlerta(1) {
@@ -20,21 +31,46 @@ AlertaService::AlertaService()
 // ==================== Padrão Observer ====================
 
 void AlertaService::anexarObserver(std::shared_ptr<AlertObserver> observer) {
+    std::lock_guard<std::mutex> lock(mutexObservers);
     observers.push_back(observer);
+    if (notificacaoAssincrona) {
+        despachantes.push_back(std::make_shared<ObserverAssincrono>(observer, configuracaoAssincrona));
+    }
     std::cout << "[ALERTA_SERVICE] Observer anexado: " << observer->getNome() << std::endl;
 }
 
 void AlertaService::desanexarObserver(std::shared_ptr<AlertObserver> observer) {
-    auto it = std::remove(observers.begin(), observers.end(), observer);
-    if (it != observers.end()) {
-        observers.erase(it, observers.end());
+    std::lock_guard<std::mutex> lock(mutexObservers);
+    bool removido = false;
+    for (size_t i = observers.size(); i-- > 0; ) {
+        if (observers[i] != observer) {
+            continue;
+        }
+        // O despachante removido entrega sua fila ao ser destruído
+        if (notificacaoAssincrona) {
+            despachantes.erase(despachantes.begin() + i);
+        }
+        observers.erase(observers.begin() + i);
+        removido = true;
+    }
+    
+    if (removido) {
         std::cout << "[ALERTA_SERVICE] Observer removido: " << observer->getNome() << std::endl;
     }
 }
 
 void AlertaService::notificarObservers(const AlertaAtivo& alerta) {
+    // Observers síncronos recebem um alerta por vez, como numa única thread
+    std::lock_guard<std::mutex> lock(mutexObservers);
     std::cout << "[ALERTA_SERVICE] Notificando " << observers.size() << " observers..." << std::endl;
     
+    if (notificacaoAssincrona) {
+        for (auto& despachante : despachantes) {
+            despachante->atualizar(alerta);
+        }
+        return;
+    }
+    
     for (auto& observer : observers) {
         try {
             observer->atualizar(alerta);
@@ -45,46 +81,131 @@ void AlertaService::notificarObservers(const AlertaAtivo& alerta) {
     }
 }
 
+void AlertaService::definirNotificacaoAssincrona(bool ativa,
+                                                 ObserverAssincrono::Configuracao configuracao) {
+    std::lock_guard<std::mutex> lock(mutexObservers);
+    
+    // Destruir os despachantes entrega o que estiver nas filas
+    despachantes.clear();
+    notificacaoAssincrona = ativa;
+    configuracaoAssincrona = configuracao;
+    
+    if (ativa) {
+        for (const auto& observer : observers) {
+            despachantes.push_back(std::make_shared<ObserverAssincrono>(observer, configuracao));
+        }
+    }
+}
+
+void AlertaService::aguardarNotificacoes() {
+    // Espera fora do lock: as filas continuam recebendo alertas enquanto isso
+    std::vector<std::shared_ptr<ObserverAssincrono>> aguardados;
+    {
+        std::lock_guard<std::mutex> lock(mutexObservers);
+        aguardados = despachantes;
+    }
+    for (auto& despachante : aguardados) {
+        despachante->aguardar();
+    }
+}
+
+uint64_t AlertaService::getNotificacoesDescartadas() const {
+    std::lock_guard<std::mutex> lock(mutexObservers);
+    uint64_t total = 0;
+    for (const auto& despachante : despachantes) {
+        total += despachante->getDescartados();
+    }
+    return total;
+}
+
 // ==================== Gerenciamento de Regras ====================
 
 int AlertaService::salvarRegra(int usuarioId, const std::string& tipoEstrategia, 
                                 const std::string& valorParametro) {
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
+    
     // Valida se a estratégia existe
-    if (estrategiasAnalise.find(tipoEstrategia) == estrategiasAnalise.end()) {
+    auto itEstrategia = estrategiasAnalise.find(tipoEstrategia);
+    if (itEstrategia == estrategiasAnalise.end()) {
         std::cerr << "[ALERTA_SERVICE] Erro: Estratégia desconhecida: " 
                   << tipoEstrategia << std::endl;
         return -1;
     }
 
+    // Valida e converte o parâmetro uma única vez
+    ParametrosRegra parametros;
+    try {
+        parametros = itEstrategia->second->compilarParametros(valorParametro);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "[ALERTA_SERVICE] Erro: Parâmetro inválido para " 
+                  << tipoEstrategia << ": " << e.what() << std::endl;
+        return -1;
+    }
+
     RegraAlerta regra(proximoIdRegra++, usuarioId, tipoEstrategia, valorParametro);
+    regra.setParametros(parametros);
+    size_t posicao = regrasAlerta.size();
     regrasAlerta.push_back(regra);
+    indiceRegrasPorUsuario[usuarioId].push_back(posicao);
+    indiceRegrasPorId[regra.getId()] = posicao;
+    if (limiteDiarioVetorizado && tipoEstrategia == TIPO_LIMITE_DIARIO) {
+        limitesVetorizados.adicionar(usuarioId, posicao, parametros.limiteLitros);
+    } else if (limiteDiarioVetorizado) {
+        limitesVetorizados.marcarOutrasRegras(usuarioId);
+    }
+    {
+        std::lock_guard<std::mutex> lockAlertas(mutexAlertas);
+        if (persistencia) {
+            persistencia->salvarRegra(regra);
+            confirmarPersistencia();
+        }
+    }
 
     std::cout << "[ALERTA_SERVICE] Regra criada: " << regra.toString() << std::endl;
+    if (!itEstrategia->second->avaliaConsumoAgregado()) {
+        std::cout << "[ALERTA_SERVICE] Regra " << regra.getId() << " (" << tipoEstrategia
+                  << ") é avaliada só pelas leituras dos hidrômetros vinculados" << std::endl;
+    }
     return regra.getId();
 }
 
 bool AlertaService::desativarRegra(int regraId) {
-    for (auto& regra : regrasAlerta) {
-        if (regra.getId() == regraId) {
-            regra.setAtivo(false);
-            std::cout << "[ALERTA_SERVICE] Regra " << regraId << " desativada" << std::endl;
-            return true;
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
+    auto it = indiceRegrasPorId.find(regraId);
+    if (it == indiceRegrasPorId.end()) {
+        return false;
+    }
+
+    regrasAlerta[it->second].setAtivo(false);
+    limitesVetorizados.desativar(it->second);
+    {
+        std::lock_guard<std::mutex> lockAlertas(mutexAlertas);
+        if (persistencia) {
+            persistencia->salvarRegra(regrasAlerta[it->second]);
+            confirmarPersistencia();
         }
     }
-    return false;
+    std::cout << "[ALERTA_SERVICE] Regra " << regraId << " desativada" << std::endl;
+    return true;
 }
 
 std::vector<RegraAlerta> AlertaService::buscarRegrasPorUsuario(int usuarioId) const {
+    std::shared_lock<std::shared_mutex> lock(mutexRegras);
     std::vector<RegraAlerta> resultado;
-    for (const auto& regra : regrasAlerta) {
-        if (regra.getUsuarioId() == usuarioId) {
-            resultado.push_back(regra);
-        }
+    auto it = indiceRegrasPorUsuario.find(usuarioId);
+    if (it == indiceRegrasPorUsuario.end()) {
+        return resultado;
+    }
+
+    resultado.reserve(it->second.size());
+    for (size_t posicao : it->second) {
+        resultado.push_back(regrasAlerta[posicao]);
     }
     return resultado;
 }
 
 std::vector<RegraAlerta> AlertaService::buscarRegrasAtivas() const {
+    std::shared_lock<std::shared_mutex> lock(mutexRegras);
     std::vector<RegraAlerta> resultado;
     for (const auto& regra : regrasAlerta) {
         if (regra.isAtivo()) {
@@ -97,114 +218,533 @@ std::vector<RegraAlerta> AlertaService::buscarRegrasAtivas() const {
 // ==================== Verificação de Alertas ====================
 
 bool AlertaService::verificarRegras(int usuarioId, double consumoAtual) {
-    std::vector<RegraAlerta> regrasUsuario = buscarRegrasPorUsuario(usuarioId);
-    bool violacaoDetectada = false;
+    SSMH_MEDIR_LATENCIA("ssmh_alertas_verificacao_latencia_segundos", "");
+
+    std::lock_guard<std::mutex> lockUsuario(mutexUsuario(usuarioId));
+
+    // Sem violação, `pendentes` nunca aloca
+    std::vector<DisparoPendente> pendentes;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexRegras);
+        avaliarRegrasUsuario(usuarioId, consumoAtual, pendentes);
+        registrarConsumoUsuario(usuarioId, consumoAtual);
+    }
+
+    std::time_t agora = std::time(nullptr);
+    for (const auto& pendente : pendentes) {
+        despacharDisparo(pendente, agora);
+    }
+    if (!pendentes.empty()) {
+        std::lock_guard<std::mutex> lock(mutexAlertas);
+        confirmarPersistencia();
+    }
+
+    return !pendentes.empty();
+}
+
+std::vector<AlertaAtivo> AlertaService::verificarRegrasEmLote(
+    const std::map<int, double>& consumoPorUsuario, size_t numParticoes) {
+    SSMH_MEDIR_LATENCIA("ssmh_alertas_verificacao_lote_latencia_segundos", "");
+
+    // Abaixo disso o custo de criar threads supera o da avaliação
+    const size_t MIN_USUARIOS_POR_PARTICAO = 512;
+
+    std::vector<std::pair<int, double>> entradas(consumoPorUsuario.begin(), consumoPorUsuario.end());
+    if (numParticoes == 0) {
+        size_t nucleos = std::max(1u, std::thread::hardware_concurrency());
+        numParticoes = std::min(nucleos, entradas.size() / MIN_USUARIOS_POR_PARTICAO);
+    }
+    numParticoes = std::max<size_t>(1, std::min(numParticoes, entradas.size()));
+
+    // Os usuários do lote ficam serializados com verificarRegras e
+    // processarLeitura até o fim do disparo. As partições de usuário são
+    // obtidas antes das regras e em ordem crescente, como em qualquer lote
+    std::array<bool, NUM_PARTICOES_USUARIO> particoesUsadas{};
+    for (const auto& entrada : entradas) {
+        particoesUsadas[static_cast<uint32_t>(entrada.first) % NUM_PARTICOES_USUARIO] = true;
+    }
+    std::vector<std::unique_lock<std::mutex>> locksUsuarios;
+    for (size_t particao = 0; particao < NUM_PARTICOES_USUARIO; ++particao) {
+        if (particoesUsadas[particao]) {
+            locksUsuarios.emplace_back(mutexPorUsuario[particao]);
+        }
+    }
 
-    for (const auto& regra : regrasUsuario) {
+    // Fase 1: avaliação em partições contíguas, cada uma com sua saída. As
+    // threads leem as regras sob o lock compartilhado obtido aqui
+    std::shared_lock<std::shared_mutex> lockRegras(mutexRegras);
+    std::vector<std::vector<DisparoPendente>> pendentesPorParticao(numParticoes);
+    size_t tamanhoParticao = (entradas.size() + numParticoes - 1) / numParticoes;
+
+    // Regras LIMITE_DIARIO: cada partição compara uma faixa de blocos inteiros
+    const bool vetorizado = limiteDiarioVetorizado && !limitesVetorizados.vazio();
+    LimitesVetorizados::Lote lote;
+    size_t blocosPorParticao = 0;
+    if (vetorizado) {
+        lote = limitesVetorizados.prepararLote(entradas);
+        size_t blocos = (limitesVetorizados.tamanho() + LimitesVetorizados::TAMANHO_BLOCO - 1) /
+                        LimitesVetorizados::TAMANHO_BLOCO;
+        blocosPorParticao = (blocos + numParticoes - 1) / numParticoes;
+    }
+    const EstrategiaAnaliseConsumo* limiteDiario =
+        vetorizado ? estrategiasAnalise.at(TIPO_LIMITE_DIARIO).get() : nullptr;
+
+    auto avaliarParticao = [&](size_t particao) {
+        std::vector<DisparoPendente>& pendentes = pendentesPorParticao[particao];
+        size_t inicio = particao * tamanhoParticao;
+        size_t fim = std::min(inicio + tamanhoParticao, entradas.size());
+        for (size_t i = inicio; i < fim; ++i) {
+            if (!vetorizado || lote.avaliarRegraARegra[i]) {
+                avaliarRegrasUsuario(entradas[i].first, entradas[i].second, pendentes, vetorizado);
+            }
+        }
+        if (!vetorizado) {
+            return;
+        }
+
+        static ContadorMetrica& regrasAvaliadas =
+            RegistroMetricas::getInstance().contador("ssmh_alertas_regras_avaliadas_total");
+        std::vector<LimitesVetorizados::Violacao> violacoes;
+        size_t primeira = particao * blocosPorParticao * LimitesVetorizados::TAMANHO_BLOCO;
+        size_t ultima = primeira + blocosPorParticao * LimitesVetorizados::TAMANHO_BLOCO;
+        regrasAvaliadas.incrementar(limitesVetorizados.avaliar(lote, primeira, ultima, violacoes));
+        for (const auto& violacao : violacoes) {
+            pendentes.push_back({violacao.usuarioId, violacao.posicaoRegra, violacao.consumo,
+                                 limiteDiario->gerarMensagem(violacao.usuarioId, violacao.consumo,
+                                     regrasAlerta[violacao.posicaoRegra].getParametros())});
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t particao = 1; particao < numParticoes; ++particao) {
+        threads.emplace_back(avaliarParticao, particao);
+    }
+    avaliarParticao(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Fase 2: histórico das estratégias, disparo e notificação, numa única thread
+    for (size_t i = 0; i < entradas.size(); ++i) {
+        if (!vetorizado || lote.avaliarRegraARegra[i]) {
+            registrarConsumoUsuario(entradas[i].first, entradas[i].second, vetorizado);
+        }
+    }
+    lockRegras.unlock();
+
+    // As violações vetorizadas saem agrupadas por faixa de regras: a ordem
+    // (usuário, regra) é a mesma da avaliação usuário a usuário
+    std::vector<DisparoPendente> pendentes;
+    for (auto& pendentesParticao : pendentesPorParticao) {
+        std::move(pendentesParticao.begin(), pendentesParticao.end(), std::back_inserter(pendentes));
+    }
+    if (vetorizado) {
+        std::sort(pendentes.begin(), pendentes.end(), [](const DisparoPendente& a, const DisparoPendente& b) {
+            return a.usuarioId != b.usuarioId ? a.usuarioId < b.usuarioId : a.posicaoRegra < b.posicaoRegra;
+        });
+    }
+
+    std::vector<AlertaAtivo> disparados;
+    std::time_t agora = std::time(nullptr);
+    for (const auto& pendente : pendentes) {
+        if (auto alerta = despacharDisparo(pendente, agora)) {
+            disparados.push_back(std::move(*alerta));
+        }
+    }
+    // Uma transação para todos os alertas do lote
+    if (!disparados.empty()) {
+        std::lock_guard<std::mutex> lock(mutexAlertas);
+        confirmarPersistencia();
+    }
+
+    std::cout << "[ALERTA_SERVICE] Verificação em lote: " << entradas.size() 
+              << " usuários, " << numParticoes << " partições, " 
+              << disparados.size() << " alertas" << std::endl;
+    return disparados;
+}
+
+int AlertaService::processarLeitura(const std::string& idSha, double valorLitros,
+                                    std::time_t dataHora) {
+    SSMH_MEDIR_LATENCIA("ssmh_alertas_leitura_latencia_segundos", "");
+
+    int usuarioId;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexRegras);
+        auto itDono = usuarioPorHidrometro.find(idSha);
+        if (itDono == usuarioPorHidrometro.end()) {
+            return 0;
+        }
+        usuarioId = itDono->second;
+    }
+
+    // Leituras do mesmo usuário são acumuladas e avaliadas uma por vez
+    std::lock_guard<std::mutex> lockUsuario(mutexUsuario(usuarioId));
+    std::shared_lock<std::shared_mutex> lockRegras(mutexRegras);
+
+    auto itIndice = indiceRegrasPorUsuario.find(usuarioId);
+    if (itIndice == indiceRegrasPorUsuario.end()) {
+        return 0;
+    }
+
+    ConsumoDiario& consumoDia = acumularConsumoDiario(usuarioId, idSha, valorLitros, dataHora);
+
+    // Uma leitura por estratégia; depois cada regra consulta o estado atualizado
+    std::vector<std::pair<size_t, EstrategiaAnaliseConsumo*>> regras;
+    std::vector<EstrategiaAnaliseConsumo*> alimentadas;
+    for (size_t posicao : itIndice->second) {
+        const RegraAlerta& regra = regrasAlerta[posicao];
         if (!regra.isAtivo()) {
             continue;
         }
 
+        auto itEstrategia = estrategiasAnalise.find(regra.getTipoEstrategia());
+        if (itEstrategia == estrategiasAnalise.end() || !itEstrategia->second) {
+            continue;
+        }
+        EstrategiaAnaliseConsumo* estrategia = itEstrategia->second.get();
+        if (std::find(alimentadas.begin(), alimentadas.end(), estrategia) == alimentadas.end()) {
+            estrategia->registrarLeitura(idSha, valorLitros, dataHora);
+            alimentadas.push_back(estrategia);
+        }
+        regras.emplace_back(posicao, estrategia);
+    }
+
+    std::vector<DisparoPendente> pendentes;
+    for (const auto& [posicao, estrategia] : regras) {
+        const ParametrosRegra& parametros = regrasAlerta[posicao].getParametros();
+
+        // Série de leituras do hidrômetro
+        DisparoPendente pendente{usuarioId, posicao, 0.0, {}};
+        if (estrategia->analisarLeitura(idSha, parametros, pendente.consumo, pendente.mensagem)) {
+            pendentes.push_back(std::move(pendente));
+            continue;
+        }
+
+        // Consumo do dia até esta leitura (o histórico das estratégias
+        // continua sendo alimentado só pela verificação diária)
+        if (!estrategia->avaliaConsumoAgregado()) {
+            continue;
+        }
+        auto& disparadas = consumoDia.regrasDisparadas;
+        if (std::find(disparadas.begin(), disparadas.end(), posicao) != disparadas.end()) {
+            continue;
+        }
+        if (estrategia->analisar(usuarioId, consumoDia.litros, parametros)) {
+            disparadas.push_back(posicao);
+            pendentes.push_back({usuarioId, posicao, consumoDia.litros,
+                                 estrategia->gerarMensagem(usuarioId, consumoDia.litros, parametros)});
+        }
+    }
+
+    lockRegras.unlock();
+
+    // A janela de supressão corre no tempo das leituras
+    int disparados = 0;
+    for (const auto& pendente : pendentes) {
+        if (despacharDisparo(pendente, dataHora)) {
+            ++disparados;
+        }
+    }
+    if (disparados > 0) {
+        std::lock_guard<std::mutex> lock(mutexAlertas);
+        confirmarPersistencia();
+    }
+    return disparados;
+}
+
+AlertaService::ConsumoDiario& AlertaService::acumularConsumoDiario(
+    int usuarioId, const std::string& idSha, double valorLitros, std::time_t dataHora) {
+    std::tm local;
+    localtime_r(&dataHora, &local);
+    long dia = local.tm_year * 1000L + local.tm_yday;
+
+    std::lock_guard<std::mutex> lock(mutexLeituras);
+    ConsumoDiario& consumoDia = consumoDiarioPorUsuario[usuarioId];
+    if (dia > consumoDia.dia) {
+        consumoDia = ConsumoDiario();
+        consumoDia.dia = dia;
+    }
+
+    // A primeira leitura de um hidrômetro só marca a base; valor menor que o
+    // anterior (troca do hidrômetro) também. O intervalo conta no dia da leitura
+    auto [itUltima, primeira] = ultimaLeituraPorHidrometro.try_emplace(idSha, valorLitros, dataHora);
+    if (!primeira) {
+        auto& [ultimoValor, ultimaData] = itUltima->second;
+        if (dataHora > ultimaData) {
+            if (dia == consumoDia.dia && valorLitros > ultimoValor) {
+                consumoDia.litros += valorLitros - ultimoValor;
+            }
+            ultimoValor = valorLitros;
+            ultimaData = dataHora;
+        }
+    }
+    return consumoDia;
+}
+
+double AlertaService::consumoDiarioIncremental(int usuarioId) const {
+    std::lock_guard<std::mutex> lockUsuario(mutexUsuario(usuarioId));
+    std::lock_guard<std::mutex> lock(mutexLeituras);
+    auto it = consumoDiarioPorUsuario.find(usuarioId);
+    return it != consumoDiarioPorUsuario.end() ? it->second.litros : 0.0;
+}
+
+void AlertaService::vincularHidrometro(int usuarioId, const std::string& idSha) {
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
+    usuarioPorHidrometro[idSha] = usuarioId;
+}
+
+void AlertaService::desvincularHidrometro(const std::string& idSha) {
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
+    usuarioPorHidrometro.erase(idSha);
+    
+    std::lock_guard<std::mutex> lockLeituras(mutexLeituras);
+    ultimaLeituraPorHidrometro.erase(idSha);
+}
+
+void AlertaService::avaliarRegrasUsuario(int usuarioId, double consumoAtual,
+                                         std::vector<DisparoPendente>& pendentes,
+                                         bool ignorarLimiteDiario) const {
+    static ContadorMetrica& regrasAvaliadas =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_regras_avaliadas_total");
+
+    auto itIndice = indiceRegrasPorUsuario.find(usuarioId);
+    if (itIndice == indiceRegrasPorUsuario.end()) {
+        return;
+    }
+
+    for (size_t posicao : itIndice->second) {
+        const RegraAlerta& regra = regrasAlerta[posicao];
+        if (!regra.isAtivo() || (ignorarLimiteDiario && regra.getTipoEstrategia() == TIPO_LIMITE_DIARIO)) {
+            continue;
+        }
+
         // Obtém a estratégia de análise
-        auto estrategia = obterEstrategiaAnalise(regra.getTipoEstrategia());
-        if (!estrategia) {
+        auto itEstrategia = estrategiasAnalise.find(regra.getTipoEstrategia());
+        if (itEstrategia == estrategiasAnalise.end() || !itEstrategia->second) {
             std::cerr << "[ALERTA_SERVICE] Estratégia não encontrada: " 
                       << regra.getTipoEstrategia() << std::endl;
             continue;
         }
+        const EstrategiaAnaliseConsumo* estrategia = itEstrategia->second.get();
+        if (!estrategia->avaliaConsumoAgregado()) {
+            continue;
+        }
 
         // Analisa o consumo
-        bool violou = estrategia->analisar(consumoAtual, regra.getValorParametro());
+        bool violou = estrategia->analisar(usuarioId, consumoAtual, regra.getParametros());
+        regrasAvaliadas.incrementar();
 
         if (violou) {
             // Gera mensagem descritiva
-            std::string mensagem = estrategia->gerarMensagem(consumoAtual, 
-                                                             regra.getValorParametro());
+            pendentes.push_back({usuarioId, posicao, consumoAtual,
+                                 estrategia->gerarMensagem(usuarioId, consumoAtual,
+                                                           regra.getParametros())});
+        }
+    }
+}
+
+void AlertaService::registrarConsumoUsuario(int usuarioId, double consumoAtual,
+                                            bool ignorarLimiteDiario) {
+    auto itIndice = indiceRegrasPorUsuario.find(usuarioId);
+    if (itIndice == indiceRegrasPorUsuario.end()) {
+        return;
+    }
+
+    // Uma amostra por estratégia, mesmo com várias regras do mesmo tipo
+    std::vector<EstrategiaAnaliseConsumo*> alimentadas;
+    for (size_t posicao : itIndice->second) {
+        const RegraAlerta& regra = regrasAlerta[posicao];
+        if (!regra.isAtivo() || (ignorarLimiteDiario && regra.getTipoEstrategia() == TIPO_LIMITE_DIARIO)) {
+            continue;
+        }
 
-            // Dispara o alerta
-            AlertaAtivo alerta = dispararAlerta(usuarioId, regra, consumoAtual, mensagem);
-            
-            // Notifica todos os observers
-            notificarObservers(alerta);
-            
-            violacaoDetectada = true;
+        auto itEstrategia = estrategiasAnalise.find(regra.getTipoEstrategia());
+        if (itEstrategia == estrategiasAnalise.end() || !itEstrategia->second) {
+            continue;
+        }
+        EstrategiaAnaliseConsumo* estrategia = itEstrategia->second.get();
+        if (std::find(alimentadas.begin(), alimentadas.end(), estrategia) == alimentadas.end()) {
+            estrategia->registrarConsumo(usuarioId, consumoAtual);
+            alimentadas.push_back(estrategia);
+        }
+    }
+}
 
-            std::cout << "[ALERTA_SERVICE] ⚠️  ALERTA DISPARADO para usuário " 
-                      << usuarioId << std::endl;
+std::optional<AlertaAtivo> AlertaService::despacharDisparo(const DisparoPendente& pendente,
+                                                           std::time_t instante) {
+    static ContadorMetrica& alertasDisparados =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_disparados_total");
+    static ContadorMetrica& suprimidos =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_suprimidos_total");
+
+    // Cópia: um observer pode cadastrar regras e realocar regrasAlerta
+    RegraAlerta regra;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexRegras);
+        regra = regrasAlerta[pendente.posicaoRegra];
+    }
+    AlertaAtivo::Severidade severidade = determinarSeveridade(pendente.consumo, regra);
+    std::string mensagem = pendente.mensagem;
+
+    std::unique_lock<std::mutex> lockAlertas(mutexAlertas);
+    EstadoSupressao* estado = nullptr;
+    uint64_t chave = 0;
+    if (janelaSupressao.count() > 0) {
+        chave = (static_cast<uint64_t>(static_cast<uint32_t>(pendente.usuarioId)) << 32) |
+                static_cast<uint32_t>(regra.getId());
+        auto [it, novo] = supressaoPorRegra.try_emplace(chave);
+        estado = &it->second;
+        
+        if (!novo) {
+            // Só uma escalada de severidade fura a janela. Instante anterior ao
+            // último alerta (leituras antigas depois de uma verificação no
+            // relógio do sistema, ou o inverso) reinicia a janela em vez de
+            // suprimir até o outro relógio alcançá-lo
+            bool dentroJanela = instante >= estado->ultimoDisparo &&
+                                instante - estado->ultimoDisparo < janelaSupressao.count();
+            if (dentroJanela && severidade <= estado->severidade) {
+                ++estado->suprimidos;
+                ++alertasSuprimidos;
+                suprimidos.incrementar();
+                return std::nullopt;
+            }
+            if (estado->suprimidos > 0) {
+                mensagem += " (" + std::to_string(estado->suprimidos) + 
+                            " ocorrências suprimidas desde o último alerta)";
+            }
         }
     }
 
-    return violacaoDetectada;
+    AlertaAtivo alerta = dispararAlerta(pendente.usuarioId, regra, pendente.consumo,
+                                        mensagem, severidade);
+    if (estado) {
+        chaveSupressaoPorAlerta.erase(estado->alertaId);
+        *estado = {instante, alerta.getId(), severidade, 0};
+        chaveSupressaoPorAlerta[alerta.getId()] = chave;
+    }
+    lockAlertas.unlock();
+
+    // Notifica todos os observers
+    notificarObservers(alerta);
+    alertasDisparados.incrementar();
+
+    std::cout << "[ALERTA_SERVICE] ⚠️  ALERTA DISPARADO para usuário " 
+              << pendente.usuarioId << std::endl;
+    return alerta;
 }
 
-void AlertaService::executarVerificacaoAutomatica() {
+int AlertaService::executarVerificacaoAutomatica(std::time_t dataInicio, std::time_t dataFim) {
     std::cout << "[ALERTA_SERVICE] Executando verificação automática..." << std::endl;
-    
-    // Em produção, aqui buscaria o consumo real do banco de dados
-    // Para demonstração, simula verificação
-    
-    std::vector<RegraAlerta> regrasAtivas = buscarRegrasAtivas();
-    std::cout << "[ALERTA_SERVICE] Verificando " << regrasAtivas.size() 
-              << " regras ativas" << std::endl;
 
-    // Agrupa por usuário
-    std::map<int, bool> usuariosVerificados;
-    for (const auto& regra : regrasAtivas) {
-        int usuarioId = regra.getUsuarioId();
-        if (usuariosVerificados.find(usuarioId) == usuariosVerificados.end()) {
-            // Simula consumo (em produção, viria do banco)
-            double consumoSimulado = 75.0; // Exemplo
-            verificarRegras(usuarioId, consumoSimulado);
-            usuariosVerificados[usuarioId] = true;
+    FonteConsumo fonte;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexRegras);
+        fonte = fonteConsumo;
+    }
+    if (!fonte) {
+        std::cerr << "[ALERTA_SERVICE] Fonte de consumo não configurada; "
+                  << "verificação automática ignorada" << std::endl;
+        return 0;
+    }
+
+    if (dataFim == 0) {
+        dataFim = std::time(nullptr);
+    }
+    if (dataInicio == 0) {
+        dataInicio = dataFim - 24 * 60 * 60;
+    }
+
+    std::vector<int> usuarios = listarUsuariosComRegrasAtivas();
+    std::cout << "[ALERTA_SERVICE] Verificando " << usuarios.size() 
+              << " usuários com regras ativas" << std::endl;
+    if (usuarios.empty()) {
+        return 0;
+    }
+
+    std::map<int, double> consumoPorUsuario = fonte(usuarios, dataInicio, dataFim);
+    return static_cast<int>(verificarRegrasEmLote(consumoPorUsuario).size());
+}
+
+void AlertaService::definirFonteConsumo(FonteConsumo fonte) {
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
+    fonteConsumo = std::move(fonte);
+}
+
+void AlertaService::definirJanelaSupressao(std::chrono::seconds janela) {
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    janelaSupressao = janela;
+    if (janela.count() <= 0) {
+        supressaoPorRegra.clear();
+        chaveSupressaoPorAlerta.clear();
+    }
+}
+
+std::chrono::seconds AlertaService::getJanelaSupressao() const {
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    return janelaSupressao;
+}
+
+std::vector<int> AlertaService::listarUsuariosComRegrasAtivas() const {
+    std::shared_lock<std::shared_mutex> lock(mutexRegras);
+    std::vector<int> usuarios;
+    for (const auto& [usuarioId, posicoes] : indiceRegrasPorUsuario) {
+        bool possuiAtiva = std::any_of(posicoes.begin(), posicoes.end(),
+            [this](size_t posicao) { return regrasAlerta[posicao].isAtivo(); });
+        if (possuiAtiva) {
+            usuarios.push_back(usuarioId);
         }
     }
+    return usuarios;
 }
 
 // ==================== Gerenciamento de Alertas Ativos ====================
 
 std::vector<AlertaAtivo> AlertaService::buscarAlertasAtivos() const {
-    std::vector<AlertaAtivo> resultado;
-    for (const auto& alerta : alertasAtivos) {
-        if (alerta.getStatus() == AlertaAtivo::ATIVO) {
-            resultado.push_back(alerta);
-        }
-    }
-    return resultado;
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    return alertas.listarPorStatus(AlertaAtivo::ATIVO);
 }
 
 std::vector<AlertaAtivo> AlertaService::buscarAlertasPorUsuario(int usuarioId) const {
-    std::vector<AlertaAtivo> resultado;
-    for (const auto& alerta : alertasAtivos) {
-        if (alerta.getUsuarioId() == usuarioId) {
-            resultado.push_back(alerta);
-        }
-    }
-    return resultado;
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    return alertas.listarPorUsuario(usuarioId);
 }
 
 bool AlertaService::resolverAlerta(int alertaId) {
-    for (auto& alerta : alertasAtivos) {
-        if (alerta.getId() == alertaId) {
-            alerta.setStatus(AlertaAtivo::RESOLVIDO);
-            std::cout << "[ALERTA_SERVICE] Alerta " << alertaId << " marcado como resolvido" 
-                      << std::endl;
-            return true;
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    if (!alertas.alterarStatus(alertaId, AlertaAtivo::RESOLVIDO)) {
+        return false;
+    }
+    if (persistencia) {
+        // O limite de encerrados pode ter descartado o próprio alerta
+        if (const AlertaAtivo* alerta = alertas.buscar(alertaId)) {
+            persistencia->salvarAlerta(*alerta);
+            confirmarPersistencia();
         }
     }
-    return false;
+    
+    // A próxima violação da regra volta a alertar
+    auto itChave = chaveSupressaoPorAlerta.find(alertaId);
+    if (itChave != chaveSupressaoPorAlerta.end()) {
+        supressaoPorRegra.erase(itChave->second);
+        chaveSupressaoPorAlerta.erase(itChave);
+    }
+    
+    std::cout << "[ALERTA_SERVICE] Alerta " << alertaId << " marcado como resolvido" 
+              << std::endl;
+    return true;
 }
 
 void AlertaService::limparAlertasAntigos(int diasRetencao) {
     time_t agora = std::time(nullptr);
     time_t limiteRetencao = agora - (diasRetencao * 24 * 60 * 60);
 
-    auto novoFim = std::remove_if(alertasAtivos.begin(), alertasAtivos.end(),
-        [limiteRetencao](const AlertaAtivo& alerta) {
-            return alerta.getDataDisparo() < limiteRetencao;
-        });
+    std::lock_guard<std::mutex> lock(mutexAlertas);
 
-    size_t removidos = std::distance(novoFim, alertasAtivos.end());
-    alertasAtivos.erase(novoFim, alertasAtivos.end());
+    size_t removidos = alertas.removerAnteriores(limiteRetencao);
+    if (persistencia) {
+        persistencia->removerAlertasAnteriores(limiteRetencao);
+        confirmarPersistencia();
+    }
 
     if (removidos > 0) {
         std::cout << "[ALERTA_SERVICE] " << removidos << " alertas antigos removidos" 
@@ -212,9 +752,84 @@ void AlertaService::limparAlertasAntigos(int diasRetencao) {
     }
 }
 
+void AlertaService::definirLimiteAlertasEncerrados(size_t maximo) {
+    std::lock_guard<std::mutex> lock(mutexAlertas);
+    alertas.setMaxEncerrados(maximo);
+}
+
+// ==================== Persistência ====================
+
+bool AlertaService::definirPersistencia(std::shared_ptr<PersistenciaAlertas> novaPersistencia) {
+    std::unique_lock<std::shared_mutex> lockRegras(mutexRegras);
+    std::lock_guard<std::mutex> lockAlertas(mutexAlertas);
+    persistencia.reset();
+    if (!novaPersistencia) {
+        return true;
+    }
+
+    std::vector<RegraAlerta> regrasGravadas;
+    std::vector<AlertaAtivo> alertasGravados;
+    int maiorIdAlerta = 0;
+    try {
+        regrasGravadas = novaPersistencia->carregarRegras();
+        alertasGravados = novaPersistencia->carregarAlertas(alertas.getMaxEncerrados());
+        maiorIdAlerta = novaPersistencia->maiorIdAlerta();
+    } catch (const std::exception& e) {
+        std::cerr << "[ALERTA_SERVICE] Erro ao carregar alertas gravados: " << e.what() << std::endl;
+        return false;
+    }
+
+    regrasAlerta.reserve(regrasAlerta.size() + regrasGravadas.size());
+    for (auto& regra : regrasGravadas) {
+        proximoIdRegra = std::max(proximoIdRegra, regra.getId() + 1);
+
+        // Parâmetros não são gravados: a estratégia os recompila
+        auto itEstrategia = estrategiasAnalise.find(regra.getTipoEstrategia());
+        try {
+            if (itEstrategia == estrategiasAnalise.end()) {
+                throw std::invalid_argument("estratégia não registrada");
+            }
+            regra.setParametros(itEstrategia->second->compilarParametros(regra.getValorParametro()));
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "[ALERTA_SERVICE] Regra " << regra.getId() << " ignorada: " 
+                      << e.what() << std::endl;
+            continue;
+        }
+
+        size_t posicao = regrasAlerta.size();
+        indiceRegrasPorUsuario[regra.getUsuarioId()].push_back(posicao);
+        indiceRegrasPorId[regra.getId()] = posicao;
+        regrasAlerta.push_back(std::move(regra));
+    }
+    reconstruirLimitesVetorizados();
+
+    for (const auto& alerta : alertasGravados) {
+        alertas.inserir(alerta);
+    }
+    proximoIdAlerta = std::max(proximoIdAlerta, maiorIdAlerta + 1);
+
+    persistencia = std::move(novaPersistencia);
+    std::cout << "[ALERTA_SERVICE] Persistência ativa: " << regrasGravadas.size() << " regras e " 
+              << alertasGravados.size() << " alertas carregados" << std::endl;
+    return true;
+}
+
+void AlertaService::confirmarPersistencia() {
+    if (!persistencia) {
+        return;
+    }
+    try {
+        persistencia->confirmar();
+    } catch (const std::exception& e) {
+        // As escritas continuam pendentes e vão na próxima confirmação
+        std::cerr << "[ALERTA_SERVICE] Erro ao gravar alertas: " << e.what() << std::endl;
+    }
+}
+
 // ==================== Configuração de Estratégias ====================
 
 void AlertaService::definirEstrategiaNotificacao(std::shared_ptr<NotificacaoStrategy> strategy) {
+    std::lock_guard<std::mutex> lock(mutexObservers);
     notificacaoStrategy = strategy;
     std::cout << "[ALERTA_SERVICE] Estratégia de notificação alterada para: " 
               << strategy->getNomeCanal() << std::endl;
@@ -222,34 +837,88 @@ void AlertaService::definirEstrategiaNotificacao(std::shared_ptr<NotificacaoStra
 
 void AlertaService::registrarEstrategiaAnalise(const std::string& tipo, 
                                                 std::shared_ptr<EstrategiaAnaliseConsumo> strategy) {
+    std::unique_lock<std::shared_mutex> lock(mutexRegras);
     estrategiasAnalise[tipo] = strategy;
+    if (tipo == TIPO_LIMITE_DIARIO) {
+        // Só a implementação padrão tem a semântica de consumo > limite da comparação em bloco
+        limiteDiarioVetorizado = strategy && typeid(*strategy) == typeid(LimiteDiarioStrategy);
+        reconstruirLimitesVetorizados();
+    }
     std::cout << "[ALERTA_SERVICE] Estratégia de análise registrada: " << tipo << std::endl;
 }
 
+void AlertaService::reconstruirLimitesVetorizados() {
+    limitesVetorizados.limpar();
+    if (!limiteDiarioVetorizado) {
+        return;
+    }
+    for (size_t posicao = 0; posicao < regrasAlerta.size(); ++posicao) {
+        const RegraAlerta& regra = regrasAlerta[posicao];
+        if (!regra.isAtivo()) {
+            continue;
+        }
+        if (regra.getTipoEstrategia() == TIPO_LIMITE_DIARIO) {
+            limitesVetorizados.adicionar(regra.getUsuarioId(), posicao, regra.getParametros().limiteLitros);
+        } else {
+            limitesVetorizados.marcarOutrasRegras(regra.getUsuarioId());
+        }
+    }
+}
+
 // ==================== Métodos Auxiliares ====================
 
 std::string AlertaService::getEstatisticas() const {
+    size_t totalRegras = 0;
+    size_t regrasAtivas = 0;
+    size_t totalEstrategias = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexRegras);
+        totalRegras = regrasAlerta.size();
+        for (const auto& regra : regrasAlerta) {
+            if (regra.isAtivo()) {
+                ++regrasAtivas;
+            }
+        }
+        totalEstrategias = estrategiasAnalise.size();
+    }
+
+    size_t alertasAtivos = 0;
+    size_t totalAlertas = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutexAlertas);
+        alertasAtivos = alertas.contarPorStatus(AlertaAtivo::ATIVO);
+        totalAlertas = alertas.tamanho();
+    }
+
+    size_t totalObservers = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutexObservers);
+        totalObservers = observers.size();
+    }
+
     std::stringstream ss;
     ss << "=== Estatísticas do Sistema de Alertas ===\n"
-       << "Regras cadastradas: " << regrasAlerta.size() << "\n"
-       << "Regras ativas: " << buscarRegrasAtivas().size() << "\n"
-       << "Alertas ativos: " << buscarAlertasAtivos().size() << "\n"
-       << "Total de alertas: " << alertasAtivos.size() << "\n"
-       << "Observers registrados: " << observers.size() << "\n"
-       << "Estratégias de análise: " << estrategiasAnalise.size();
+       << "Regras cadastradas: " << totalRegras << "\n"
+       << "Regras ativas: " << regrasAtivas << "\n"
+       << "Alertas ativos: " << alertasAtivos << "\n"
+       << "Total de alertas: " << totalAlertas << "\n"
+       << "Observers registrados: " << totalObservers << "\n"
+       << "Estratégias de análise: " << totalEstrategias;
     return ss.str();
 }
 
 // ==================== Métodos Privados ====================
 
-AlertaAtivo AlertaService::dispararAlerta(int usuarioId, const RegraAlerta& regra, 
-                                          double consumoAtual, const std::string& mensagem) {
-    AlertaAtivo::Severidade severidade = determinarSeveridade(consumoAtual, regra);
-    
+AlertaAtivo AlertaService::dispararAlerta(int usuarioId, const RegraAlerta& regra, double consumoAtual,
+                                          const std::string& mensagem,
+                                          AlertaAtivo::Severidade severidade) {
     AlertaAtivo alerta(proximoIdAlerta++, usuarioId, mensagem, 
                        consumoAtual, regra.getTipoEstrategia(), severidade);
     
-    alertasAtivos.push_back(alerta);
+    alertas.inserir(alerta);
+    if (persistencia) {
+        persistencia->salvarAlerta(alerta);
+    }
     return alerta;
 }
 
@@ -265,7 +934,7 @@ std::shared_ptr<EstrategiaAnaliseConsumo> AlertaService::obterEstrategiaAnalise(
 
 AlertaAtivo::Severidade AlertaService::determinarSeveridade(double consumoAtual, 
                                                              const RegraAlerta& regra) const {
-    double parametro = regra.getValorParametroNumerico();
+    double parametro = regra.getParametros().referenciaSeveridade;
     
     if (parametro == 0) {
         return AlertaAtivo::MEDIA;
@@ -4,12 +4,26 @@
 #include "../domain/regra_alerta.hpp"
 #include "../domain/alerta_ativo.hpp"
 #include "../strategies/estrategia_analise_consumo.hpp"
+#include "../strategies/limites_vetorizados.hpp"
 #include "../notifications/notificacao_strategy.hpp"
 #include "../observers/alert_observer.hpp"
+#include "../observers/observer_assincrono.hpp"
+#include "../storage/repositorio_alertas.hpp"
+#include "../storage/persistencia_alertas.hpp"
 #include <vector>
 #include <map>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <functional>
+#include <chrono>
+#include <optional>
+#include <cstdint>
+#include <ctime>
 
 /**
  * @brief Serviço principal do subsistema de alertas
@@ -26,12 +40,36 @@
  * - Verificar violações de consumo
  * - Notificar observers quando alertas são disparados
  * - Manter histórico de alertas ativos
+ * 
+ * Thread-safety: todos os métodos públicos podem ser chamados de várias
+ * threads. A avaliação de um mesmo usuário é serializada (mutex por
+ * partição de usuários); usuários diferentes são avaliados em paralelo,
+ * só lendo as regras (shared_mutex). Alertas, ids e supressão ficam sob
+ * um mutex próprio, e os observers síncronos recebem um alerta por vez.
+ * Um observer síncrono pode cadastrar regras e resolver alertas, mas não
+ * verificar o mesmo usuário nem anexar/desanexar observers.
  */
 class AlertaService {
+public:
+    /**
+     * @brief Fonte do consumo real usada pela verificação automática
+     * 
+     * Recebe os usuários a verificar e o período, e devolve o consumo (L)
+     * de cada um. Fica fora do subsistema: quem conhece os hidrômetros de
+     * cada usuário e o monitoramento (a Fachada) a fornece.
+     */
+    using FonteConsumo = std::function<std::map<int, double>(
+        const std::vector<int>& usuarios, std::time_t dataInicio, std::time_t dataFim)>;
+
 private:
     // Padrão Observer
     std::vector<std::shared_ptr<AlertObserver>> observers;
 
+    // Modo assíncrono: um despachante por observer, na mesma ordem de `observers`
+    std::atomic<bool> notificacaoAssincrona{false};
+    ObserverAssincrono::Configuracao configuracaoAssincrona;
+    std::vector<std::shared_ptr<ObserverAssincrono>> despachantes;
+
     // Padrão Strategy - Análise
     std::map<std::string, std::shared_ptr<EstrategiaAnaliseConsumo>> estrategiasAnalise;
 
@@ -40,12 +78,77 @@ private:
 
     // Dados
     std::vector<RegraAlerta> regrasAlerta;
-    std::vector<AlertaAtivo> alertasAtivos;
+    RepositorioAlertas alertas;
+
+    // Índices sobre regrasAlerta (posições no vetor; regras nunca são removidas)
+    std::map<int, std::vector<size_t>> indiceRegrasPorUsuario;
+    std::map<int, size_t> indiceRegrasPorId;
+
+    // Regras LIMITE_DIARIO em vetores para verificarRegrasEmLote; mantidas só
+    // enquanto o tipo é avaliado pela LimiteDiarioStrategy padrão
+    LimitesVetorizados limitesVetorizados;
+    bool limiteDiarioVetorizado = false;
+    
+    // Dono de cada hidrômetro, para avaliar leituras (ver processarLeitura)
+    std::unordered_map<std::string, int> usuarioPorHidrometro;
+
+    /**
+     * @brief Consumo do dia corrente de um usuário, somado leitura a leitura
+     */
+    struct ConsumoDiario {
+        long dia = -1;                        // data local (ano * 1000 + dia do ano)
+        double litros = 0.0;
+        std::vector<size_t> regrasDisparadas; // já alertadas hoje pela avaliação incremental
+    };
+
+    // Estado da avaliação incremental (processarLeitura)
+    std::unordered_map<std::string, std::pair<double, std::time_t>> ultimaLeituraPorHidrometro;
+    std::unordered_map<int, ConsumoDiario> consumoDiarioPorUsuario;
+    
+    /**
+     * @brief Último alerta de uma regra de um usuário, para a supressão de repetições
+     */
+    struct EstadoSupressao {
+        std::time_t ultimoDisparo;
+        int alertaId;
+        AlertaAtivo::Severidade severidade;
+        uint32_t suprimidos;                  // violações repetidas desde o último alerta
+    };
+
+    // Supressão (ver definirJanelaSupressao); chave: (usuário, regra)
+    std::chrono::seconds janelaSupressao{0};
+    std::unordered_map<uint64_t, EstadoSupressao> supressaoPorRegra;
+    std::unordered_map<int, uint64_t> chaveSupressaoPorAlerta;  // alerta -> chave, para resolverAlerta
+    std::atomic<uint64_t> alertasSuprimidos{0};
+    
+    // Regras e alertas gravados ao fim de cada operação (ver definirPersistencia)
+    std::shared_ptr<PersistenciaAlertas> persistencia;
+    
+    // Consumo real para a verificação automática (ver definirFonteConsumo)
+    FonteConsumo fonteConsumo;
     
     // Contadores
     int proximoIdRegra;
     int proximoIdAlerta;
 
+    // Sincronização; ordem de aquisição: usuário → regras → leituras → alertas → observers
+    static constexpr size_t NUM_PARTICOES_USUARIO = 64;
+    mutable std::array<std::mutex, NUM_PARTICOES_USUARIO> mutexPorUsuario; // avaliação de cada usuário
+    mutable std::shared_mutex mutexRegras;  // regras, índices, estratégias, vínculos e fonte de consumo
+    mutable std::mutex mutexLeituras;       // ultimaLeituraPorHidrometro e mapa de consumo diário
+    mutable std::mutex mutexAlertas;        // alertas, ids, supressão e persistência
+    mutable std::mutex mutexObservers;      // observers, despachantes e estratégia de notificação
+
+    /**
+     * @brief Violação encontrada na fase de avaliação, ainda não disparada
+     */
+    struct DisparoPendente {
+        int usuarioId;
+        size_t posicaoRegra;
+        double consumo;
+        std::string mensagem;
+    };
+
 public:
     AlertaService();
 
@@ -63,9 +166,32 @@ public:
 
     /**
      * @brief Notifica todos os observers sobre um alerta
+     * 
+     * No modo assíncrono apenas enfileira o alerta para cada observer.
      */
     void notificarObservers(const AlertaAtivo& alerta);
 
+    /**
+     * @brief Liga/desliga a entrega assíncrona de alertas aos observers
+     * 
+     * Ligada, cada observer recebe os alertas por um ObserverAssincrono
+     * (thread e fila limitada próprias), e verificarRegras() não espera
+     * nenhum observer. Ao desligar, as filas são entregues antes.
+     */
+    void definirNotificacaoAssincrona(bool ativa,
+                                      ObserverAssincrono::Configuracao configuracao = {});
+    bool isNotificacaoAssincrona() const { return notificacaoAssincrona; }
+
+    /**
+     * @brief Bloqueia até todos os alertas enfileirados serem entregues
+     */
+    void aguardarNotificacoes();
+
+    /**
+     * @brief Alertas descartados por filas cheias no modo assíncrono
+     */
+    uint64_t getNotificacoesDescartadas() const;
+
     // ==================== Gerenciamento de Regras ====================
     
     /**
@@ -74,7 +200,9 @@ public:
      * @param usuarioId ID do usuário
      * @param tipoEstrategia Tipo de análise ("LIMITE_DIARIO", "MEDIA_MOVEL", etc)
      * @param valorParametro Parâmetro da regra (ex: "70" para limite)
-     * @return ID da regra criada
+     * @return ID da regra criada, ou -1 se a estratégia não existir ou o
+     *         parâmetro for inválido para ela (o parâmetro é interpretado
+     *         aqui, uma única vez)
      */
     int salvarRegra(int usuarioId, const std::string& tipoEstrategia, 
                     const std::string& valorParametro);
@@ -101,17 +229,97 @@ public:
      * 
      * @param usuarioId ID do usuário
      * @param consumoAtual Consumo atual em litros
-     * @return true se alguma regra foi violada
+     * @return true se alguma regra foi violada (mesmo que o alerta tenha sido suprimido)
      */
     bool verificarRegras(int usuarioId, double consumoAtual);
 
+    /**
+     * @brief Avalia as regras de vários usuários de uma vez
+     * 
+     * As regras ativas são avaliadas em partições paralelas (somente
+     * leitura); as violações encontradas são então disparadas e notificadas
+     * aos observers numa única fase, em ordem de usuário. Regras
+     * LIMITE_DIARIO são comparadas em bloco (LimitesVetorizados), sem
+     * chamada virtual por regra. As partições dos usuários do lote ficam
+     * obtidas da avaliação ao disparo, serializando-o com verificarRegras()
+     * e processarLeitura() dos mesmos usuários.
+     * 
+     * @param consumoPorUsuario Consumo atual (L) de cada usuário
+     * @param numParticoes Threads de avaliação (0 = conforme o hardware e o tamanho do lote)
+     * @return Alertas disparados (sem os suprimidos)
+     */
+    std::vector<AlertaAtivo> verificarRegrasEmLote(const std::map<int, double>& consumoPorUsuario,
+                                                   size_t numParticoes = 0);
+
     /**
      * @brief Executa verificação automática para todos os usuários com regras
      * 
      * Este método deve ser chamado periodicamente (ex: a cada hora)
-     * para monitorar o consumo de todos os usuários
+     * para monitorar o consumo de todos os usuários. O consumo vem da
+     * fonte configurada em definirFonteConsumo(); sem ela nada é verificado.
+     * 
+     * @param dataInicio Início do período (0 = 24h antes de dataFim)
+     * @param dataFim Fim do período (0 = agora)
+     * @return Quantidade de alertas disparados
+     */
+    int executarVerificacaoAutomatica(std::time_t dataInicio = 0, std::time_t dataFim = 0);
+
+    /**
+     * @brief Define de onde a verificação automática obtém o consumo
+     */
+    void definirFonteConsumo(FonteConsumo fonte);
+
+    /**
+     * @brief Avalia uma leitura bruta de hidrômetro contra as regras do dono
+     * 
+     * Modo orientado a eventos: a diferença para a leitura anterior do
+     * hidrômetro é somada ao consumo do dia do usuário vinculado, e só as
+     * regras ativas desse usuário são reavaliadas, com esse consumo diário e
+     * com a série de leituras (ex: detecção de vazamento). Cada regra
+     * dispara no máximo uma vez por dia por este caminho. Hidrômetros sem
+     * vínculo (ver vincularHidrometro) são ignorados.
+     * 
+     * @param valorLitros Valor acumulado lido no hidrômetro
+     * @return Quantidade de alertas disparados
+     */
+    int processarLeitura(const std::string& idSha, double valorLitros, std::time_t dataHora);
+
+    /**
+     * @brief Registra o usuário dono de um hidrômetro para processarLeitura()
      */
-    void executarVerificacaoAutomatica();
+    void vincularHidrometro(int usuarioId, const std::string& idSha);
+    void desvincularHidrometro(const std::string& idSha);
+
+    /**
+     * @brief Consumo acumulado por processarLeitura() no dia da leitura mais recente
+     */
+    double consumoDiarioIncremental(int usuarioId) const;
+
+    /**
+     * @brief Janela em que violações repetidas da mesma regra não geram novo alerta
+     * 
+     * Dentro da janela, contada do último alerta da regra para o usuário,
+     * uma nova violação só dispara (e notifica os observers) se a
+     * severidade subir; as demais são só contadas, e o próximo alerta
+     * informa quantas foram. Resolver o alerta encerra a supressão.
+     * 0 (padrão) desliga.
+     * 
+     * processarLeitura() conta a janela no horário das leituras; as demais
+     * verificações, no relógio do sistema. Uma violação datada antes do
+     * último alerta da regra reinicia a janela.
+     */
+    void definirJanelaSupressao(std::chrono::seconds janela);
+    std::chrono::seconds getJanelaSupressao() const;
+    
+    /**
+     * @brief Violações que não viraram alerta por estarem dentro da janela
+     */
+    uint64_t getAlertasSuprimidos() const { return alertasSuprimidos; }
+
+    /**
+     * @brief Usuários com ao menos uma regra ativa
+     */
+    std::vector<int> listarUsuariosComRegrasAtivas() const;
 
     // ==================== Gerenciamento de Alertas Ativos ====================
     
@@ -135,6 +343,28 @@ public:
      */
     void limparAlertasAntigos(int diasRetencao = 30);
 
+    /**
+     * @brief Quantos alertas encerrados manter; os mais antigos saem primeiro
+     * 
+     * Alertas ativos não contam para o limite (padrão 100000; 0 = sem limite).
+     */
+    void definirLimiteAlertasEncerrados(size_t maximo);
+
+    // ==================== Persistência ====================
+    
+    /**
+     * @brief Passa a gravar regras e alertas e carrega o que já estava gravado
+     * 
+     * As regras gravadas (com os parâmetros recompilados pelas estratégias)
+     * e os alertas ativos, mais os encerrados mais recentes até o limite,
+     * entram nos índices em memória, e os ids continuam de onde pararam.
+     * Deve ser chamado antes de cadastrar regras. Daí em diante as escritas
+     * de cada operação são gravadas juntas ao fim dela.
+     * 
+     * @return false se o carregamento falhou (o serviço segue sem persistência)
+     */
+    bool definirPersistencia(std::shared_ptr<PersistenciaAlertas> persistencia);
+
     // ==================== Configuração de Estratégias ====================
     
     /**
@@ -157,10 +387,69 @@ public:
 
 private:
     /**
-     * @brief Dispara um novo alerta
+     * @brief Partição (mutex) que serializa a avaliação de um usuário
+     */
+    std::mutex& mutexUsuario(int usuarioId) const {
+        return mutexPorUsuario[static_cast<uint32_t>(usuarioId) % NUM_PARTICOES_USUARIO];
+    }
+
+    /**
+     * @brief Avalia as regras ativas de um usuário, sem efeitos colaterais
+     * 
+     * Acrescenta as violações em `pendentes`. Só lê regras e estratégias,
+     * por isso pode rodar em paralelo para usuários diferentes
+     * (mutexRegras já obtido, ao menos compartilhado).
+     * 
+     * @param ignorarLimiteDiario Pula as regras avaliadas por limitesVetorizados
+     */
+    void avaliarRegrasUsuario(int usuarioId, double consumoAtual,
+                              std::vector<DisparoPendente>& pendentes,
+                              bool ignorarLimiteDiario = false) const;
+
+    /**
+     * @brief Refaz limitesVetorizados a partir das regras ativas (mutexRegras exclusivo)
+     */
+    void reconstruirLimitesVetorizados();
+
+    /**
+     * @brief Soma a leitura ao consumo do dia do usuário
+     * 
+     * Chamado com a partição do usuário obtida, que protege o estado devolvido.
+     * @return Estado do dia após a leitura
+     */
+    ConsumoDiario& acumularConsumoDiario(int usuarioId, const std::string& idSha,
+                                         double valorLitros, std::time_t dataHora);
+
+    /**
+     * @brief Entrega o consumo verificado às estratégias das regras ativas do usuário
+     * 
+     * Feito depois da avaliação, para que a amostra atual não entre na
+     * própria base de comparação (mutexRegras já obtido).
+     * 
+     * @param ignorarLimiteDiario Pula as regras de limitesVetorizados, cuja
+     *        estratégia não guarda histórico
+     */
+    void registrarConsumoUsuario(int usuarioId, double consumoAtual, bool ignorarLimiteDiario = false);
+
+    /**
+     * @brief Grava as escritas pendentes da operação; falhas são só registradas
+     * (mutexAlertas já obtido)
+     */
+    void confirmarPersistencia();
+
+    /**
+     * @brief Registra o alerta de uma violação e notifica os observers
+     * 
+     * @param instante Momento da violação, para a janela de supressão
+     * @return O alerta, ou nada se a violação foi suprimida
+     */
+    std::optional<AlertaAtivo> despacharDisparo(const DisparoPendente& pendente, std::time_t instante);
+
+    /**
+     * @brief Dispara um novo alerta (mutexAlertas já obtido)
      */
-    AlertaAtivo dispararAlerta(int usuarioId, const RegraAlerta& regra, 
-                               double consumoAtual, const std::string& mensagem);
+    AlertaAtivo dispararAlerta(int usuarioId, const RegraAlerta& regra, double consumoAtual,
+                               const std::string& mensagem, AlertaAtivo::Severidade severidade);
 
     /**
      * @brief Obtém a estratégia de análise para um tipo
@@ -1,4 +1,5 @@
 #include "alerta_service_factory.hpp"
+#include "../storage/persistencia_alertas_sqlite.hpp"
 #include <iostream>
 
 std::shared_ptr<AlertaService> AlertaServiceFactory::criarPadrao() {
@@ -7,6 +8,9 @@ std::shared_ptr<AlertaService> AlertaServiceFactory::criarPadrao() {
     
     service->definirEstrategiaNotificacao(notifStrategy);
     configurarObserversPadrao(service, notifStrategy);
+    
+    // Violação persistente: um alerta por hora, salvo se piorar
+    service->definirJanelaSupressao(std::chrono::hours(1));
 
     std::cout << "[FACTORY] AlertaService criado com configuração padrão" << std::endl;
     return service;
@@ -32,10 +36,21 @@ std::shared_ptr<AlertaService> AlertaServiceFactory::criarParaTeste() {
 std::shared_ptr<AlertaService> AlertaServiceFactory::criarParaProducao(
     const std::string& smtpServidor,
     int smtpPorta,
-    const std::string& emailRemetente) {
+    const std::string& emailRemetente,
+    const std::string& caminhoBancoAlertas) {
     
     auto service = std::make_shared<AlertaService>();
     
+    // Regras e alertas de execuções anteriores, antes de qualquer cadastro
+    if (!caminhoBancoAlertas.empty()) {
+        try {
+            service->definirPersistencia(
+                std::make_shared<PersistenciaAlertasSqlite>(caminhoBancoAlertas));
+        } catch (const std::exception& e) {
+            std::cerr << "[FACTORY] Persistência de alertas indisponível: " << e.what() << std::endl;
+        }
+    }
+    
     // Configura estratégia de email
     auto emailStrategy = std::make_shared<NotificacaoEmail>(
         smtpServidor, smtpPorta, emailRemetente);
@@ -51,6 +66,11 @@ std::shared_ptr<AlertaService> AlertaServiceFactory::criarParaProducao(
     service->anexarObserver(loggerObserver);
     service->anexarObserver(notifObserver);
 
+    // O envio SMTP pode levar até o timeout do curl: nenhum observer
+    // deve segurar a verificação das regras
+    service->definirNotificacaoAssincrona(true);
+    service->definirJanelaSupressao(std::chrono::hours(1));
+
     std::cout << "[FACTORY] AlertaService criado para produção com email" << std::endl;
     return service;
 }
@@ -29,6 +29,7 @@ public:
      * - Notificação: Console Log
      * - Observers: Painel, Logger e Notificação
      * - Estratégias: Todas as estratégias de análise padrão
+     * - Supressão: repetições da mesma regra em 1 hora (salvo escalada)
      */
     static std::shared_ptr<AlertaService> criarPadrao();
 
@@ -47,13 +48,18 @@ public:
      * 
      * Configuração:
      * - Notificação: Email (requer configuração SMTP)
-     * - Observers: Painel, Logger e Notificação Email
+     * - Observers: Painel, Logger e Notificação Email, entregues de forma assíncrona
+     * - Supressão: repetições da mesma regra em 1 hora (salvo escalada)
      * - Logging completo e persistência
+     * 
+     * @param caminhoBancoAlertas Banco SQLite de regras e alertas, carregado
+     *        na criação (vazio = sem persistência)
      */
     static std::shared_ptr<AlertaService> criarParaProducao(
         const std::string& smtpServidor,
         int smtpPorta,
-        const std::string& emailRemetente);
+        const std::string& emailRemetente,
+        const std::string& caminhoBancoAlertas = "");
 
     /**
      * @brief Cria um AlertaService com observers customizados
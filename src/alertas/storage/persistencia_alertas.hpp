@@ -0,0 +1,56 @@
+#ifndef PERSISTENCIA_ALERTAS_HPP
+#define PERSISTENCIA_ALERTAS_HPP
+
+#include "../domain/regra_alerta.hpp"
+#include "../domain/alerta_ativo.hpp"
+#include <cstddef>
+#include <ctime>
+#include <vector>
+
+/**
+ * @brief Interface Strategy para persistir regras e alertas do AlertaService
+ *
+ * As escritas podem ficar pendentes até confirmar(), que as grava de uma
+ * vez; o AlertaService confirma ao fim de cada operação. Erros são
+ * reportados com std::runtime_error, e as escritas de uma confirmação
+ * que falhou continuam pendentes para a próxima.
+ */
+class PersistenciaAlertas {
+public:
+    virtual ~PersistenciaAlertas() = default;
+
+    /**
+     * @brief Insere ou atualiza uma regra (chave: id)
+     */
+    virtual void salvarRegra(const RegraAlerta& regra) = 0;
+
+    /**
+     * @brief Insere ou atualiza um alerta (chave: id)
+     */
+    virtual void salvarAlerta(const AlertaAtivo& alerta) = 0;
+
+    /**
+     * @brief Remove os alertas disparados antes de `limite`
+     */
+    virtual void removerAlertasAnteriores(std::time_t limite) = 0;
+
+    /**
+     * @brief Grava as escritas pendentes
+     */
+    virtual void confirmar() = 0;
+
+    virtual std::vector<RegraAlerta> carregarRegras() = 0;
+
+    /**
+     * @brief Alertas ativos mais os `maxEncerrados` encerrados mais recentes
+     * @param maxEncerrados 0 = todos
+     */
+    virtual std::vector<AlertaAtivo> carregarAlertas(size_t maxEncerrados) = 0;
+
+    /**
+     * @brief Maior id de alerta já gravado, mesmo que removido depois (0 se nenhum)
+     */
+    virtual int maiorIdAlerta() = 0;
+};
+
+#endif // PERSISTENCIA_ALERTAS_HPP
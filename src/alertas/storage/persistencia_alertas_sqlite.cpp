@@ -0,0 +1,319 @@
+#include "persistencia_alertas_sqlite.hpp"
+#include "../../utils/metricas.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+std::string textoColuna(sqlite3_stmt* stmt, int coluna) {
+    const unsigned char* texto = sqlite3_column_text(stmt, coluna);
+    return texto ? reinterpret_cast<const char*>(texto) : "";
+}
+
+} // namespace
+
+PersistenciaAlertasSqlite::PersistenciaAlertasSqlite(const std::string& caminhoDb, size_t tamanhoLote,
+                                                     size_t maxPendentes)
+    : db(nullptr), dbPath(caminhoDb), tamanhoLote(tamanhoLote),
+      maxPendentes(std::max<size_t>(1, maxPendentes)), transacoes(0), falhas(0), descartadas(0),
+      stmtSalvarRegra(nullptr), stmtSalvarAlerta(nullptr), stmtRemoverAlertas(nullptr),
+      stmtMaiorIdAlerta(nullptr), removerAntesDe(0) {
+
+    int rc = sqlite3_open(dbPath.c_str(), &db);
+    if (rc != SQLITE_OK) {
+        std::string erro = "Erro ao abrir banco de alertas: ";
+        if (db) {
+            erro += sqlite3_errmsg(db);
+            sqlite3_close(db);
+        }
+        throw std::runtime_error(erro);
+    }
+
+    try {
+        // WAL + NORMAL: um fsync por checkpoint, não por transação
+        executarSQL("PRAGMA journal_mode=WAL;");
+        executarSQL("PRAGMA synchronous=NORMAL;");
+        criarTabelas();
+
+        stmtSalvarRegra = preparar(
+            "INSERT OR REPLACE INTO regras_alerta "
+            "(id, usuario_id, tipo_estrategia, valor_parametro, ativo, data_criacao) "
+            "VALUES (?, ?, ?, ?, ?, ?)");
+        stmtSalvarAlerta = preparar(
+            "INSERT OR REPLACE INTO alertas "
+            "(id, usuario_id, mensagem, data_disparo, status, severidade, valor_consumo, tipo_regra) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+        stmtRemoverAlertas = preparar("DELETE FROM alertas WHERE data_disparo < ?");
+        stmtMaiorIdAlerta = preparar(
+            "INSERT INTO metadados (chave, valor) VALUES ('maior_id_alerta', ?) "
+            "ON CONFLICT(chave) DO UPDATE SET valor = MAX(valor, excluded.valor)");
+    } catch (...) {
+        sqlite3_finalize(stmtSalvarRegra);
+        sqlite3_finalize(stmtSalvarAlerta);
+        sqlite3_finalize(stmtRemoverAlertas);
+        sqlite3_close(db);
+        throw;
+    }
+}
+
+PersistenciaAlertasSqlite::~PersistenciaAlertasSqlite() {
+    try {
+        confirmar();
+    } catch (const std::exception&) {
+        // Sem como reportar no destrutor; o que não foi gravado se perde
+    }
+    sqlite3_finalize(stmtSalvarRegra);
+    sqlite3_finalize(stmtSalvarAlerta);
+    sqlite3_finalize(stmtRemoverAlertas);
+    sqlite3_finalize(stmtMaiorIdAlerta);
+    sqlite3_close(db);
+}
+
+void PersistenciaAlertasSqlite::criarTabelas() {
+    executarSQL(R"(
+        CREATE TABLE IF NOT EXISTS regras_alerta (
+            id INTEGER PRIMARY KEY,
+            usuario_id INTEGER NOT NULL,
+            tipo_estrategia TEXT NOT NULL,
+            valor_parametro TEXT NOT NULL,
+            ativo INTEGER NOT NULL DEFAULT 1,
+            data_criacao INTEGER NOT NULL
+        );
+    )");
+
+    executarSQL(R"(
+        CREATE TABLE IF NOT EXISTS alertas (
+            id INTEGER PRIMARY KEY,
+            usuario_id INTEGER NOT NULL,
+            mensagem TEXT NOT NULL,
+            data_disparo INTEGER NOT NULL,
+            status INTEGER NOT NULL,
+            severidade INTEGER NOT NULL,
+            valor_consumo REAL NOT NULL,
+            tipo_regra TEXT NOT NULL
+        );
+    )");
+
+    // Contadores que sobrevivem à remoção das linhas (maior_id_alerta)
+    executarSQL(R"(
+        CREATE TABLE IF NOT EXISTS metadados (
+            chave TEXT PRIMARY KEY,
+            valor INTEGER NOT NULL
+        );
+    )");
+
+    // O carregamento lê os ativos e os encerrados mais recentes
+    executarSQL(R"(
+        CREATE INDEX IF NOT EXISTS idx_alertas_status_data ON alertas(status, data_disparo);
+        CREATE INDEX IF NOT EXISTS idx_alertas_data ON alertas(data_disparo);
+    )");
+}
+
+void PersistenciaAlertasSqlite::executarSQL(const char* sql) {
+    char* errMsg = nullptr;
+    int rc = sqlite3_exec(db, sql, nullptr, nullptr, &errMsg);
+
+    if (rc != SQLITE_OK) {
+        std::string erro = "Erro SQL: ";
+        if (errMsg) {
+            erro += errMsg;
+            sqlite3_free(errMsg);
+        }
+        throw std::runtime_error(erro);
+    }
+}
+
+sqlite3_stmt* PersistenciaAlertasSqlite::preparar(const char* sql) {
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(std::string("Erro ao preparar statement: ") + sqlite3_errmsg(db));
+    }
+    return stmt;
+}
+
+void PersistenciaAlertasSqlite::executarStatement(sqlite3_stmt* stmt) {
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string("Erro SQL: ") + sqlite3_errmsg(db));
+    }
+}
+
+// ==================== Escrita ====================
+
+void PersistenciaAlertasSqlite::salvarRegra(const RegraAlerta& regra) {
+    if (aceitarPendente()) {
+        regrasPendentes.push_back(regra);
+        confirmarSeLoteCheio();
+    }
+}
+
+void PersistenciaAlertasSqlite::salvarAlerta(const AlertaAtivo& alerta) {
+    if (aceitarPendente()) {
+        alertasPendentes.push_back(alerta);
+        confirmarSeLoteCheio();
+    }
+}
+
+bool PersistenciaAlertasSqlite::aceitarPendente() {
+    static ContadorMetrica& metricaDescartadas =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_persistencia_descartadas_total");
+
+    if (getPendentes() < maxPendentes) {
+        return true;
+    }
+    ++descartadas;
+    metricaDescartadas.incrementar();
+    return false;
+}
+
+void PersistenciaAlertasSqlite::removerAlertasAnteriores(std::time_t limite) {
+    if (limite > removerAntesDe) {
+        removerAntesDe = limite;
+    }
+}
+
+void PersistenciaAlertasSqlite::confirmarSeLoteCheio() {
+    if (getPendentes() < tamanhoLote) {
+        return;
+    }
+    try {
+        confirmar();
+    } catch (const std::exception&) {
+        // Continua pendente; o erro aparece na próxima confirmar() explícita
+    }
+}
+
+void PersistenciaAlertasSqlite::confirmar() {
+    if (regrasPendentes.empty() && alertasPendentes.empty() && removerAntesDe == 0) {
+        return;
+    }
+
+    static ContadorMetrica& metricaFalhas =
+        RegistroMetricas::getInstance().contador("ssmh_alertas_persistencia_falhas_total");
+
+    try {
+        executarSQL("BEGIN IMMEDIATE;");
+    } catch (...) {
+        ++falhas;
+        metricaFalhas.incrementar();
+        throw;
+    }
+    try {
+        for (const auto& regra : regrasPendentes) {
+            sqlite3_bind_int(stmtSalvarRegra, 1, regra.getId());
+            sqlite3_bind_int(stmtSalvarRegra, 2, regra.getUsuarioId());
+            sqlite3_bind_text(stmtSalvarRegra, 3, regra.getTipoEstrategia().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(stmtSalvarRegra, 4, regra.getValorParametro().c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmtSalvarRegra, 5, regra.isAtivo() ? 1 : 0);
+            sqlite3_bind_int64(stmtSalvarRegra, 6, static_cast<sqlite3_int64>(regra.getDataCriacao()));
+            executarStatement(stmtSalvarRegra);
+        }
+
+        for (const auto& alerta : alertasPendentes) {
+            std::string mensagem = alerta.getMensagem();
+            std::string tipoRegra = alerta.getTipoRegra();
+            sqlite3_bind_int(stmtSalvarAlerta, 1, alerta.getId());
+            sqlite3_bind_int(stmtSalvarAlerta, 2, alerta.getUsuarioId());
+            sqlite3_bind_text(stmtSalvarAlerta, 3, mensagem.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int64(stmtSalvarAlerta, 4, static_cast<sqlite3_int64>(alerta.getDataDisparo()));
+            sqlite3_bind_int(stmtSalvarAlerta, 5, alerta.getStatus());
+            sqlite3_bind_int(stmtSalvarAlerta, 6, alerta.getSeveridade());
+            sqlite3_bind_double(stmtSalvarAlerta, 7, alerta.getValorConsumo());
+            sqlite3_bind_text(stmtSalvarAlerta, 8, tipoRegra.c_str(), -1, SQLITE_STATIC);
+            executarStatement(stmtSalvarAlerta);
+        }
+
+        if (!alertasPendentes.empty()) {
+            auto maior = std::max_element(alertasPendentes.begin(), alertasPendentes.end(),
+                [](const AlertaAtivo& a, const AlertaAtivo& b) { return a.getId() < b.getId(); });
+            sqlite3_bind_int(stmtMaiorIdAlerta, 1, maior->getId());
+            executarStatement(stmtMaiorIdAlerta);
+        }
+
+        // Depois das inserções: alertas antigos gravados neste lote também saem
+        if (removerAntesDe > 0) {
+            sqlite3_bind_int64(stmtRemoverAlertas, 1, static_cast<sqlite3_int64>(removerAntesDe));
+            executarStatement(stmtRemoverAlertas);
+        }
+
+        executarSQL("COMMIT;");
+    } catch (...) {
+        // As escritas continuam pendentes para a próxima confirmação
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+        ++falhas;
+        metricaFalhas.incrementar();
+        throw;
+    }
+
+    regrasPendentes.clear();
+    alertasPendentes.clear();
+    removerAntesDe = 0;
+    ++transacoes;
+}
+
+// ==================== Carregamento ====================
+
+std::vector<RegraAlerta> PersistenciaAlertasSqlite::carregarRegras() {
+    confirmar();
+
+    sqlite3_stmt* stmt = preparar(
+        "SELECT id, usuario_id, tipo_estrategia, valor_parametro, ativo, data_criacao "
+        "FROM regras_alerta ORDER BY id");
+
+    std::vector<RegraAlerta> regras;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        RegraAlerta regra(sqlite3_column_int(stmt, 0), sqlite3_column_int(stmt, 1),
+                          textoColuna(stmt, 2), textoColuna(stmt, 3),
+                          sqlite3_column_int(stmt, 4) != 0);
+        regra.setDataCriacao(static_cast<time_t>(sqlite3_column_int64(stmt, 5)));
+        regras.push_back(std::move(regra));
+    }
+
+    sqlite3_finalize(stmt);
+    return regras;
+}
+
+std::vector<AlertaAtivo> PersistenciaAlertasSqlite::carregarAlertas(size_t maxEncerrados) {
+    confirmar();
+
+    sqlite3_stmt* stmt = preparar(
+        "SELECT id, usuario_id, mensagem, data_disparo, status, severidade, valor_consumo, tipo_regra "
+        "FROM alertas WHERE status = 0 "
+        "UNION ALL "
+        "SELECT * FROM (SELECT id, usuario_id, mensagem, data_disparo, status, severidade, "
+        "valor_consumo, tipo_regra FROM alertas WHERE status != 0 "
+        "ORDER BY data_disparo DESC, id DESC LIMIT ?)");
+    // LIMIT negativo: sem limite
+    sqlite3_bind_int64(stmt, 1, maxEncerrados == 0 ? -1 : static_cast<sqlite3_int64>(maxEncerrados));
+
+    std::vector<AlertaAtivo> alertas;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        AlertaAtivo alerta(sqlite3_column_int(stmt, 0), sqlite3_column_int(stmt, 1),
+                           textoColuna(stmt, 2), sqlite3_column_double(stmt, 6),
+                           textoColuna(stmt, 7),
+                           static_cast<AlertaAtivo::Severidade>(sqlite3_column_int(stmt, 5)));
+        alerta.setDataDisparo(static_cast<time_t>(sqlite3_column_int64(stmt, 3)));
+        alerta.setStatus(static_cast<AlertaAtivo::Status>(sqlite3_column_int(stmt, 4)));
+        alertas.push_back(std::move(alerta));
+    }
+
+    sqlite3_finalize(stmt);
+    return alertas;
+}
+
+int PersistenciaAlertasSqlite::maiorIdAlerta() {
+    confirmar();
+
+    // Bancos anteriores à tabela de metadados só têm MAX(id)
+    sqlite3_stmt* stmt = preparar(
+        "SELECT MAX(COALESCE((SELECT valor FROM metadados WHERE chave = 'maior_id_alerta'), 0), "
+        "COALESCE((SELECT MAX(id) FROM alertas), 0))");
+    int maiorId = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+        maiorId = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return maiorId;
+}
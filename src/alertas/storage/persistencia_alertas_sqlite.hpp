@@ -0,0 +1,91 @@
+#ifndef PERSISTENCIA_ALERTAS_SQLITE_HPP
+#define PERSISTENCIA_ALERTAS_SQLITE_HPP
+
+#include "persistencia_alertas.hpp"
+#include <sqlite3.h>
+#include <string>
+
+/**
+ * @brief PersistenciaAlertas em SQLite
+ *
+ * Tabelas `regras_alerta`, `alertas` e `metadados`. As escritas ficam num
+ * buffer e confirmar() as grava numa única transação, com statements
+ * preparados uma vez no construtor; o buffer também é gravado ao atingir
+ * `tamanhoLote` e na destruição. O banco usa WAL, então leituras de
+ * outros processos não bloqueiam a gravação.
+ *
+ * Com o banco inacessível as escritas se acumulam até `maxPendentes`;
+ * além disso as novas são descartadas. Falhas e descartes são contados
+ * (getFalhas, getDescartadas e as métricas ssmh_alertas_persistencia_*).
+ *
+ * O maior id de alerta gravado fica em `metadados`, e não só em MAX(id):
+ * ids de alertas removidos por removerAlertasAnteriores() não voltam.
+ */
+class PersistenciaAlertasSqlite : public PersistenciaAlertas {
+public:
+    explicit PersistenciaAlertasSqlite(const std::string& caminhoDb = "ssmh_alertas.db",
+                                       size_t tamanhoLote = 1000,
+                                       size_t maxPendentes = 100000);
+    ~PersistenciaAlertasSqlite() override;
+
+    // Impede cópia e movimentação
+    PersistenciaAlertasSqlite(const PersistenciaAlertasSqlite&) = delete;
+    PersistenciaAlertasSqlite& operator=(const PersistenciaAlertasSqlite&) = delete;
+
+    void salvarRegra(const RegraAlerta& regra) override;
+    void salvarAlerta(const AlertaAtivo& alerta) override;
+    void removerAlertasAnteriores(std::time_t limite) override;
+    void confirmar() override;
+
+    std::vector<RegraAlerta> carregarRegras() override;
+    std::vector<AlertaAtivo> carregarAlertas(size_t maxEncerrados) override;
+    int maiorIdAlerta() override;
+
+    /**
+     * @brief Escritas aguardando confirmar()
+     */
+    size_t getPendentes() const { return regrasPendentes.size() + alertasPendentes.size(); }
+
+    /**
+     * @brief Transações gravadas desde a abertura
+     */
+    size_t getTransacoes() const { return transacoes; }
+
+    /**
+     * @brief Confirmações que falharam (as escritas continuaram pendentes)
+     */
+    size_t getFalhas() const { return falhas; }
+
+    /**
+     * @brief Escritas descartadas por já haver `maxPendentes` aguardando
+     */
+    size_t getDescartadas() const { return descartadas; }
+
+private:
+    void criarTabelas();
+    void executarSQL(const char* sql);
+    sqlite3_stmt* preparar(const char* sql);
+    void executarStatement(sqlite3_stmt* stmt);
+    void confirmarSeLoteCheio();
+    bool aceitarPendente();
+
+    sqlite3* db;
+    std::string dbPath;
+    size_t tamanhoLote;
+    size_t maxPendentes;
+    size_t transacoes;
+    size_t falhas;
+    size_t descartadas;
+
+    // Preparados uma vez, reutilizados com sqlite3_reset
+    sqlite3_stmt* stmtSalvarRegra;
+    sqlite3_stmt* stmtSalvarAlerta;
+    sqlite3_stmt* stmtRemoverAlertas;
+    sqlite3_stmt* stmtMaiorIdAlerta;
+
+    std::vector<RegraAlerta> regrasPendentes;
+    std::vector<AlertaAtivo> alertasPendentes;
+    std::time_t removerAntesDe;  // 0 = nenhuma remoção pendente
+};
+
+#endif // PERSISTENCIA_ALERTAS_SQLITE_HPP
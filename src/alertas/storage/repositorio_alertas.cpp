@@ -0,0 +1,127 @@
+#include "repositorio_alertas.hpp"
+
+RepositorioAlertas::RepositorioAlertas(size_t maxEncerrados)
+    : maxEncerrados_(maxEncerrados) {}
+
+void RepositorioAlertas::inserir(const AlertaAtivo& alerta) {
+    auto existente = alertas_.find(alerta.getId());
+    if (existente != alertas_.end()) {
+        remover(existente);
+    }
+
+    alertas_.emplace(alerta.getId(), alerta);
+    Chave chave = chaveDe(alerta);
+    porUsuario_[alerta.getUsuarioId()].insert(chave);
+    porStatus_[alerta.getStatus()].insert(chave);
+
+    if (alerta.getStatus() != AlertaAtivo::ATIVO) {
+        aplicarLimiteEncerrados();
+    }
+}
+
+const AlertaAtivo* RepositorioAlertas::buscar(int id) const {
+    auto it = alertas_.find(id);
+    return it == alertas_.end() ? nullptr : &it->second;
+}
+
+bool RepositorioAlertas::alterarStatus(int id, AlertaAtivo::Status status) {
+    auto it = alertas_.find(id);
+    if (it == alertas_.end()) {
+        return false;
+    }
+
+    AlertaAtivo& alerta = it->second;
+    if (alerta.getStatus() == status) {
+        return true;
+    }
+
+    Chave chave = chaveDe(alerta);
+    porStatus_[alerta.getStatus()].erase(chave);
+    porStatus_[status].insert(chave);
+    alerta.setStatus(status);
+
+    if (status != AlertaAtivo::ATIVO) {
+        aplicarLimiteEncerrados();
+    }
+    return true;
+}
+
+std::vector<AlertaAtivo> RepositorioAlertas::listarPorStatus(AlertaAtivo::Status status) const {
+    return copiar(porStatus_[status]);
+}
+
+std::vector<AlertaAtivo> RepositorioAlertas::listarPorUsuario(int usuarioId) const {
+    auto it = porUsuario_.find(usuarioId);
+    if (it == porUsuario_.end()) {
+        return {};
+    }
+    return copiar(it->second);
+}
+
+size_t RepositorioAlertas::removerAnteriores(std::time_t limite) {
+    size_t removidos = 0;
+    for (auto& indice : porStatus_) {
+        // Cada índice está em ordem de disparo: para no primeiro recente
+        while (!indice.empty() && indice.begin()->first < limite) {
+            remover(alertas_.find(indice.begin()->second));
+            ++removidos;
+        }
+    }
+    return removidos;
+}
+
+void RepositorioAlertas::setMaxEncerrados(size_t maximo) {
+    maxEncerrados_ = maximo;
+    aplicarLimiteEncerrados();
+}
+
+size_t RepositorioAlertas::contarPorStatus(AlertaAtivo::Status status) const {
+    return porStatus_[status].size();
+}
+
+void RepositorioAlertas::limpar() {
+    alertas_.clear();
+    porUsuario_.clear();
+    for (auto& indice : porStatus_) {
+        indice.clear();
+    }
+}
+
+void RepositorioAlertas::remover(std::unordered_map<int, AlertaAtivo>::iterator it) {
+    const AlertaAtivo& alerta = it->second;
+    Chave chave = chaveDe(alerta);
+
+    porStatus_[alerta.getStatus()].erase(chave);
+    auto itUsuario = porUsuario_.find(alerta.getUsuarioId());
+    if (itUsuario != porUsuario_.end()) {
+        itUsuario->second.erase(chave);
+        if (itUsuario->second.empty()) {
+            porUsuario_.erase(itUsuario);
+        }
+    }
+    alertas_.erase(it);
+}
+
+void RepositorioAlertas::aplicarLimiteEncerrados() {
+    if (maxEncerrados_ == 0) {
+        return;
+    }
+
+    auto& resolvidos = porStatus_[AlertaAtivo::RESOLVIDO];
+    auto& ignorados = porStatus_[AlertaAtivo::IGNORADO];
+    while (resolvidos.size() + ignorados.size() > maxEncerrados_) {
+        bool doResolvido = ignorados.empty() ||
+                           (!resolvidos.empty() && *resolvidos.begin() < *ignorados.begin());
+        const Chave& maisAntigo = doResolvido ? *resolvidos.begin() : *ignorados.begin();
+        remover(alertas_.find(maisAntigo.second));
+    }
+}
+
+std::vector<AlertaAtivo> RepositorioAlertas::copiar(const std::set<Chave>& chaves) const {
+    std::vector<AlertaAtivo> resultado;
+    resultado.reserve(chaves.size());
+    for (const auto& chave : chaves) {
+        resultado.push_back(alertas_.at(chave.second));
+    }
+    return resultado;
+}
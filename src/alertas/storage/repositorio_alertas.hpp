@@ -0,0 +1,91 @@
+#ifndef REPOSITORIO_ALERTAS_HPP
+#define REPOSITORIO_ALERTAS_HPP
+
+#include "../domain/alerta_ativo.hpp"
+#include <cstddef>
+#include <ctime>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Alertas disparados, indexados por id, usuário e status
+ *
+ * Busca e resolução por id são O(1); listar os alertas ativos ou os de
+ * um usuário custa O(k) no tamanho do resultado, não do histórico. Os
+ * índices por usuário e status guardam (data de disparo, id), então as
+ * listagens saem em ordem de disparo.
+ *
+ * Alertas já encerrados (RESOLVIDO ou IGNORADO) além de `maxEncerrados`
+ * são descartados automaticamente, os mais antigos primeiro; alertas
+ * ativos nunca são descartados por esse limite.
+ *
+ * Não é thread-safe: o AlertaService serializa o acesso.
+ */
+class RepositorioAlertas {
+public:
+    explicit RepositorioAlertas(size_t maxEncerrados = 100000);
+
+    /**
+     * @brief Armazena um alerta (o id já vem atribuído); substitui o de mesmo id
+     */
+    void inserir(const AlertaAtivo& alerta);
+
+    /**
+     * @brief Alerta pelo id, ou nullptr
+     */
+    const AlertaAtivo* buscar(int id) const;
+
+    /**
+     * @brief Muda o status de um alerta, atualizando os índices
+     * @return false se o id não existir
+     */
+    bool alterarStatus(int id, AlertaAtivo::Status status);
+
+    std::vector<AlertaAtivo> listarPorStatus(AlertaAtivo::Status status) const;
+    std::vector<AlertaAtivo> listarPorUsuario(int usuarioId) const;
+
+    /**
+     * @brief Remove os alertas disparados antes de `limite`, de qualquer status
+     * @return Quantidade removida
+     */
+    size_t removerAnteriores(std::time_t limite);
+
+    /**
+     * @brief Limite de alertas encerrados mantidos (0 = sem limite)
+     */
+    void setMaxEncerrados(size_t maximo);
+    size_t getMaxEncerrados() const { return maxEncerrados_; }
+
+    size_t tamanho() const { return alertas_.size(); }
+    size_t contarPorStatus(AlertaAtivo::Status status) const;
+
+    void limpar();
+
+private:
+    // (data de disparo, id): ordena os índices pelo momento do disparo
+    using Chave = std::pair<std::time_t, int>;
+
+    static constexpr size_t NUM_STATUS = 3;
+
+    static Chave chaveDe(const AlertaAtivo& alerta) {
+        return {alerta.getDataDisparo(), alerta.getId()};
+    }
+
+    void remover(std::unordered_map<int, AlertaAtivo>::iterator it);
+
+    /**
+     * @brief Descarta encerrados (os mais antigos entre RESOLVIDO e IGNORADO) até o limite
+     */
+    void aplicarLimiteEncerrados();
+
+    std::vector<AlertaAtivo> copiar(const std::set<Chave>& chaves) const;
+
+    std::unordered_map<int, AlertaAtivo> alertas_;
+    std::unordered_map<int, std::set<Chave>> porUsuario_;
+    std::set<Chave> porStatus_[NUM_STATUS];
+    size_t maxEncerrados_;
+};
+
+#endif // REPOSITORIO_ALERTAS_HPP
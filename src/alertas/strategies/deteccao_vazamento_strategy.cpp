@@ -1,49 +1,140 @@
 #include "deteccao_vazamento_strategy.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
-bool DeteccaoVazamentoStrategy::analisar(double consumoAtual, const std::string& valorParametro) const {
-    int periodoHoras = extrairPeriodoHoras(valorParametro);
-    double fluxoMinimo = calcularFluxoMinimo();
-    
-    // Detecta vazamento se há consumo constante mínimo por período prolongado
-    // Para simplificar, considera que consumoAtual é o consumo por hora
-    double consumoPorHora = consumoAtual / 24.0;
-    
-    // Se consumo por hora é baixo mas constante (indicativo de vazamento)
-    return (consumoPorHora >= fluxoMinimo && consumoPorHora <= fluxoMinimo * 3);
+DeteccaoVazamentoStrategy::DeteccaoVazamentoStrategy(int intervaloMaximoSeg,
+                                                     int horaInicioNoite, int horaFimNoite)
+    : intervaloMaximoSeg(intervaloMaximoSeg),
+      horaInicioNoite(horaInicioNoite),
+      horaFimNoite(horaFimNoite) {}
+
+ParametrosRegra DeteccaoVazamentoStrategy::compilarParametros(const std::string& valorParametro) const {
+    ParametrosRegra parametros;
+    parametros.periodoHoras = extrairPeriodoHoras(valorParametro);
+    parametros.referenciaSeveridade = parametros.periodoHoras;
+    return parametros;
+}
+
+bool DeteccaoVazamentoStrategy::analisar(double /*consumoAtual*/, const ParametrosRegra& /*parametros*/) const {
+    // Vazamento é detectado pela série de leituras (analisarLeitura)
+    return false;
 }
 
 std::string DeteccaoVazamentoStrategy::getNome() const {
     return "DETECCAO_VAZAMENTO";
 }
 
-std::string DeteccaoVazamentoStrategy::gerarMensagem(double consumoAtual, const std::string& valorParametro) const {
-    int periodoHoras = extrairPeriodoHoras(valorParametro);
-    double consumoPorHora = consumoAtual / 24.0;
-    
+std::string DeteccaoVazamentoStrategy::gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const {
     std::stringstream ss;
     ss << std::fixed << std::setprecision(2);
-    ss << "Possível vazamento detectado: consumo constante de " 
-       << consumoPorHora << "L/h por mais de " << periodoHoras << " horas";
+    ss << "Possível vazamento detectado: fluxo contínuo por mais de " 
+       << parametros.periodoHoras << " horas (" << consumoAtual << "L no período)";
     return ss.str();
 }
 
+void DeteccaoVazamentoStrategy::registrarLeitura(const std::string& idSha, double valorLitros,
+                                                 std::time_t dataHora) {
+    std::lock_guard<std::mutex> lock(mutexEstados);
+    EstadoFluxo& estado = estadosPorHidrometro[idSha];
+    
+    if (!estado.temLeitura) {
+        estado.ultimoValor = valorLitros;
+        estado.ultimaLeitura = dataHora;
+        estado.temLeitura = true;
+        return;
+    }
+    
+    // Leituras repetidas ou fora de ordem não formam intervalo
+    if (dataHora <= estado.ultimaLeitura) {
+        return;
+    }
+    
+    double litros = valorLitros - estado.ultimoValor;
+    long segundos = static_cast<long>(dataHora - estado.ultimaLeitura);
+    std::time_t inicioIntervalo = estado.ultimaLeitura;
+    estado.ultimoValor = valorLitros;
+    estado.ultimaLeitura = dataHora;
+    
+    // Fluxo parou (ou o hidrômetro foi trocado), ou o intervalo é longo
+    // demais para afirmar que não parou: recomeça a contagem
+    if (litros <= 0 || segundos > intervaloMaximoSeg) {
+        estado = EstadoFluxo();
+        estado.temLeitura = true;
+        estado.ultimoValor = valorLitros;
+        estado.ultimaLeitura = dataHora;
+        return;
+    }
+    
+    double vazao = litros * 3600.0 / static_cast<double>(segundos);
+    if (estado.inicioFluxo == 0) {
+        estado.inicioFluxo = inicioIntervalo;
+        estado.fluxoMinimo = vazao;
+    }
+    estado.litrosNoFluxo += litros;
+    estado.fluxoMinimo = std::min(estado.fluxoMinimo, vazao);
+    
+    if (ehNoturno(inicioIntervalo + segundos / 2)) {
+        estado.fluxoMinimoNoturno = estado.fluxoMinimoNoturno < 0
+            ? vazao : std::min(estado.fluxoMinimoNoturno, vazao);
+    }
+}
+
+bool DeteccaoVazamentoStrategy::analisarLeitura(const std::string& idSha,
+                                                const ParametrosRegra& parametros,
+                                                double& consumo, std::string& mensagem) {
+    std::lock_guard<std::mutex> lock(mutexEstados);
+    auto it = estadosPorHidrometro.find(idSha);
+    if (it == estadosPorHidrometro.end() || it->second.inicioFluxo == 0) {
+        return false;
+    }
+    
+    EstadoFluxo& estado = it->second;
+    long duracao = static_cast<long>(estado.ultimaLeitura - estado.inicioFluxo);
+    
+    // Um alerta por regra a cada fluxo contínuo
+    if (duracao < parametros.periodoHoras * 3600L ||
+        parametros.periodoHoras <= estado.periodoAlertadoHoras) {
+        return false;
+    }
+    estado.periodoAlertadoHoras = parametros.periodoHoras;
+    consumo = estado.litrosNoFluxo;
+    
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Possível vazamento no hidrômetro " << idSha << ": fluxo contínuo há " 
+       << duracao / 3600 << " horas (regra: " << parametros.periodoHoras << "h), vazão mínima ";
+    if (estado.fluxoMinimoNoturno >= 0) {
+        ss << "noturna de " << estado.fluxoMinimoNoturno;
+    } else {
+        ss << "de " << estado.fluxoMinimo;
+    }
+    ss << "L/h, " << estado.litrosNoFluxo << "L no período";
+    mensagem = ss.str();
+    return true;
+}
+
+long DeteccaoVazamentoStrategy::duracaoFluxoContinuo(const std::string& idSha) const {
+    std::lock_guard<std::mutex> lock(mutexEstados);
+    auto it = estadosPorHidrometro.find(idSha);
+    if (it == estadosPorHidrometro.end() || it->second.inicioFluxo == 0) {
+        return 0;
+    }
+    return static_cast<long>(it->second.ultimaLeitura - it->second.inicioFluxo);
+}
+
 int DeteccaoVazamentoStrategy::extrairPeriodoHoras(const std::string& valorParametro) const {
-    try {
-        // Remove sufixo "h" se presente
-        std::string valor = valorParametro;
-        size_t pos = valor.find('h');
-        if (pos != std::string::npos) {
-            valor = valor.substr(0, pos);
-        }
-        return std::stoi(valor);
-    } catch (...) {
-        return 24; // Valor padrão: 24 horas
-    }
-}
-
-double DeteccaoVazamentoStrategy::calcularFluxoMinimo() const {
-    // Fluxo mínimo considerado como vazamento: 2L/hora
-    return 2.0;
+    // Aceita "24" ou "24h"
+    double horas = converterParametroNumerico(valorParametro, 'h');
+    if (horas < 1 || horas != static_cast<int>(horas)) {
+        throw std::invalid_argument("período deve ser um número inteiro de horas >= 1: '" +
+                                    valorParametro + "'");
+    }
+    return static_cast<int>(horas);
+}
+
+bool DeteccaoVazamentoStrategy::ehNoturno(std::time_t instante) const {
+    std::tm local;
+    localtime_r(&instante, &local);
+    return local.tm_hour >= horaInicioNoite && local.tm_hour < horaFimNoite;
 }
@@ -2,6 +2,8 @@
 #define DETECCAO_VAZAMENTO_STRATEGY_HPP
 
 #include "estrategia_analise_consumo.hpp"
+#include <mutex>
+#include <unordered_map>
 
 /**
  * @brief Estratégia que detecta possíveis vazamentos
@@ -12,16 +14,65 @@
  * 
  * Exemplo: Se detecta consumo de 5L/h constante por 24h seguidas,
  * provavelmente há um vazamento.
+ * 
+ * A detecção é feita sobre a sequência de leituras de cada hidrômetro
+ * (registrarLeitura), com estado O(1) por hidrômetro: desde quando o
+ * fluxo não para, quanto passou nesse intervalo e a menor vazão vista
+ * (em especial de madrugada). Qualquer intervalo sem consumo, ou sem
+ * leituras por mais de `intervaloMaximoSeg`, reinicia a contagem. O total
+ * diário sozinho não mostra se o fluxo parou, por isso a estratégia não
+ * avalia consumo agregado (avaliaConsumoAgregado() == false): regras deste
+ * tipo só disparam pelas leituras de hidrômetros vinculados ao usuário.
  */
 class DeteccaoVazamentoStrategy : public EstrategiaAnaliseConsumo {
 public:
-    bool analisar(double consumoAtual, const std::string& valorParametro) const override;
+    /**
+     * @param intervaloMaximoSeg Maior intervalo entre leituras em que o fluxo ainda é contínuo
+     * @param horaInicioNoite Início (inclusive) do período noturno, hora local
+     * @param horaFimNoite Fim (exclusive) do período noturno, hora local
+     */
+    explicit DeteccaoVazamentoStrategy(int intervaloMaximoSeg = 2 * 3600,
+                                       int horaInicioNoite = 0, int horaFimNoite = 6);
+
+    ParametrosRegra compilarParametros(const std::string& valorParametro) const override;
+    bool analisar(double consumoAtual, const ParametrosRegra& parametros) const override;
     std::string getNome() const override;
-    std::string gerarMensagem(double consumoAtual, const std::string& valorParametro) const override;
+    std::string gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const override;
+    bool avaliaConsumoAgregado() const override { return false; }
+
+    void registrarLeitura(const std::string& idSha, double valorLitros, std::time_t dataHora) override;
+    bool analisarLeitura(const std::string& idSha, const ParametrosRegra& parametros,
+                         double& consumo, std::string& mensagem) override;
+
+    /**
+     * @brief Há quantos segundos o hidrômetro não para de registrar fluxo (0 = parado)
+     */
+    long duracaoFluxoContinuo(const std::string& idSha) const;
 
 private:
+    /**
+     * @brief Estado do fluxo contínuo de um hidrômetro
+     */
+    struct EstadoFluxo {
+        double ultimoValor = 0.0;
+        std::time_t ultimaLeitura = 0;
+        bool temLeitura = false;
+        std::time_t inicioFluxo = 0;        // 0 = sem fluxo contínuo em andamento
+        double litrosNoFluxo = 0.0;
+        double fluxoMinimo = 0.0;           // L/h
+        double fluxoMinimoNoturno = -1.0;   // L/h; negativo enquanto não houver intervalo noturno
+        int periodoAlertadoHoras = 0;       // maior período já alertado neste fluxo
+    };
+
     int extrairPeriodoHoras(const std::string& valorParametro) const;
-    double calcularFluxoMinimo() const;
+    bool ehNoturno(std::time_t instante) const;
+    
+    int intervaloMaximoSeg;
+    int horaInicioNoite;
+    int horaFimNoite;
+
+    mutable std::mutex mutexEstados;
+    std::unordered_map<std::string, EstadoFluxo> estadosPorHidrometro;
 };
 
 #endif // DETECCAO_VAZAMENTO_STRATEGY_HPP
@@ -1,6 +1,8 @@
 #ifndef ESTRATEGIA_ANALISE_CONSUMO_HPP
 #define ESTRATEGIA_ANALISE_CONSUMO_HPP
 
+#include "../domain/parametros_regra.hpp"
+#include <ctime>
 #include <string>
 
 /**
@@ -16,14 +18,25 @@ class EstrategiaAnaliseConsumo {
 public:
     virtual ~EstrategiaAnaliseConsumo() = default;
 
+    /**
+     * @brief Valida e converte o parâmetro textual de uma regra
+     * 
+     * Chamado uma única vez, quando a regra é salva; o resultado acompanha
+     * a regra e é entregue a analisar() e gerarMensagem().
+     * 
+     * @param valorParametro Parâmetro configurável da regra (ex: "70", "24h")
+     * @throws std::invalid_argument se o parâmetro não for válido para a estratégia
+     */
+    virtual ParametrosRegra compilarParametros(const std::string& valorParametro) const = 0;
+
     /**
      * @brief Analisa o consumo atual e determina se há violação da regra
      * 
      * @param consumoAtual Consumo atual em litros
-     * @param valorParametro Parâmetro configurável da regra (ex: limite, período)
+     * @param parametros Parâmetros da regra já compilados
      * @return true se houver violação da regra, false caso contrário
      */
-    virtual bool analisar(double consumoAtual, const std::string& valorParametro) const = 0;
+    virtual bool analisar(double consumoAtual, const ParametrosRegra& parametros) const = 0;
 
     /**
      * @brief Retorna o nome da estratégia
@@ -33,7 +46,66 @@ public:
     /**
      * @brief Gera mensagem descritiva da análise
      */
-    virtual std::string gerarMensagem(double consumoAtual, const std::string& valorParametro) const = 0;
+    virtual std::string gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const = 0;
+
+    /**
+     * @brief Versão de analisar() que conhece o usuário avaliado
+     * 
+     * Estratégias com histórico por usuário (ex: média móvel) sobrescrevem;
+     * as demais usam apenas o consumo atual.
+     */
+    virtual bool analisar(int /*usuarioId*/, double consumoAtual,
+                          const ParametrosRegra& parametros) const {
+        return analisar(consumoAtual, parametros);
+    }
+
+    /**
+     * @brief Versão de gerarMensagem() que conhece o usuário avaliado
+     */
+    virtual std::string gerarMensagem(int /*usuarioId*/, double consumoAtual,
+                                      const ParametrosRegra& parametros) const {
+        return gerarMensagem(consumoAtual, parametros);
+    }
+
+    /**
+     * @brief Indica se a estratégia avalia o consumo agregado (analisar)
+     * 
+     * Estratégias que só detectam violações na série de leituras de um
+     * hidrômetro (analisarLeitura) devolvem false: o AlertaService não as
+     * avalia em verificarRegras(), verificarRegrasEmLote() nem na
+     * verificação automática, só em processarLeitura().
+     */
+    virtual bool avaliaConsumoAgregado() const { return true; }
+
+    /**
+     * @brief Recebe o consumo de uma verificação já avaliada
+     * 
+     * Chamado pelo AlertaService depois de avaliar as regras do usuário,
+     * uma vez por estratégia, para que estratégias com histórico o
+     * alimentem. O padrão não guarda nada.
+     */
+    virtual void registrarConsumo(int /*usuarioId*/, double /*consumo*/) {}
+
+    /**
+     * @brief Recebe uma leitura bruta (valor acumulado do hidrômetro)
+     * 
+     * Chamado pelo AlertaService a cada leitura de um hidrômetro vinculado,
+     * uma vez por estratégia, antes de analisarLeitura(). O padrão ignora.
+     */
+    virtual void registrarLeitura(const std::string& /*idSha*/, double /*valorLitros*/,
+                                  std::time_t /*dataHora*/) {}
+
+    /**
+     * @brief Analisa a série de leituras de um hidrômetro contra a regra
+     * 
+     * @param consumo Saída: consumo (L) que caracteriza a violação
+     * @param mensagem Saída: descrição da violação
+     * @return true se a regra foi violada nesta leitura
+     */
+    virtual bool analisarLeitura(const std::string& /*idSha*/, const ParametrosRegra& /*parametros*/,
+                                 double& /*consumo*/, std::string& /*mensagem*/) {
+        return false;
+    }
 };
 
 #endif // ESTRATEGIA_ANALISE_CONSUMO_HPP
@@ -0,0 +1,464 @@
+#include "expressao_regra.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const char* const NOMES_VARIAVEIS[ExpressaoRegra::NUM_VARIAVEIS] = {
+    "consumo", "parametro", "vazao", "vazao_minima", "vazao_noturna",
+    "horas_fluxo", "litros_fluxo", "hora", "dia_semana", "dia_util", "noite"
+};
+
+bool caractereIdentificador(char c) {
+    // Bytes >= 0x80 aceitam identificadores em UTF-8 ("não")
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+} // namespace
+
+/**
+ * @brief Analisador descendente recursivo que emite o bytecode diretamente
+ *
+ * Precedência, da menor para a maior: ou, e, nao, comparação, + -, * /,
+ * menos unário. Comparações não se encadeiam (`a < b < c` é erro).
+ */
+class ExpressaoRegra::Compilador {
+public:
+    Compilador(const std::string& texto, ExpressaoRegra& destino)
+        : texto_(texto), destino_(destino) {}
+
+    void compilar() {
+        avancar();
+        ou();
+        if (token_ != Token::FIM) {
+            erro("símbolo inesperado '" + lexema_ + "'");
+        }
+        if (profundidadeMaxima_ > MAX_PILHA) {
+            erro("expressão aninhada demais");
+        }
+    }
+
+private:
+    enum class Token {
+        FIM, NUMERO, IDENTIFICADOR, ABRE, FECHA,
+        MAIS, MENOS, VEZES, DIVIDIDO,
+        MAIOR, MAIOR_IGUAL, MENOR, MENOR_IGUAL, IGUAL, DIFERENTE,
+        E, OU, NAO
+    };
+
+    // ==================== Análise léxica ====================
+
+    void avancar() {
+        while (posicao_ < texto_.size() && std::isspace(static_cast<unsigned char>(texto_[posicao_]))) {
+            ++posicao_;
+        }
+        inicioToken_ = posicao_;
+        if (posicao_ >= texto_.size()) {
+            token_ = Token::FIM;
+            lexema_ = "fim da expressão";
+            return;
+        }
+
+        const char c = texto_[posicao_];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* inicio = texto_.c_str() + posicao_;
+            char* fim = nullptr;
+            errno = 0;
+            numero_ = std::strtod(inicio, &fim);
+            if (fim == inicio || errno == ERANGE || !std::isfinite(numero_)) {
+                erro("número inválido");
+            }
+            posicao_ += static_cast<size_t>(fim - inicio);
+            definir(Token::NUMERO);
+            return;
+        }
+        if (caractereIdentificador(c)) {
+            while (posicao_ < texto_.size() && caractereIdentificador(texto_[posicao_])) {
+                ++posicao_;
+            }
+            definir(Token::IDENTIFICADOR);
+            if (lexema_ == "e") token_ = Token::E;
+            else if (lexema_ == "ou") token_ = Token::OU;
+            else if (lexema_ == "nao" || lexema_ == "não") token_ = Token::NAO;
+            return;
+        }
+
+        auto seguinte = [&](char esperado) {
+            return posicao_ + 1 < texto_.size() && texto_[posicao_ + 1] == esperado;
+        };
+        Token simbolo;
+        size_t tamanho = 1;
+        switch (c) {
+            case '(': simbolo = Token::ABRE; break;
+            case ')': simbolo = Token::FECHA; break;
+            case '+': simbolo = Token::MAIS; break;
+            case '-': simbolo = Token::MENOS; break;
+            case '*': simbolo = Token::VEZES; break;
+            case '/': simbolo = Token::DIVIDIDO; break;
+            case '>': simbolo = seguinte('=') ? (tamanho = 2, Token::MAIOR_IGUAL) : Token::MAIOR; break;
+            case '<': simbolo = seguinte('=') ? (tamanho = 2, Token::MENOR_IGUAL) : Token::MENOR; break;
+            case '=':
+                if (!seguinte('=')) erro("use '==' para igualdade");
+                simbolo = Token::IGUAL; tamanho = 2; break;
+            case '!': simbolo = seguinte('=') ? (tamanho = 2, Token::DIFERENTE) : Token::NAO; break;
+            case '&':
+                if (!seguinte('&')) erro("use '&&' ou 'e'");
+                simbolo = Token::E; tamanho = 2; break;
+            case '|':
+                if (!seguinte('|')) erro("use '||' ou 'ou'");
+                simbolo = Token::OU; tamanho = 2; break;
+            default:
+                erro(std::string("caractere inválido '") + c + "'");
+        }
+        posicao_ += tamanho;
+        definir(simbolo);
+    }
+
+    void definir(Token token) {
+        token_ = token;
+        lexema_ = texto_.substr(inicioToken_, posicao_ - inicioToken_);
+    }
+
+    [[noreturn]] void erro(const std::string& motivo) const {
+        throw std::invalid_argument("expressão inválida (posição " + std::to_string(inicioToken_ + 1) +
+                                    "): " + motivo + " em '" + texto_ + "'");
+    }
+
+    // ==================== Análise sintática ====================
+
+    void ou() {
+        e();
+        while (token_ == Token::OU) {
+            avancar();
+            size_t salto = emitirSalto(Op::SE_VERDADEIRO_SALTAR);
+            e();
+            emitir(Op::PARA_BOOLEANO);
+            corrigirSalto(salto);
+        }
+    }
+
+    void e() {
+        nao();
+        while (token_ == Token::E) {
+            avancar();
+            size_t salto = emitirSalto(Op::SE_FALSO_SALTAR);
+            nao();
+            emitir(Op::PARA_BOOLEANO);
+            corrigirSalto(salto);
+        }
+    }
+
+    void nao() {
+        if (token_ == Token::NAO) {
+            aninhar();
+            avancar();
+            nao();
+            emitir(Op::NAO);
+            --aninhamento_;
+            return;
+        }
+        comparacao();
+    }
+
+    void comparacao() {
+        soma();
+        Op op;
+        switch (token_) {
+            case Token::MAIOR: op = Op::MAIOR; break;
+            case Token::MAIOR_IGUAL: op = Op::MAIOR_IGUAL; break;
+            case Token::MENOR: op = Op::MENOR; break;
+            case Token::MENOR_IGUAL: op = Op::MENOR_IGUAL; break;
+            case Token::IGUAL: op = Op::IGUAL; break;
+            case Token::DIFERENTE: op = Op::DIFERENTE; break;
+            default: return;
+        }
+        avancar();
+        soma();
+        emitir(op);
+        switch (token_) {
+            case Token::MAIOR: case Token::MAIOR_IGUAL: case Token::MENOR:
+            case Token::MENOR_IGUAL: case Token::IGUAL: case Token::DIFERENTE:
+                erro("comparações não podem ser encadeadas; use 'e'");
+            default:
+                break;
+        }
+    }
+
+    void soma() {
+        produto();
+        while (token_ == Token::MAIS || token_ == Token::MENOS) {
+            Op op = token_ == Token::MAIS ? Op::SOMA : Op::SUBTRACAO;
+            avancar();
+            produto();
+            emitir(op);
+        }
+    }
+
+    void produto() {
+        unario();
+        while (token_ == Token::VEZES || token_ == Token::DIVIDIDO) {
+            Op op = token_ == Token::VEZES ? Op::MULTIPLICACAO : Op::DIVISAO;
+            avancar();
+            unario();
+            emitir(op);
+        }
+    }
+
+    void unario() {
+        if (token_ == Token::MENOS) {
+            aninhar();
+            avancar();
+            unario();
+            emitir(Op::NEGACAO);
+            --aninhamento_;
+            return;
+        }
+        primario();
+    }
+
+    void primario() {
+        switch (token_) {
+            case Token::NUMERO:
+                emitirConstante(numero_);
+                avancar();
+                return;
+            case Token::IDENTIFICADOR:
+                identificador();
+                avancar();
+                return;
+            case Token::ABRE:
+                aninhar();
+                avancar();
+                ou();
+                if (token_ != Token::FECHA) {
+                    erro("esperado ')' e encontrado '" + lexema_ + "'");
+                }
+                avancar();
+                --aninhamento_;
+                return;
+            default:
+                erro("esperado número, variável ou '(' e encontrado '" + lexema_ + "'");
+        }
+    }
+
+    void identificador() {
+        if (lexema_ == "verdadeiro") {
+            emitirConstante(1.0);
+            return;
+        }
+        if (lexema_ == "falso") {
+            emitirConstante(0.0);
+            return;
+        }
+        for (uint8_t v = 0; v < NUM_VARIAVEIS; ++v) {
+            if (lexema_ == NOMES_VARIAVEIS[v]) {
+                destino_.codigo_.push_back({Op::VARIAVEL, v, 0, 0.0});
+                destino_.variaveisUsadas_ |= 1u << v;
+                empilhar();
+                return;
+            }
+        }
+        erro("variável desconhecida '" + lexema_ + "'");
+    }
+
+    // Antes de descer mais um nível; a recursão usa a pilha de chamadas
+    void aninhar() {
+        if (++aninhamento_ > MAX_ANINHAMENTO) {
+            erro("expressão aninhada demais");
+        }
+    }
+
+    // ==================== Geração de código ====================
+
+    void empilhar() {
+        ++profundidade_;
+        profundidadeMaxima_ = std::max(profundidadeMaxima_, profundidade_);
+    }
+
+    void emitirConstante(double valor) {
+        destino_.codigo_.push_back({Op::CONSTANTE, 0, 0, valor});
+        empilhar();
+    }
+
+    /**
+     * @brief Emite um operador; com operandos constantes, calcula já na compilação
+     */
+    void emitir(Op op) {
+        auto& codigo = destino_.codigo_;
+        bool unario = op == Op::NEGACAO || op == Op::NAO || op == Op::PARA_BOOLEANO;
+        size_t operandos = unario ? 1 : 2;
+        if (!unario) {
+            --profundidade_;
+        }
+
+        // Só instruções depois do último destino de salto podem ser fundidas
+        bool constantes = codigo.size() >= operandos && codigo.size() - operandos >= ultimoDestino_;
+        for (size_t i = codigo.size() - std::min(operandos, codigo.size()); constantes && i < codigo.size(); ++i) {
+            constantes = codigo[i].op == Op::CONSTANTE;
+        }
+        if (!unario && !constantes && codigo.size() >= 2 && codigo.size() - 2 >= ultimoDestino_ &&
+            codigo[codigo.size() - 2].op == Op::VARIAVEL && codigo.back().op == Op::CONSTANTE) {
+            Op fundida = comparacaoComConstante(op);
+            if (fundida != op) {
+                double constante = codigo.back().valor;
+                codigo.pop_back();
+                codigo.back().op = fundida;
+                codigo.back().valor = constante;
+                return;
+            }
+        }
+        if (constantes) {
+            double pilha[2];
+            for (size_t i = 0; i < operandos; ++i) {
+                pilha[i] = codigo[codigo.size() - operandos + i].valor;
+            }
+            codigo.resize(codigo.size() - operandos);
+            Instrucao instrucao{op, 0, 0, 0.0};
+            size_t topo = operandos;
+            executar(instrucao, pilha, topo);
+            codigo.push_back({Op::CONSTANTE, 0, 0, pilha[0]});
+            return;
+        }
+        codigo.push_back({op, 0, 0, 0.0});
+    }
+
+    static Op comparacaoComConstante(Op op) {
+        switch (op) {
+            case Op::MAIOR: return Op::MAIOR_VC;
+            case Op::MAIOR_IGUAL: return Op::MAIOR_IGUAL_VC;
+            case Op::MENOR: return Op::MENOR_VC;
+            case Op::MENOR_IGUAL: return Op::MENOR_IGUAL_VC;
+            case Op::IGUAL: return Op::IGUAL_VC;
+            case Op::DIFERENTE: return Op::DIFERENTE_VC;
+            default: return op;
+        }
+    }
+
+    size_t emitirSalto(Op op) {
+        // O ramo que salta mantém o topo; o que segue o desempilha
+        destino_.codigo_.push_back({op, 0, 0, 0.0});
+        --profundidade_;
+        return destino_.codigo_.size() - 1;
+    }
+
+    void corrigirSalto(size_t salto) {
+        ultimoDestino_ = destino_.codigo_.size();
+        destino_.codigo_[salto].destino = static_cast<uint32_t>(ultimoDestino_);
+    }
+
+    /**
+     * @brief Executa um operador sobre o topo da pilha (dobra de constantes)
+     */
+    static void executar(const Instrucao& instrucao, double* pilha, size_t& topo) {
+        switch (instrucao.op) {
+            case Op::NEGACAO: pilha[topo - 1] = -pilha[topo - 1]; return;
+            case Op::NAO: pilha[topo - 1] = pilha[topo - 1] == 0.0 ? 1.0 : 0.0; return;
+            case Op::PARA_BOOLEANO: pilha[topo - 1] = pilha[topo - 1] != 0.0 ? 1.0 : 0.0; return;
+            default: break;
+        }
+
+        double b = pilha[--topo];
+        double& a = pilha[topo - 1];
+        switch (instrucao.op) {
+            case Op::SOMA: a = a + b; break;
+            case Op::SUBTRACAO: a = a - b; break;
+            case Op::MULTIPLICACAO: a = a * b; break;
+            case Op::DIVISAO: a = a / b; break;
+            case Op::MAIOR: a = a > b; break;
+            case Op::MAIOR_IGUAL: a = a >= b; break;
+            case Op::MENOR: a = a < b; break;
+            case Op::MENOR_IGUAL: a = a <= b; break;
+            case Op::IGUAL: a = a == b; break;
+            case Op::DIFERENTE: a = a != b; break;
+            default: break;
+        }
+    }
+
+    const std::string& texto_;
+    ExpressaoRegra& destino_;
+
+    size_t posicao_ = 0;
+    size_t inicioToken_ = 0;
+    Token token_ = Token::FIM;
+    std::string lexema_;
+    double numero_ = 0.0;
+
+    size_t aninhamento_ = 0;
+    size_t profundidade_ = 0;
+    size_t profundidadeMaxima_ = 0;
+    size_t ultimoDestino_ = 0;
+};
+
+ExpressaoRegra ExpressaoRegra::compilar(const std::string& texto) {
+    ExpressaoRegra expressao;
+    expressao.texto_ = texto;
+    Compilador(expressao.texto_, expressao).compilar();
+    expressao.codigo_.shrink_to_fit();
+    return expressao;
+}
+
+double ExpressaoRegra::avaliar(const double* variaveis) const {
+    double pilha[MAX_PILHA];
+    size_t topo = 0;
+
+    const Instrucao* codigo = codigo_.data();
+    const size_t tamanho = codigo_.size();
+    for (size_t pc = 0; pc < tamanho; ++pc) {
+        const Instrucao& instrucao = codigo[pc];
+        const double* v = variaveis + instrucao.variavel;
+        switch (instrucao.op) {
+            case Op::CONSTANTE: pilha[topo++] = instrucao.valor; break;
+            case Op::VARIAVEL: pilha[topo++] = *v; break;
+
+            case Op::MAIOR_VC: pilha[topo++] = *v > instrucao.valor; break;
+            case Op::MAIOR_IGUAL_VC: pilha[topo++] = *v >= instrucao.valor; break;
+            case Op::MENOR_VC: pilha[topo++] = *v < instrucao.valor; break;
+            case Op::MENOR_IGUAL_VC: pilha[topo++] = *v <= instrucao.valor; break;
+            case Op::IGUAL_VC: pilha[topo++] = *v == instrucao.valor; break;
+            case Op::DIFERENTE_VC: pilha[topo++] = *v != instrucao.valor; break;
+
+            case Op::SOMA: --topo; pilha[topo - 1] += pilha[topo]; break;
+            case Op::SUBTRACAO: --topo; pilha[topo - 1] -= pilha[topo]; break;
+            case Op::MULTIPLICACAO: --topo; pilha[topo - 1] *= pilha[topo]; break;
+            case Op::DIVISAO: --topo; pilha[topo - 1] /= pilha[topo]; break;
+            case Op::MAIOR: --topo; pilha[topo - 1] = pilha[topo - 1] > pilha[topo]; break;
+            case Op::MAIOR_IGUAL: --topo; pilha[topo - 1] = pilha[topo - 1] >= pilha[topo]; break;
+            case Op::MENOR: --topo; pilha[topo - 1] = pilha[topo - 1] < pilha[topo]; break;
+            case Op::MENOR_IGUAL: --topo; pilha[topo - 1] = pilha[topo - 1] <= pilha[topo]; break;
+            case Op::IGUAL: --topo; pilha[topo - 1] = pilha[topo - 1] == pilha[topo]; break;
+            case Op::DIFERENTE: --topo; pilha[topo - 1] = pilha[topo - 1] != pilha[topo]; break;
+
+            case Op::NEGACAO: pilha[topo - 1] = -pilha[topo - 1]; break;
+            case Op::NAO: pilha[topo - 1] = pilha[topo - 1] == 0.0; break;
+            case Op::PARA_BOOLEANO: pilha[topo - 1] = pilha[topo - 1] != 0.0; break;
+
+            case Op::SE_FALSO_SALTAR:
+                if (pilha[topo - 1] == 0.0) {
+                    pilha[topo - 1] = 0.0;
+                    pc = instrucao.destino - 1;
+                } else {
+                    --topo;
+                }
+                break;
+            case Op::SE_VERDADEIRO_SALTAR:
+                if (pilha[topo - 1] != 0.0) {
+                    pilha[topo - 1] = 1.0;
+                    pc = instrucao.destino - 1;
+                } else {
+                    --topo;
+                }
+                break;
+        }
+    }
+    return topo > 0 ? pilha[topo - 1] : 0.0;
+}
+
+const char* ExpressaoRegra::nomeVariavel(Variavel variavel) {
+    return variavel < NUM_VARIAVEIS ? NOMES_VARIAVEIS[variavel] : "";
+}
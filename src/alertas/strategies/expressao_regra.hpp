@@ -0,0 +1,93 @@
+#ifndef EXPRESSAO_REGRA_HPP
+#define EXPRESSAO_REGRA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Expressão de regra de alerta compilada para bytecode
+ *
+ * A linguagem tem números, variáveis (ver Variavel), aritmética (+ - * /),
+ * comparações (> >= < <= == !=), lógica (`e`/`&&`, `ou`/`||`,
+ * `nao`/`não`/`!`), `verdadeiro`/`falso` e parênteses. Exemplo:
+ *
+ *     vazao_noturna > parametro e horas_fluxo >= 3 e dia_util
+ *
+ * compilar() faz a análise uma única vez e gera instruções para uma
+ * máquina de pilha; avaliar() só percorre o vetor de instruções, sem
+ * alocar. `e`/`ou` fazem curto-circuito. Verdadeiro é qualquer valor
+ * diferente de zero; comparações e operadores lógicos produzem 0 ou 1.
+ * Divisão por zero segue o IEEE 754 (comparações com NaN são falsas).
+ */
+class ExpressaoRegra {
+public:
+    /**
+     * @brief Variáveis disponíveis nas expressões; avaliar() recebe os valores nesta ordem
+     */
+    enum Variavel : uint8_t {
+        CONSUMO,        // consumo avaliado (L): diário, ou do dia do hidrômetro por leitura
+        PARAMETRO,      // valor configurado na regra
+        VAZAO,          // L/h no último intervalo entre leituras (0 = parado)
+        VAZAO_MINIMA,   // menor vazão do fluxo contínuo atual (L/h)
+        VAZAO_NOTURNA,  // menor vazão noturna do fluxo contínuo atual (L/h; 0 se nenhuma)
+        HORAS_FLUXO,    // duração do fluxo contínuo atual (h)
+        LITROS_FLUXO,   // litros no fluxo contínuo atual
+        HORA,           // hora local (0-23)
+        DIA_SEMANA,     // 0 = domingo ... 6 = sábado
+        DIA_UTIL,       // 1 de segunda a sexta
+        NOITE,          // 1 dentro do período noturno
+        NUM_VARIAVEIS
+    };
+
+    /**
+     * @brief Compila o texto de uma expressão
+     * @throws std::invalid_argument com a posição do erro
+     */
+    static ExpressaoRegra compilar(const std::string& texto);
+
+    /**
+     * @brief Avalia a expressão
+     * @param variaveis NUM_VARIAVEIS valores, na ordem de Variavel
+     */
+    double avaliar(const double* variaveis) const;
+
+    bool usaVariavel(Variavel variavel) const { return (variaveisUsadas_ >> variavel) & 1u; }
+    const std::string& getTexto() const { return texto_; }
+    size_t getNumInstrucoes() const { return codigo_.size(); }
+
+    static const char* nomeVariavel(Variavel variavel);
+
+private:
+    class Compilador;
+
+    enum class Op : uint8_t {
+        CONSTANTE, VARIAVEL,
+        SOMA, SUBTRACAO, MULTIPLICACAO, DIVISAO, NEGACAO,
+        MAIOR, MAIOR_IGUAL, MENOR, MENOR_IGUAL, IGUAL, DIFERENTE,
+        NAO, PARA_BOOLEANO,
+        SE_FALSO_SALTAR,       // topo == 0: vira 0 e salta; senão desempilha
+        SE_VERDADEIRO_SALTAR,  // topo != 0: vira 1 e salta; senão desempilha
+        // `variável <comparação> constante` numa instrução só, o caso mais comum das regras
+        MAIOR_VC, MAIOR_IGUAL_VC, MENOR_VC, MENOR_IGUAL_VC, IGUAL_VC, DIFERENTE_VC
+    };
+
+    struct Instrucao {
+        Op op;
+        uint8_t variavel;
+        uint32_t destino;  // saltos: índice da próxima instrução
+        double valor;      // CONSTANTE
+    };
+
+    // Limite da pilha de avaliação, que fica na pilha de chamadas
+    static constexpr size_t MAX_PILHA = 64;
+    // Limite de parênteses, 'nao' e '-' aninhados: o compilador é recursivo
+    static constexpr size_t MAX_ANINHAMENTO = 128;
+
+    std::string texto_;
+    std::vector<Instrucao> codigo_;
+    uint32_t variaveisUsadas_ = 0;
+};
+
+#endif // EXPRESSAO_REGRA_HPP
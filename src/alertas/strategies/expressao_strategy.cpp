@@ -0,0 +1,197 @@
+#include "expressao_strategy.hpp"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+ExpressaoStrategy::ExpressaoStrategy(const std::string& nome, const std::string& expressao,
+                                     int intervaloMaximoSeg, int horaInicioNoite, int horaFimNoite)
+    : nome(nome),
+      expressao(ExpressaoRegra::compilar(expressao)),
+      porLeitura(false),
+      intervaloMaximoSeg(intervaloMaximoSeg),
+      horaInicioNoite(horaInicioNoite),
+      horaFimNoite(horaFimNoite) {
+    for (auto variavel : {ExpressaoRegra::VAZAO, ExpressaoRegra::VAZAO_MINIMA,
+                          ExpressaoRegra::VAZAO_NOTURNA, ExpressaoRegra::HORAS_FLUXO,
+                          ExpressaoRegra::LITROS_FLUXO}) {
+        porLeitura = porLeitura || this->expressao.usaVariavel(variavel);
+    }
+}
+
+ParametrosRegra ExpressaoStrategy::compilarParametros(const std::string& valorParametro) const {
+    ParametrosRegra parametros;
+    // Sem `parametro` na expressão, o valor da regra pode ficar vazio
+    if (!valorParametro.empty() || expressao.usaVariavel(ExpressaoRegra::PARAMETRO)) {
+        parametros.valorExpressao = converterParametroNumerico(valorParametro);
+    }
+    return parametros;
+}
+
+bool ExpressaoStrategy::analisar(double consumoAtual, const ParametrosRegra& parametros) const {
+    // Variáveis de fluxo só existem na série de leituras (analisarLeitura)
+    if (porLeitura) {
+        return false;
+    }
+
+    double variaveis[ExpressaoRegra::NUM_VARIAVEIS] = {};
+    variaveis[ExpressaoRegra::CONSUMO] = consumoAtual;
+    variaveis[ExpressaoRegra::PARAMETRO] = parametros.valorExpressao;
+    if (expressao.usaVariavel(ExpressaoRegra::HORA) || expressao.usaVariavel(ExpressaoRegra::DIA_SEMANA) ||
+        expressao.usaVariavel(ExpressaoRegra::DIA_UTIL) || expressao.usaVariavel(ExpressaoRegra::NOITE)) {
+        preencherCalendario(std::time(nullptr), variaveis);
+    }
+    return expressao.avaliar(variaveis) != 0.0;
+}
+
+std::string ExpressaoStrategy::getNome() const {
+    return nome;
+}
+
+std::string ExpressaoStrategy::gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Regra " << nome << " violada (" << expressao.getTexto() << ", parametro = "
+       << parametros.valorExpressao << "): consumo de " << consumoAtual << "L";
+    return ss.str();
+}
+
+void ExpressaoStrategy::registrarLeitura(const std::string& idSha, double valorLitros,
+                                         std::time_t dataHora) {
+    if (!porLeitura) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutexEstados);
+    EstadoHidrometro& estado = estadosPorHidrometro[idSha];
+    ++estado.leituras;
+
+    std::tm local;
+    localtime_r(&dataHora, &local);
+    long dia = local.tm_year * 1000L + local.tm_yday;
+
+    if (!estado.temLeitura) {
+        estado.ultimoValor = valorLitros;
+        estado.ultimaLeitura = dataHora;
+        estado.temLeitura = true;
+        estado.dia = dia;
+        return;
+    }
+
+    // Leituras repetidas ou fora de ordem não formam intervalo
+    if (dataHora <= estado.ultimaLeitura) {
+        return;
+    }
+
+    double litros = valorLitros - estado.ultimoValor;
+    long segundos = static_cast<long>(dataHora - estado.ultimaLeitura);
+    std::time_t inicioIntervalo = estado.ultimaLeitura;
+    estado.ultimoValor = valorLitros;
+    estado.ultimaLeitura = dataHora;
+
+    if (dia != estado.dia) {
+        estado.dia = dia;
+        estado.litrosDia = 0.0;
+    }
+    if (litros > 0) {
+        estado.litrosDia += litros;
+    }
+
+    // Fluxo parou (ou o hidrômetro foi trocado), ou o intervalo é longo
+    // demais para afirmar que não parou: recomeça a contagem
+    if (litros <= 0 || segundos > intervaloMaximoSeg) {
+        estado.vazao = 0.0;
+        estado.inicioFluxo = 0;
+        estado.litrosNoFluxo = 0.0;
+        estado.fluxoMinimo = 0.0;
+        estado.fluxoMinimoNoturno = -1.0;
+        return;
+    }
+
+    estado.vazao = litros * 3600.0 / static_cast<double>(segundos);
+    if (estado.inicioFluxo == 0) {
+        estado.inicioFluxo = inicioIntervalo;
+        estado.fluxoMinimo = estado.vazao;
+    }
+    estado.litrosNoFluxo += litros;
+    estado.fluxoMinimo = std::min(estado.fluxoMinimo, estado.vazao);
+
+    std::time_t meioIntervalo = inicioIntervalo + segundos / 2;
+    std::tm localMeio;
+    localtime_r(&meioIntervalo, &localMeio);
+    if (ehNoturno(localMeio.tm_hour)) {
+        estado.fluxoMinimoNoturno = estado.fluxoMinimoNoturno < 0
+            ? estado.vazao : std::min(estado.fluxoMinimoNoturno, estado.vazao);
+    }
+}
+
+bool ExpressaoStrategy::analisarLeitura(const std::string& idSha, const ParametrosRegra& parametros,
+                                        double& consumo, std::string& mensagem) {
+    if (!porLeitura) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutexEstados);
+    auto it = estadosPorHidrometro.find(idSha);
+    if (it == estadosPorHidrometro.end()) {
+        return false;
+    }
+    EstadoHidrometro& estado = it->second;
+
+    auto itAvaliacao = std::find_if(estado.avaliacoes.begin(), estado.avaliacoes.end(),
+                                    [&](const Avaliacao& a) { return a.parametro == parametros.valorExpressao; });
+    if (itAvaliacao == estado.avaliacoes.end()) {
+        estado.avaliacoes.push_back({parametros.valorExpressao, 0, false, false});
+        itAvaliacao = estado.avaliacoes.end() - 1;
+    }
+    Avaliacao& avaliacao = *itAvaliacao;
+
+    double horasFluxo = estado.inicioFluxo == 0
+        ? 0.0 : static_cast<double>(estado.ultimaLeitura - estado.inicioFluxo) / 3600.0;
+    if (avaliacao.leitura != estado.leituras) {
+        double variaveis[ExpressaoRegra::NUM_VARIAVEIS] = {};
+        variaveis[ExpressaoRegra::CONSUMO] = estado.litrosDia;
+        variaveis[ExpressaoRegra::PARAMETRO] = parametros.valorExpressao;
+        variaveis[ExpressaoRegra::VAZAO] = estado.vazao;
+        variaveis[ExpressaoRegra::VAZAO_MINIMA] = estado.fluxoMinimo;
+        variaveis[ExpressaoRegra::VAZAO_NOTURNA] = std::max(0.0, estado.fluxoMinimoNoturno);
+        variaveis[ExpressaoRegra::HORAS_FLUXO] = horasFluxo;
+        variaveis[ExpressaoRegra::LITROS_FLUXO] = estado.litrosNoFluxo;
+        preencherCalendario(estado.ultimaLeitura, variaveis);
+
+        avaliacao.anterior = avaliacao.atual;
+        avaliacao.atual = expressao.avaliar(variaveis) != 0.0;
+        avaliacao.leitura = estado.leituras;
+    }
+
+    // Dispara na transição de falsa para verdadeira
+    if (!avaliacao.atual || avaliacao.anterior) {
+        return false;
+    }
+
+    consumo = estado.inicioFluxo != 0 ? estado.litrosNoFluxo : estado.litrosDia;
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Regra " << nome << " violada no hidrômetro " << idSha << " (" << expressao.getTexto()
+       << ", parametro = " << parametros.valorExpressao << "): vazão de " << estado.vazao
+       << "L/h, fluxo contínuo há " << horasFluxo << " horas, " << estado.litrosDia << "L no dia";
+    mensagem = ss.str();
+    return true;
+}
+
+void ExpressaoStrategy::preencherCalendario(std::time_t instante, double* variaveis) const {
+    // Avaliações do mesmo segundo (ex: uma verificação em lote) convertem a data uma vez
+    thread_local std::time_t ultimoInstante = -1;
+    thread_local std::tm local;
+    if (instante != ultimoInstante) {
+        localtime_r(&instante, &local);
+        ultimoInstante = instante;
+    }
+    variaveis[ExpressaoRegra::HORA] = local.tm_hour;
+    variaveis[ExpressaoRegra::DIA_SEMANA] = local.tm_wday;
+    variaveis[ExpressaoRegra::DIA_UTIL] = (local.tm_wday >= 1 && local.tm_wday <= 5) ? 1.0 : 0.0;
+    variaveis[ExpressaoRegra::NOITE] = ehNoturno(local.tm_hour) ? 1.0 : 0.0;
+}
+
+bool ExpressaoStrategy::ehNoturno(int hora) const {
+    return hora >= horaInicioNoite && hora < horaFimNoite;
+}
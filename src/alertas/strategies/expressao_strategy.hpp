@@ -0,0 +1,111 @@
+#ifndef EXPRESSAO_STRATEGY_HPP
+#define EXPRESSAO_STRATEGY_HPP
+
+#include "estrategia_analise_consumo.hpp"
+#include "expressao_regra.hpp"
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Estratégia definida por uma expressão (ver ExpressaoRegra)
+ *
+ * Permite cadastrar regras sem escrever uma classe nova:
+ *
+ *     service->registrarEstrategiaAnalise("VAZAMENTO_NOTURNO",
+ *         std::make_shared<ExpressaoStrategy>("VAZAMENTO_NOTURNO",
+ *             "vazao_noturna > parametro e horas_fluxo >= 3 e dia_util"));
+ *     service->salvarRegra(usuarioId, "VAZAMENTO_NOTURNO", "10");
+ *
+ * A expressão é compilada uma vez, no construtor; o parâmetro de cada
+ * regra é o valor da variável `parametro`.
+ *
+ * Expressões que usam variáveis de fluxo (vazao, vazao_minima,
+ * vazao_noturna, horas_fluxo, litros_fluxo) são avaliadas a cada leitura
+ * do hidrômetro (analisarLeitura), com o mesmo estado O(1) por hidrômetro
+ * da DeteccaoVazamentoStrategy, e disparam quando a expressão passa de
+ * falsa a verdadeira. As demais são avaliadas sobre o consumo
+ * (analisar), com hora e dia do momento da verificação.
+ */
+class ExpressaoStrategy : public EstrategiaAnaliseConsumo {
+public:
+    /**
+     * @param nome Nome da estratégia (o mesmo usado em registrarEstrategiaAnalise)
+     * @param expressao Texto da expressão
+     * @param intervaloMaximoSeg Maior intervalo entre leituras em que o fluxo ainda é contínuo
+     * @param horaInicioNoite Início (inclusive) do período noturno, hora local
+     * @param horaFimNoite Fim (exclusive) do período noturno, hora local
+     * @throws std::invalid_argument se a expressão não compilar
+     */
+    ExpressaoStrategy(const std::string& nome, const std::string& expressao,
+                      int intervaloMaximoSeg = 2 * 3600,
+                      int horaInicioNoite = 0, int horaFimNoite = 6);
+
+    ParametrosRegra compilarParametros(const std::string& valorParametro) const override;
+    bool analisar(double consumoAtual, const ParametrosRegra& parametros) const override;
+    std::string getNome() const override;
+    std::string gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const override;
+    bool avaliaConsumoAgregado() const override { return !porLeitura; }
+
+    void registrarLeitura(const std::string& idSha, double valorLitros, std::time_t dataHora) override;
+    bool analisarLeitura(const std::string& idSha, const ParametrosRegra& parametros,
+                         double& consumo, std::string& mensagem) override;
+
+    const ExpressaoRegra& getExpressao() const { return expressao; }
+
+    /**
+     * @brief true se a expressão é avaliada por leitura (usa variáveis de fluxo)
+     */
+    bool isPorLeitura() const { return porLeitura; }
+
+private:
+    /**
+     * @brief Último resultado da expressão para um valor de `parametro`
+     *
+     * Regras com o mesmo parâmetro no mesmo hidrômetro têm o mesmo
+     * resultado; a primeira a ser analisada numa leitura o calcula.
+     */
+    struct Avaliacao {
+        double parametro;
+        uint64_t leitura;    // número da leitura em que foi calculado
+        bool anterior;
+        bool atual;
+    };
+
+    struct EstadoHidrometro {
+        double ultimoValor = 0.0;
+        std::time_t ultimaLeitura = 0;
+        bool temLeitura = false;
+        uint64_t leituras = 0;
+
+        long dia = -1;                       // dia local de `litrosDia`
+        double litrosDia = 0.0;
+
+        double vazao = 0.0;                  // L/h no último intervalo
+        std::time_t inicioFluxo = 0;         // 0 = sem fluxo contínuo em andamento
+        double litrosNoFluxo = 0.0;
+        double fluxoMinimo = 0.0;
+        double fluxoMinimoNoturno = -1.0;    // negativo enquanto não houver intervalo noturno
+
+        std::vector<Avaliacao> avaliacoes;
+    };
+
+    /**
+     * @brief Preenche hora, dia da semana, dia útil e noite a partir de `instante`
+     */
+    void preencherCalendario(std::time_t instante, double* variaveis) const;
+    bool ehNoturno(int hora) const;
+
+    std::string nome;
+    ExpressaoRegra expressao;
+    bool porLeitura;
+    int intervaloMaximoSeg;
+    int horaInicioNoite;
+    int horaFimNoite;
+
+    mutable std::mutex mutexEstados;
+    std::unordered_map<std::string, EstadoHidrometro> estadosPorHidrometro;
+};
+
+#endif // EXPRESSAO_STRATEGY_HPP
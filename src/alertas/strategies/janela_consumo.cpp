@@ -0,0 +1,52 @@
+#include "janela_consumo.hpp"
+#include <algorithm>
+#include <cmath>
+
+JanelaConsumo::JanelaConsumo(size_t capacidade)
+    : valores_(std::max<size_t>(1, capacidade), 0.0) {}
+
+void JanelaConsumo::adicionar(double valor) {
+    if (quantidade_ < valores_.size()) {
+        // Janela ainda enchendo: Welford clássico
+        ++quantidade_;
+        double delta = valor - media_;
+        media_ += delta / static_cast<double>(quantidade_);
+        m2_ += delta * (valor - media_);
+    } else {
+        // Janela cheia: a nova amostra substitui a mais antiga
+        double antigo = valores_[proximo_];
+        double mediaAnterior = media_;
+        media_ += (valor - antigo) / static_cast<double>(quantidade_);
+        m2_ += (valor - antigo) * (valor - media_ + antigo - mediaAnterior);
+        m2_ = std::max(0.0, m2_);  // erro de arredondamento acumulado
+    }
+
+    valores_[proximo_] = valor;
+    proximo_ = (proximo_ + 1) % valores_.size();
+}
+
+double JanelaConsumo::variancia() const {
+    if (quantidade_ < 2) {
+        return 0.0;
+    }
+    return m2_ / static_cast<double>(quantidade_ - 1);
+}
+
+double JanelaConsumo::desvioPadrao() const {
+    return std::sqrt(variancia());
+}
+
+double JanelaConsumo::mediaUltimas(size_t n) const {
+    n = std::min(n, quantidade_);
+    if (n == 0) {
+        return 0.0;
+    }
+
+    double soma = 0.0;
+    size_t posicao = proximo_;
+    for (size_t i = 0; i < n; ++i) {
+        posicao = (posicao + valores_.size() - 1) % valores_.size();
+        soma += valores_[posicao];
+    }
+    return soma / static_cast<double>(n);
+}
@@ -0,0 +1,49 @@
+#ifndef JANELA_CONSUMO_HPP
+#define JANELA_CONSUMO_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Janela deslizante de consumo com média e variância em O(1)
+ * 
+ * Guarda as últimas `capacidade` amostras num buffer circular de tamanho
+ * fixo e mantém média e soma dos quadrados dos desvios (M2) pela forma
+ * de Welford: a entrada de uma amostra (e a saída da mais antiga, com a
+ * janela cheia) atualiza os dois valores sem percorrer o histórico e sem
+ * a perda de precisão de somar quadrados diretamente.
+ */
+class JanelaConsumo {
+public:
+    explicit JanelaConsumo(size_t capacidade);
+
+    /**
+     * @brief Acrescenta uma amostra, descartando a mais antiga se a janela estiver cheia
+     */
+    void adicionar(double valor);
+
+    size_t quantidade() const { return quantidade_; }
+    size_t capacidade() const { return valores_.size(); }
+
+    double media() const { return media_; }
+
+    /**
+     * @brief Variância amostral (n - 1); 0 com menos de duas amostras
+     */
+    double variancia() const;
+    double desvioPadrao() const;
+
+    /**
+     * @brief Média das `n` amostras mais recentes (O(n))
+     */
+    double mediaUltimas(size_t n) const;
+
+private:
+    std::vector<double> valores_;
+    size_t proximo_ = 0;     // posição da próxima escrita (= mais antiga quando cheia)
+    size_t quantidade_ = 0;
+    double media_ = 0.0;
+    double m2_ = 0.0;
+};
+
+#endif // JANELA_CONSUMO_HPP
@@ -2,17 +2,23 @@
 #include <sstream>
 #include <iomanip>
 
-bool LimiteDiarioStrategy::analisar(double consumoAtual, const std::string& valorParametro) const {
-    double limite = extrairLimite(valorParametro);
-    return consumoAtual > limite;
+ParametrosRegra LimiteDiarioStrategy::compilarParametros(const std::string& valorParametro) const {
+    ParametrosRegra parametros;
+    parametros.limiteLitros = extrairLimite(valorParametro);
+    parametros.referenciaSeveridade = parametros.limiteLitros;
+    return parametros;
+}
+
+bool LimiteDiarioStrategy::analisar(double consumoAtual, const ParametrosRegra& parametros) const {
+    return consumoAtual > parametros.limiteLitros;
 }
 
 std::string LimiteDiarioStrategy::getNome() const {
     return "LIMITE_DIARIO";
 }
 
-std::string LimiteDiarioStrategy::gerarMensagem(double consumoAtual, const std::string& valorParametro) const {
-    double limite = extrairLimite(valorParametro);
+std::string LimiteDiarioStrategy::gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const {
+    double limite = parametros.limiteLitros;
     std::stringstream ss;
     ss << std::fixed << std::setprecision(2);
     ss << "Consumo diário de " << consumoAtual << "L excedeu o limite de " << limite << "L";
@@ -20,9 +26,9 @@ std::string LimiteDiarioStrategy::gerarMensagem(double consumoAtual, const std::
 }
 
 double LimiteDiarioStrategy::extrairLimite(const std::string& valorParametro) const {
-    try {
-        return std::stod(valorParametro);
-    } catch (...) {
-        return 70.0; // Valor padrão
+    double limite = converterParametroNumerico(valorParametro);
+    if (limite <= 0) {
+        throw std::invalid_argument("limite diário deve ser maior que zero: '" + valorParametro + "'");
     }
+    return limite;
 }
@@ -13,9 +13,10 @@
  */
 class LimiteDiarioStrategy : public EstrategiaAnaliseConsumo {
 public:
-    bool analisar(double consumoAtual, const std::string& valorParametro) const override;
+    ParametrosRegra compilarParametros(const std::string& valorParametro) const override;
+    bool analisar(double consumoAtual, const ParametrosRegra& parametros) const override;
     std::string getNome() const override;
-    std::string gerarMensagem(double consumoAtual, const std::string& valorParametro) const override;
+    std::string gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const override;
 
 private:
     double extrairLimite(const std::string& valorParametro) const;
@@ -0,0 +1,111 @@
+#include "limites_vetorizados.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+uint32_t LimitesVetorizados::vaga(int usuarioId) {
+    auto [it, nova] = vagaPorUsuario_.try_emplace(usuarioId, static_cast<uint32_t>(usuarioPorVaga_.size()));
+    if (nova) {
+        usuarioPorVaga_.push_back(usuarioId);
+        outrasRegrasPorVaga_.push_back(false);
+    }
+    return it->second;
+}
+
+void LimitesVetorizados::adicionar(int usuarioId, size_t posicaoRegra, double limite) {
+    limites_.push_back(limite);
+    vagas_.push_back(vaga(usuarioId));
+    posicoes_.push_back(posicaoRegra);
+}
+
+void LimitesVetorizados::marcarOutrasRegras(int usuarioId) {
+    outrasRegrasPorVaga_[vaga(usuarioId)] = true;
+}
+
+void LimitesVetorizados::desativar(size_t posicaoRegra) {
+    auto it = std::lower_bound(posicoes_.begin(), posicoes_.end(), posicaoRegra);
+    if (it != posicoes_.end() && *it == posicaoRegra) {
+        limites_[static_cast<size_t>(it - posicoes_.begin())] = std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+void LimitesVetorizados::limpar() {
+    limites_.clear();
+    vagas_.clear();
+    posicoes_.clear();
+    vagaPorUsuario_.clear();
+    usuarioPorVaga_.clear();
+    outrasRegrasPorVaga_.clear();
+}
+
+LimitesVetorizados::Lote LimitesVetorizados::prepararLote(
+    const std::vector<std::pair<int, double>>& consumoPorUsuario) const {
+    Lote lote;
+    lote.consumoPorVaga.assign(usuarioPorVaga_.size(), std::numeric_limits<double>::quiet_NaN());
+    lote.avaliarRegraARegra.assign(consumoPorUsuario.size(), true);
+    for (size_t i = 0; i < consumoPorUsuario.size(); ++i) {
+        auto it = vagaPorUsuario_.find(consumoPorUsuario[i].first);
+        if (it != vagaPorUsuario_.end()) {
+            lote.consumoPorVaga[it->second] = consumoPorUsuario[i].second;
+            lote.avaliarRegraARegra[i] = outrasRegrasPorVaga_[it->second];
+        }
+    }
+    return lote;
+}
+
+size_t LimitesVetorizados::avaliar(const Lote& lote, size_t inicio, size_t fim,
+                                   std::vector<Violacao>& violacoes) const {
+    fim = std::min(fim, limites_.size());
+    double consumos[TAMANHO_BLOCO];
+    uint64_t mascara[TAMANHO_BLOCO / 64];
+    size_t avaliadas = 0;
+
+    for (size_t bloco = inicio; bloco < fim; bloco += TAMANHO_BLOCO) {
+        size_t n = std::min(TAMANHO_BLOCO, fim - bloco);
+        const double* limites = limites_.data() + bloco;
+        const uint32_t* vagas = vagas_.data() + bloco;
+        for (size_t i = 0; i < n; ++i) {
+            consumos[i] = lote.consumoPorVaga[vagas[i]];
+            avaliadas += !std::isnan(consumos[i]) && !std::isnan(limites[i]);
+        }
+
+        compararMaiorQue(consumos, limites, n, mascara);
+        for (size_t palavra = 0; palavra < (n + 63) / 64; ++palavra) {
+            for (uint64_t bits = mascara[palavra]; bits != 0; bits &= bits - 1) {
+                size_t i = palavra * 64 + static_cast<size_t>(__builtin_ctzll(bits));
+                violacoes.push_back({posicoes_[bloco + i], usuarioPorVaga_[vagas[i]], consumos[i]});
+            }
+        }
+    }
+    return avaliadas;
+}
+
+void LimitesVetorizados::compararMaiorQue(const double* consumos, const double* limites, size_t n,
+                                          uint64_t* mascara) {
+    for (size_t palavra = 0; palavra * 64 < n; ++palavra) {
+        const size_t base = palavra * 64;
+        const size_t fim = std::min(n, base + 64);
+        uint64_t bits = 0;
+        size_t i = base;
+#if defined(__AVX__)
+        for (; i + 4 <= fim; i += 4) {
+            __m256d maior = _mm256_cmp_pd(_mm256_loadu_pd(consumos + i), _mm256_loadu_pd(limites + i),
+                                          _CMP_GT_OQ);
+            bits |= static_cast<uint64_t>(_mm256_movemask_pd(maior)) << (i - base);
+        }
+#elif defined(__SSE2__)
+        for (; i + 2 <= fim; i += 2) {
+            __m128d maior = _mm_cmpgt_pd(_mm_loadu_pd(consumos + i), _mm_loadu_pd(limites + i));
+            bits |= static_cast<uint64_t>(_mm_movemask_pd(maior)) << (i - base);
+        }
+#endif
+        for (; i < fim; ++i) {
+            bits |= static_cast<uint64_t>(consumos[i] > limites[i]) << (i - base);
+        }
+        mascara[palavra] = bits;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef LIMITES_VETORIZADOS_HPP
+#define LIMITES_VETORIZADOS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Regras de limite diário em estrutura de vetores, para avaliação em lote
+ *
+ * Cada regra ocupa a mesma posição em três vetores paralelos: limite,
+ * vaga do usuário e posição da regra no AlertaService. Cada usuário tem
+ * uma vaga densa; a avaliação de um lote distribui o consumo dos usuários
+ * pelas vagas (uma consulta por usuário, não por regra), recolhe o consumo
+ * de cada regra e compara blocos inteiros com instruções SIMD, produzindo
+ * uma máscara de bits das regras violadas.
+ *
+ * Regras desativadas ficam com limite NaN e usuários fora do lote com
+ * consumo NaN: comparações com NaN são falsas, então nenhuma das duas
+ * dispara sem desvio no laço.
+ *
+ * A vaga também indica se o usuário tem regras de outros tipos; os que
+ * não têm dispensam a avaliação regra a regra do lote.
+ */
+class LimitesVetorizados {
+public:
+    /**
+     * @brief Regra violada numa avaliação
+     */
+    struct Violacao {
+        size_t posicaoRegra;
+        int usuarioId;
+        double consumo;
+    };
+
+    /**
+     * @brief Consumo de um lote distribuído pelas vagas
+     */
+    struct Lote {
+        std::vector<double> consumoPorVaga;      // NaN para usuários fora do lote
+        std::vector<bool> avaliarRegraARegra;    // por entrada: usuário com regras de outros tipos
+    };
+
+    // Regras por bloco de comparação; avaliar() recebe intervalos alinhados a este valor
+    static constexpr size_t TAMANHO_BLOCO = 256;
+
+    /**
+     * @brief Acrescenta uma regra; as posições devem ser crescentes
+     */
+    void adicionar(int usuarioId, size_t posicaoRegra, double limite);
+
+    /**
+     * @brief Indica que o usuário tem regras ativas fora deste conjunto
+     */
+    void marcarOutrasRegras(int usuarioId);
+
+    /**
+     * @brief Tira uma regra da avaliação (busca binária pela posição)
+     */
+    void desativar(size_t posicaoRegra);
+
+    void limpar();
+    size_t tamanho() const { return limites_.size(); }
+    bool vazio() const { return limites_.empty(); }
+
+    /**
+     * @brief Distribui o consumo de um lote pelas vagas (uma consulta por usuário)
+     */
+    Lote prepararLote(const std::vector<std::pair<int, double>>& consumoPorUsuario) const;
+
+    /**
+     * @brief Avalia as regras [inicio, fim) contra o consumo distribuído
+     *
+     * @param inicio Múltiplo de TAMANHO_BLOCO, para que partições não dividam blocos
+     * @param violacoes Saída: regras violadas, em ordem de posição
+     * @return Regras efetivamente avaliadas (ativas e com usuário no lote)
+     */
+    size_t avaliar(const Lote& lote, size_t inicio, size_t fim,
+                   std::vector<Violacao>& violacoes) const;
+
+    /**
+     * @brief Marca em `mascara` os índices i com consumos[i] > limites[i]
+     *
+     * Bit i % 64 da palavra i / 64; `mascara` precisa de (n + 63) / 64
+     * palavras. Usa AVX quando o compilador o habilita (ex: -march=native),
+     * senão SSE2, senão um laço escalar.
+     */
+    static void compararMaiorQue(const double* consumos, const double* limites, size_t n,
+                                 uint64_t* mascara);
+
+private:
+    std::vector<double> limites_;
+    std::vector<uint32_t> vagas_;
+    std::vector<size_t> posicoes_;
+
+    std::unordered_map<int, uint32_t> vagaPorUsuario_;
+    std::vector<int> usuarioPorVaga_;
+    std::vector<bool> outrasRegrasPorVaga_;
+
+    uint32_t vaga(int usuarioId);
+};
+
+#endif // LIMITES_VETORIZADOS_HPP
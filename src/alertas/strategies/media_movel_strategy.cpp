@@ -1,16 +1,34 @@
 #include "media_movel_strategy.hpp"
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
-#include <numeric>
+#include <mutex>
 
-bool MediaMovelStrategy::analisar(double consumoAtual, const std::string& valorParametro) const {
-    double percentualDesvio = extrairPercentualDesvio(valorParametro);
+MediaMovelStrategy::MediaMovelStrategy(size_t tamanhoJanela, size_t minimoAmostras)
+    : tamanhoJanela(tamanhoJanela), minimoAmostras(std::max<size_t>(1, minimoAmostras)) {}
+
+ParametrosRegra MediaMovelStrategy::compilarParametros(const std::string& valorParametro) const {
+    ParametrosRegra parametros;
+    parametros.percentualDesvio = extrairPercentualDesvio(valorParametro);
+    parametros.referenciaSeveridade = parametros.percentualDesvio;
+    return parametros;
+}
+
+bool MediaMovelStrategy::analisar(double /*consumoAtual*/, const ParametrosRegra& /*parametros*/) const {
+    // Sem o usuário não há histórico com que comparar
+    return false;
+}
+
+bool MediaMovelStrategy::analisar(int usuarioId, double consumoAtual,
+                                  const ParametrosRegra& parametros) const {
+    std::shared_lock<std::shared_mutex> lock(mutexHistorico);
     
-    // Para demonstração, usa um valor fixo de média histórica
-    // Em produção, isso viria do banco de dados
-    double mediaHistorica = 50.0; // Valor simulado
+    const JanelaConsumo* janela = janelaDoUsuario(usuarioId);
+    if (!janela || janela->quantidade() < minimoAmostras) {
+        return false;
+    }
     
-    double limiteMaximo = mediaHistorica * (1.0 + percentualDesvio / 100.0);
+    double limiteMaximo = janela->media() * (1.0 + parametros.percentualDesvio / 100.0);
     return consumoAtual > limiteMaximo;
 }
 
@@ -18,45 +36,81 @@ std::string MediaMovelStrategy::getNome() const {
     return "MEDIA_MOVEL";
 }
 
-std::string MediaMovelStrategy::gerarMensagem(double consumoAtual, const std::string& valorParametro) const {
-    double percentualDesvio = extrairPercentualDesvio(valorParametro);
-    double mediaHistorica = 50.0; // Valor simulado
+std::string MediaMovelStrategy::gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Consumo atual de " << consumoAtual << "L excede em mais de "
+       << parametros.percentualDesvio << "% a média histórica";
+    return ss.str();
+}
+
+std::string MediaMovelStrategy::gerarMensagem(int usuarioId, double consumoAtual,
+                                              const ParametrosRegra& parametros) const {
+    double mediaHistorica = 0.0;
+    double desvioPadrao = 0.0;
+    size_t amostras = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutexHistorico);
+        if (const JanelaConsumo* janela = janelaDoUsuario(usuarioId)) {
+            mediaHistorica = janela->media();
+            desvioPadrao = janela->desvioPadrao();
+            amostras = janela->quantidade();
+        }
+    }
     
     std::stringstream ss;
     ss << std::fixed << std::setprecision(2);
-    ss << "Consumo atual de " << consumoAtual << "L excede em "
-       << percentualDesvio << "% a média histórica de " << mediaHistorica << "L";
+    ss << "Consumo atual de " << consumoAtual << "L excede em mais de "
+       << parametros.percentualDesvio << "% a média histórica de " << mediaHistorica 
+       << "L (desvio padrão " << desvioPadrao << "L, " << amostras << " amostras)";
     return ss.str();
 }
 
+void MediaMovelStrategy::registrarConsumo(int usuarioId, double consumo) {
+    adicionarConsumo(usuarioId, consumo);
+}
+
 void MediaMovelStrategy::adicionarConsumo(int usuarioId, double consumo) {
-    historicoConsumo[usuarioId].push_back(consumo);
+    std::unique_lock<std::shared_mutex> lock(mutexHistorico);
     
-    // Mantém apenas os últimos 30 valores para não crescer indefinidamente
-    if (historicoConsumo[usuarioId].size() > 30) {
-        historicoConsumo[usuarioId].erase(historicoConsumo[usuarioId].begin());
+    auto it = historicoConsumo.find(usuarioId);
+    if (it == historicoConsumo.end()) {
+        it = historicoConsumo.emplace(usuarioId, JanelaConsumo(tamanhoJanela)).first;
     }
+    it->second.adicionar(consumo);
 }
 
 double MediaMovelStrategy::calcularMedia(int usuarioId, int periodos) const {
-    auto it = historicoConsumo.find(usuarioId);
-    if (it == historicoConsumo.end() || it->second.empty()) {
+    std::shared_lock<std::shared_mutex> lock(mutexHistorico);
+    
+    const JanelaConsumo* janela = janelaDoUsuario(usuarioId);
+    if (!janela || periodos <= 0) {
         return 0.0;
     }
     
-    const std::vector<double>& valores = it->second;
-    int n = std::min(periodos, static_cast<int>(valores.size()));
-    
-    if (n == 0) return 0.0;
+    // A janela inteira já tem a média mantida; recortes menores somam as últimas
+    if (static_cast<size_t>(periodos) >= janela->quantidade()) {
+        return janela->media();
+    }
+    return janela->mediaUltimas(static_cast<size_t>(periodos));
+}
+
+double MediaMovelStrategy::calcularDesvioPadrao(int usuarioId) const {
+    std::shared_lock<std::shared_mutex> lock(mutexHistorico);
     
-    double soma = std::accumulate(valores.end() - n, valores.end(), 0.0);
-    return soma / n;
+    const JanelaConsumo* janela = janelaDoUsuario(usuarioId);
+    return janela ? janela->desvioPadrao() : 0.0;
+}
+
+const JanelaConsumo* MediaMovelStrategy::janelaDoUsuario(int usuarioId) const {
+    auto it = historicoConsumo.find(usuarioId);
+    return it != historicoConsumo.end() ? &it->second : nullptr;
 }
 
 double MediaMovelStrategy::extrairPercentualDesvio(const std::string& valorParametro) const {
-    try {
-        return std::stod(valorParametro);
-    } catch (...) {
-        return 50.0; // Valor padrão: 50% acima da média
+    double percentual = converterParametroNumerico(valorParametro);
+    if (percentual < 0) {
+        throw std::invalid_argument("percentual de desvio não pode ser negativo: '" + valorParametro + "'");
     }
+    return percentual;
 }
@@ -2,8 +2,9 @@
 #define MEDIA_MOVEL_STRATEGY_HPP
 
 #include "estrategia_analise_consumo.hpp"
-#include <vector>
+#include "janela_consumo.hpp"
 #include <map>
+#include <shared_mutex>
 
 /**
  * @brief Estratégia que detecta anomalias comparando com média histórica
@@ -13,22 +14,44 @@
  * 
  * Exemplo: Se a média dos últimos 7 dias é 50L e hoje foi 100L (100% acima),
  * o alerta é disparado.
+ * 
+ * O histórico de cada usuário é uma JanelaConsumo (média e variância em
+ * O(1) por amostra), alimentada pelo AlertaService com o consumo de cada
+ * verificação via registrarConsumo(). Enquanto a janela tiver menos que
+ * `minimoAmostras`, não há base de comparação e nenhum alerta é disparado.
  */
 class MediaMovelStrategy : public EstrategiaAnaliseConsumo {
 public:
-    bool analisar(double consumoAtual, const std::string& valorParametro) const override;
+    explicit MediaMovelStrategy(size_t tamanhoJanela = 30, size_t minimoAmostras = 7);
+
+    ParametrosRegra compilarParametros(const std::string& valorParametro) const override;
+    bool analisar(double consumoAtual, const ParametrosRegra& parametros) const override;
+    bool analisar(int usuarioId, double consumoAtual, const ParametrosRegra& parametros) const override;
     std::string getNome() const override;
-    std::string gerarMensagem(double consumoAtual, const std::string& valorParametro) const override;
+    std::string gerarMensagem(double consumoAtual, const ParametrosRegra& parametros) const override;
+    std::string gerarMensagem(int usuarioId, double consumoAtual,
+                              const ParametrosRegra& parametros) const override;
+    void registrarConsumo(int usuarioId, double consumo) override;
 
-    // Métodos auxiliares para gerenciar histórico (simplificado para demo)
+    // Métodos auxiliares para consultar/alimentar o histórico diretamente
     void adicionarConsumo(int usuarioId, double consumo);
     double calcularMedia(int usuarioId, int periodos) const;
+    double calcularDesvioPadrao(int usuarioId) const;
 
 private:
     double extrairPercentualDesvio(const std::string& valorParametro) const;
+
+    /**
+     * @brief Janela do usuário, ou nullptr sem histórico (chamar com o lock)
+     */
+    const JanelaConsumo* janelaDoUsuario(int usuarioId) const;
     
-    // Armazenamento simplificado do histórico (em produção, viria do banco)
-    mutable std::map<int, std::vector<double>> historicoConsumo;
+    size_t tamanhoJanela;
+    size_t minimoAmostras;
+
+    // Avaliações em paralelo leem; registrarConsumo escreve
+    mutable std::shared_mutex mutexHistorico;
+    std::map<int, JanelaConsumo> historicoConsumo;
 };
 
 #endif // MEDIA_MOVEL_STRATEGY_HPP
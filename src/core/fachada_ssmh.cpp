@@ -1,4 +1,5 @@
 #include "fachada_ssmh.hpp"
+#include "../utils/metricas.hpp"
 #include <stdexcept>
 #include <sstream>
 #include <iostream>
@@ -15,45 +16,102 @@ FachadaSSMH::FachadaSSMH(
     commandInvoker(std::make_unique<CommandInvoker>()),
     logManager(Logger::getInstance())
 {
-    logManager.registrarInfo("FachadaSSMH::Construtor", "Fachada inicializada com sucesso");
+    // A verificação automática de alertas obtém o consumo real em lote:
+    // hidrômetros de cada usuário (Usuários) + uma consulta ao Monitoramento.
+    // Os callbacks guardam weak_ptr dos serviços: Alertas → Monitoramento
+    // (fonte de consumo) e Monitoramento → Alertas (ouvinte de leituras)
+    // formariam um ciclo de shared_ptr, e nenhum serviço seria destruído
+    // (nem seus destrutores descarregariam filas e resumos pendentes)
+    if (alertaService && usuarioService && monitoramentoService) {
+        std::weak_ptr<UsuarioService> usuariosFraco = usuarioService;
+        std::weak_ptr<MonitoramentoService> monitoramentoFraco = monitoramentoService;
+        alertaService->definirFonteConsumo(
+            [usuariosFraco, monitoramentoFraco](const std::vector<int>& idsUsuarios,
+                                                std::time_t dataInicio, std::time_t dataFim) {
+                auto usuarios = usuariosFraco.lock();
+                auto monitoramento = monitoramentoFraco.lock();
+                if (!usuarios || !monitoramento) {
+                    return std::map<int, double>();
+                }
+                
+                std::vector<std::vector<std::string>> hidrometros;
+                hidrometros.reserve(idsUsuarios.size());
+                for (int idUsuario : idsUsuarios) {
+                    hidrometros.push_back(usuarios->listarHidrometros(idUsuario));
+                }
+                
+                std::vector<double> consumos =
+                    monitoramento->consultarConsumoEmLote(hidrometros, dataInicio, dataFim);
+                
+                std::map<int, double> consumoPorUsuario;
+                for (size_t i = 0; i < idsUsuarios.size() && i < consumos.size(); ++i) {
+                    consumoPorUsuario[idsUsuarios[i]] = consumos[i];
+                }
+                return consumoPorUsuario;
+            });
+        
+        // Leituras seguem para os alertas (ex: detecção de vazamento), que
+        // precisam saber o dono de cada hidrômetro já vinculado
+        try {
+            for (const auto& usuario : usuarioService->listarUsuarios()) {
+                for (const auto& idSha : usuarioService->listarHidrometros(usuario.getId())) {
+                    alertaService->vincularHidrometro(usuario.getId(), idSha);
+                }
+            }
+        } catch (const std::exception& e) {
+            SSMH_LOG_AVISO("FachadaSSMH::Construtor", 
+                std::string("Falha ao carregar vínculos de hidrômetros: ") + e.what());
+        }
+        
+        std::weak_ptr<AlertaService> alertasFraco = alertaService;
+        monitoramentoService->adicionarOuvinteLeitura([alertasFraco](const Leitura& leitura) {
+            if (auto alertas = alertasFraco.lock()) {
+                alertas->processarLeitura(leitura.getIdSha(), leitura.getValor(), leitura.getDataHora());
+            }
+        });
+    }
+    
+    SSMH_LOG_INFO("FachadaSSMH::Construtor", "Fachada inicializada com sucesso");
 }
 
 void FachadaSSMH::inicializar() {
-    logManager.registrarInfo("FachadaSSMH::inicializar", 
+    SSMH_LOG_INFO("FachadaSSMH::inicializar", 
         "Inicializando Sistema de Monitoramento de Hidrômetros");
     
     // Subsistemas já foram inicializados, apenas registra
-    logManager.registrarInfo("FachadaSSMH::inicializar", 
+    SSMH_LOG_INFO("FachadaSSMH::inicializar", 
         "✓ Subsistema de Usuários: Operacional");
-    logManager.registrarInfo("FachadaSSMH::inicializar", 
+    SSMH_LOG_INFO("FachadaSSMH::inicializar", 
         "✓ Subsistema de Monitoramento: Operacional");
-    logManager.registrarInfo("FachadaSSMH::inicializar", 
+    SSMH_LOG_INFO("FachadaSSMH::inicializar", 
         "✓ Subsistema de Alertas: Operacional");
-    logManager.registrarInfo("FachadaSSMH::inicializar", 
+    SSMH_LOG_INFO("FachadaSSMH::inicializar", 
         "Sistema pronto para uso");
 }
 
 void FachadaSSMH::finalizar() {
-    logManager.registrarInfo("FachadaSSMH::finalizar", 
+    SSMH_LOG_INFO("FachadaSSMH::finalizar", 
         "Finalizando Sistema de Monitoramento de Hidrômetros");
     
     commandInvoker->limparHistorico();
     
-    logManager.registrarInfo("FachadaSSMH::finalizar", 
+    SSMH_LOG_INFO("FachadaSSMH::finalizar", 
         "Sistema finalizado com sucesso");
 }
 
 // ==================== FUNCIONALIDADE 1: GESTÃO DE USUÁRIOS ====================
 
 void FachadaSSMH::executarComandoUsuario(std::unique_ptr<UserCommand> comando) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"executarComandoUsuario\"");
+
     try {
         std::string descricao = comando->getDescricao();
-        logManager.registrarInfo("FachadaSSMH::executarComandoUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::executarComandoUsuario", 
             "Executando: " + descricao);
         
         commandInvoker->executarComando(std::move(comando));
         
-        logManager.registrarInfo("FachadaSSMH::executarComandoUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::executarComandoUsuario", 
             "Comando executado com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::executarComandoUsuario", 
@@ -63,9 +121,11 @@ void FachadaSSMH::executarComandoUsuario(std::unique_ptr<UserCommand> comando) {
 }
 
 bool FachadaSSMH::desfazerUltimoComando() {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"desfazerUltimoComando\"");
+
     try {
         if (!commandInvoker->podeDesfazer()) {
-            logManager.registrarAviso("FachadaSSMH::desfazerUltimoComando", 
+            SSMH_LOG_AVISO("FachadaSSMH::desfazerUltimoComando", 
                 "Nenhum comando para desfazer");
             return false;
         }
@@ -73,7 +133,7 @@ bool FachadaSSMH::desfazerUltimoComando() {
         bool resultado = commandInvoker->desfazer();
         
         if (resultado) {
-            logManager.registrarInfo("FachadaSSMH::desfazerUltimoComando", 
+            SSMH_LOG_INFO("FachadaSSMH::desfazerUltimoComando", 
                 "Comando desfeito com sucesso");
         } else {
             logManager.registrarErro("FachadaSSMH::desfazerUltimoComando", 
@@ -89,9 +149,11 @@ bool FachadaSSMH::desfazerUltimoComando() {
 }
 
 bool FachadaSSMH::refazerComando() {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"refazerComando\"");
+
     try {
         if (!commandInvoker->podeRefazer()) {
-            logManager.registrarAviso("FachadaSSMH::refazerComando", 
+            SSMH_LOG_AVISO("FachadaSSMH::refazerComando", 
                 "Nenhum comando para refazer");
             return false;
         }
@@ -99,7 +161,7 @@ bool FachadaSSMH::refazerComando() {
         bool resultado = commandInvoker->refazer();
         
         if (resultado) {
-            logManager.registrarInfo("FachadaSSMH::refazerComando", 
+            SSMH_LOG_INFO("FachadaSSMH::refazerComando", 
                 "Comando refeito com sucesso");
         } else {
             logManager.registrarErro("FachadaSSMH::refazerComando", 
@@ -115,14 +177,16 @@ bool FachadaSSMH::refazerComando() {
 }
 
 Usuario FachadaSSMH::criarUsuario(const std::map<std::string, std::string>& dados) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"criarUsuario\"");
+
     try {
         std::string nome = dados.count("nome") ? dados.at("nome") : "Desconhecido";
-        logManager.registrarInfo("FachadaSSMH::criarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::criarUsuario", 
             "Criando usuário: " + nome);
         
         Usuario usuario = usuarioService->criarUsuario(dados);
         
-        logManager.registrarInfo("FachadaSSMH::criarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::criarUsuario", 
             "Usuário criado com ID: " + std::to_string(usuario.getId()));
         
         return usuario;
@@ -134,13 +198,15 @@ Usuario FachadaSSMH::criarUsuario(const std::map<std::string, std::string>& dado
 }
 
 Usuario FachadaSSMH::buscarUsuario(int id) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"buscarUsuario\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::buscarUsuario", 
+        SSMH_LOG_DEBUG("FachadaSSMH::buscarUsuario", 
             "Buscando usuário ID: " + std::to_string(id));
         
         Usuario usuario = usuarioService->buscarUsuario(id);
         
-        logManager.registrarDebug("FachadaSSMH::buscarUsuario", 
+        SSMH_LOG_DEBUG("FachadaSSMH::buscarUsuario", 
             "Usuário encontrado: " + usuario.getNome());
         
         return usuario;
@@ -152,13 +218,15 @@ Usuario FachadaSSMH::buscarUsuario(int id) {
 }
 
 void FachadaSSMH::atualizarUsuario(int id, const std::map<std::string, std::string>& dados) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"atualizarUsuario\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::atualizarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::atualizarUsuario", 
             "Atualizando usuário ID: " + std::to_string(id));
         
         usuarioService->atualizarUsuario(id, dados);
         
-        logManager.registrarInfo("FachadaSSMH::atualizarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::atualizarUsuario", 
             "Usuário atualizado com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::atualizarUsuario", 
@@ -168,13 +236,15 @@ void FachadaSSMH::atualizarUsuario(int id, const std::map<std::string, std::stri
 }
 
 void FachadaSSMH::deletarUsuario(int id) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"deletarUsuario\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::deletarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::deletarUsuario", 
             "Deletando usuário ID: " + std::to_string(id));
         
         usuarioService->deletarUsuario(id);
         
-        logManager.registrarInfo("FachadaSSMH::deletarUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::deletarUsuario", 
             "Usuário deletado com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::deletarUsuario", 
@@ -184,13 +254,15 @@ void FachadaSSMH::deletarUsuario(int id) {
 }
 
 std::vector<Usuario> FachadaSSMH::listarUsuarios() {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"listarUsuarios\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::listarUsuarios", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarUsuarios", 
             "Listando todos os usuários");
         
         std::vector<Usuario> usuarios = usuarioService->listarUsuarios();
         
-        logManager.registrarDebug("FachadaSSMH::listarUsuarios", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarUsuarios", 
             "Total de usuários: " + std::to_string(usuarios.size()));
         
         return usuarios;
@@ -202,13 +274,18 @@ std::vector<Usuario> FachadaSSMH::listarUsuarios() {
 }
 
 void FachadaSSMH::vincularHidrometro(int idUser, const std::string& idSha) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"vincularHidrometro\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::vincularHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::vincularHidrometro", 
             "Vinculando SHA " + idSha + " ao usuário " + std::to_string(idUser));
         
         usuarioService->vincularHidrometro(idUser, idSha);
+        if (alertaService) {
+            alertaService->vincularHidrometro(idUser, idSha);
+        }
         
-        logManager.registrarInfo("FachadaSSMH::vincularHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::vincularHidrometro", 
             "Hidrômetro vinculado com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::vincularHidrometro", 
@@ -218,13 +295,18 @@ void FachadaSSMH::vincularHidrometro(int idUser, const std::string& idSha) {
 }
 
 void FachadaSSMH::desvincularHidrometro(int idUser, const std::string& idSha) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"desvincularHidrometro\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::desvincularHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::desvincularHidrometro", 
             "Desvinculando SHA " + idSha + " do usuário " + std::to_string(idUser));
         
         usuarioService->desvincularHidrometro(idUser, idSha);
+        if (alertaService) {
+            alertaService->desvincularHidrometro(idSha);
+        }
         
-        logManager.registrarInfo("FachadaSSMH::desvincularHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::desvincularHidrometro", 
             "Hidrômetro desvinculado com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::desvincularHidrometro", 
@@ -234,13 +316,15 @@ void FachadaSSMH::desvincularHidrometro(int idUser, const std::string& idSha) {
 }
 
 std::vector<std::string> FachadaSSMH::listarHidrometros(int idUser) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"listarHidrometros\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::listarHidrometros", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarHidrometros", 
             "Listando hidrômetros do usuário " + std::to_string(idUser));
         
         std::vector<std::string> hidrometros = usuarioService->listarHidrometros(idUser);
         
-        logManager.registrarDebug("FachadaSSMH::listarHidrometros", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarHidrometros", 
             "Total de hidrômetros: " + std::to_string(hidrometros.size()));
         
         return hidrometros;
@@ -252,13 +336,15 @@ std::vector<std::string> FachadaSSMH::listarHidrometros(int idUser) {
 }
 
 std::vector<Fatura> FachadaSSMH::listarContasDeAgua(int idUser) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"listarContasDeAgua\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::listarContasDeAgua", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarContasDeAgua", 
             "Listando contas do usuário " + std::to_string(idUser));
         
         std::vector<Fatura> faturas = usuarioService->listarContasDeAgua(idUser);
         
-        logManager.registrarDebug("FachadaSSMH::listarContasDeAgua", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarContasDeAgua", 
             "Total de faturas: " + std::to_string(faturas.size()));
         
         return faturas;
@@ -271,14 +357,16 @@ std::vector<Fatura> FachadaSSMH::listarContasDeAgua(int idUser) {
 
 void FachadaSSMH::adicionarFatura(int idUser, double valor, std::time_t dataVencimento, 
                                   const std::string& status) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"adicionarFatura\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::adicionarFatura", 
+        SSMH_LOG_INFO("FachadaSSMH::adicionarFatura", 
             "Adicionando fatura para usuário " + std::to_string(idUser) + 
             " no valor de R$ " + std::to_string(valor));
         
         usuarioService->adicionarFatura(idUser, valor, dataVencimento, status);
         
-        logManager.registrarInfo("FachadaSSMH::adicionarFatura", 
+        SSMH_LOG_INFO("FachadaSSMH::adicionarFatura", 
             "Fatura adicionada com sucesso");
     } catch (const std::exception& e) {
         logManager.registrarErro("FachadaSSMH::adicionarFatura", 
@@ -290,17 +378,19 @@ void FachadaSSMH::adicionarFatura(int idUser, double valor, std::time_t dataVenc
 // ==================== FUNCIONALIDADE 2: MONITORAMENTO DE CONSUMO ====================
 
 int FachadaSSMH::processarLeituraOCR(const std::string& idSha, const std::string& caminhoImagem) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"processarLeituraOCR\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::processarLeituraOCR", 
+        SSMH_LOG_INFO("FachadaSSMH::processarLeituraOCR", 
             "Processando imagem para SHA " + idSha);
         
         int idLeitura = monitoramentoService->processarLeitura(idSha, caminhoImagem);
         
         if (idLeitura > 0) {
-            logManager.registrarInfo("FachadaSSMH::processarLeituraOCR", 
+            SSMH_LOG_INFO("FachadaSSMH::processarLeituraOCR", 
                 "Leitura processada com sucesso. ID: " + std::to_string(idLeitura));
         } else {
-            logManager.registrarAviso("FachadaSSMH::processarLeituraOCR", 
+            SSMH_LOG_AVISO("FachadaSSMH::processarLeituraOCR", 
                 "Falha ao processar leitura");
         }
         
@@ -313,14 +403,20 @@ int FachadaSSMH::processarLeituraOCR(const std::string& idSha, const std::string
 }
 
 int FachadaSSMH::registrarLeituraManual(const std::string& idSha, int valor) {
+    return registrarLeituraManual(idSha, valor, std::time(nullptr));
+}
+
+int FachadaSSMH::registrarLeituraManual(const std::string& idSha, int valor, std::time_t dataHora) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"registrarLeituraManual\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::registrarLeituraManual", 
-            "Registrando leitura manual para SHA " + idSha + ": " + std::to_string(valor) + "L");
+        SSMH_LOGF_INFO("FachadaSSMH::registrarLeituraManual", 
+            "Registrando leitura manual para SHA {}: {}L", idSha, valor);
         
-        int idLeitura = monitoramentoService->registrarLeituraManual(idSha, valor);
+        int idLeitura = monitoramentoService->registrarLeituraManual(idSha, valor, dataHora);
         
-        logManager.registrarInfo("FachadaSSMH::registrarLeituraManual", 
-            "Leitura registrada com ID: " + std::to_string(idLeitura));
+        SSMH_LOGF_INFO("FachadaSSMH::registrarLeituraManual", 
+            "Leitura registrada com ID: {}", idLeitura);
         
         return idLeitura;
     } catch (const std::exception& e) {
@@ -335,13 +431,15 @@ double FachadaSSMH::monitorarConsumo(
     std::time_t dataInicio,
     std::time_t dataFim
 ) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"monitorarConsumo\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::monitorarConsumo", 
+        SSMH_LOG_DEBUG("FachadaSSMH::monitorarConsumo", 
             "Consultando consumo (método Composite)");
         
         double consumo = monitoramentoService->consultarConsumo(monitoravel, dataInicio, dataFim);
         
-        logManager.registrarDebug("FachadaSSMH::monitorarConsumo", 
+        SSMH_LOG_DEBUG("FachadaSSMH::monitorarConsumo", 
             "Consumo calculado: " + std::to_string(consumo) + "L");
         
         return consumo;
@@ -357,8 +455,10 @@ double FachadaSSMH::monitorarConsumoPorHidrometro(
     std::time_t dataInicio,
     std::time_t dataFim
 ) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"monitorarConsumoPorHidrometro\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::monitorarConsumoPorHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::monitorarConsumoPorHidrometro", 
             "Consultando consumo do hidrômetro " + idSha);
         
         // Constrói objeto Composite (Leaf)
@@ -368,7 +468,7 @@ double FachadaSSMH::monitorarConsumoPorHidrometro(
         double consumo = monitoramentoService->consultarConsumo(
             consumoHidrometro, dataInicio, dataFim);
         
-        logManager.registrarInfo("FachadaSSMH::monitorarConsumoPorHidrometro", 
+        SSMH_LOG_INFO("FachadaSSMH::monitorarConsumoPorHidrometro", 
             "Consumo: " + std::to_string(consumo) + "L");
         
         return consumo;
@@ -384,8 +484,10 @@ double FachadaSSMH::monitorarConsumoPorUsuario(
     std::time_t dataInicio,
     std::time_t dataFim
 ) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"monitorarConsumoPorUsuario\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::monitorarConsumoPorUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::monitorarConsumoPorUsuario", 
             "Consultando consumo do usuário " + std::to_string(idUsuario));
         
         // Coordena subsistemas: Usuários + Monitoramento
@@ -393,7 +495,7 @@ double FachadaSSMH::monitorarConsumoPorUsuario(
         std::vector<std::string> hidrometros = usuarioService->listarHidrometros(idUsuario);
         
         if (hidrometros.empty()) {
-            logManager.registrarAviso("FachadaSSMH::monitorarConsumoPorUsuario", 
+            SSMH_LOG_AVISO("FachadaSSMH::monitorarConsumoPorUsuario", 
                 "Usuário não possui hidrômetros vinculados");
             return 0.0;
         }
@@ -406,7 +508,7 @@ double FachadaSSMH::monitorarConsumoPorUsuario(
         double consumo = monitoramentoService->consultarConsumo(
             consumoUsuario, dataInicio, dataFim);
         
-        logManager.registrarInfo("FachadaSSMH::monitorarConsumoPorUsuario", 
+        SSMH_LOG_INFO("FachadaSSMH::monitorarConsumoPorUsuario", 
             "Consumo total de " + std::to_string(hidrometros.size()) + 
             " hidrômetros: " + std::to_string(consumo) + "L");
         
@@ -425,8 +527,10 @@ int FachadaSSMH::configurarRegraDeAlerta(
     const std::string& tipoEstrategia,
     const std::string& valorParametro
 ) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"configurarRegraDeAlerta\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::configurarRegraDeAlerta", 
+        SSMH_LOG_INFO("FachadaSSMH::configurarRegraDeAlerta", 
             "Configurando regra " + tipoEstrategia + " para usuário " + 
             std::to_string(idUsuario) + " com parâmetro: " + valorParametro);
         
@@ -437,8 +541,12 @@ int FachadaSSMH::configurarRegraDeAlerta(
         
         // Delega ao subsistema de alertas
         int regraId = alertaService->salvarRegra(idUsuario, tipoEstrategia, valorParametro);
+        if (regraId < 0) {
+            throw std::invalid_argument("Regra de alerta inválida: " + tipoEstrategia + 
+                                        " com parâmetro '" + valorParametro + "'");
+        }
         
-        logManager.registrarInfo("FachadaSSMH::configurarRegraDeAlerta", 
+        SSMH_LOG_INFO("FachadaSSMH::configurarRegraDeAlerta", 
             "Regra criada com ID: " + std::to_string(regraId));
         
         return regraId;
@@ -449,9 +557,28 @@ int FachadaSSMH::configurarRegraDeAlerta(
     }
 }
 
+int FachadaSSMH::executarVerificacaoAutomaticaAlertas(std::time_t dataInicio, std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"executarVerificacaoAutomaticaAlertas\"");
+
+    try {
+        int disparados = alertaService->executarVerificacaoAutomatica(dataInicio, dataFim);
+        
+        SSMH_LOGF_INFO("FachadaSSMH::executarVerificacaoAutomaticaAlertas", 
+            "Verificação automática concluída: {} alertas disparados", disparados);
+        
+        return disparados;
+    } catch (const std::exception& e) {
+        logManager.registrarErro("FachadaSSMH::executarVerificacaoAutomaticaAlertas", 
+            std::string("Erro na verificação automática: ") + e.what());
+        throw;
+    }
+}
+
 void FachadaSSMH::verificarAlertasUsuario(int idUsuario, double consumo) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"verificarAlertasUsuario\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::verificarAlertasUsuario", 
+        SSMH_LOG_DEBUG("FachadaSSMH::verificarAlertasUsuario", 
             "Verificando alertas para usuário " + std::to_string(idUsuario) + 
             " com consumo de " + std::to_string(consumo) + "L");
         
@@ -472,13 +599,15 @@ void FachadaSSMH::verificarAlertasUsuario(int idUsuario, double consumo) {
 }
 
 std::vector<AlertaAtivo> FachadaSSMH::listarAlertasAtivos() {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"listarAlertasAtivos\"");
+
     try {
-        logManager.registrarDebug("FachadaSSMH::listarAlertasAtivos", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarAlertasAtivos", 
             "Listando alertas ativos");
         
         std::vector<AlertaAtivo> alertas = alertaService->buscarAlertasAtivos();
         
-        logManager.registrarDebug("FachadaSSMH::listarAlertasAtivos", 
+        SSMH_LOG_DEBUG("FachadaSSMH::listarAlertasAtivos", 
             "Total de alertas: " + std::to_string(alertas.size()));
         
         return alertas;
@@ -490,17 +619,19 @@ std::vector<AlertaAtivo> FachadaSSMH::listarAlertasAtivos() {
 }
 
 bool FachadaSSMH::reconhecerAlerta(int alertaId) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"reconhecerAlerta\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::reconhecerAlerta", 
+        SSMH_LOG_INFO("FachadaSSMH::reconhecerAlerta", 
             "Reconhecendo alerta ID: " + std::to_string(alertaId));
         
         bool resultado = alertaService->resolverAlerta(alertaId);
         
         if (resultado) {
-            logManager.registrarInfo("FachadaSSMH::reconhecerAlerta", 
+            SSMH_LOG_INFO("FachadaSSMH::reconhecerAlerta", 
                 "Alerta reconhecido com sucesso");
         } else {
-            logManager.registrarAviso("FachadaSSMH::reconhecerAlerta", 
+            SSMH_LOG_AVISO("FachadaSSMH::reconhecerAlerta", 
                 "Alerta não encontrado ou já reconhecido");
         }
         
@@ -513,13 +644,15 @@ bool FachadaSSMH::reconhecerAlerta(int alertaId) {
 }
 
 void FachadaSSMH::configurarCanalNotificacao(const std::string& tipoNotificacao) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"configurarCanalNotificacao\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::configurarCanalNotificacao", 
+        SSMH_LOG_INFO("FachadaSSMH::configurarCanalNotificacao", 
             "Configurando canal de notificação: " + tipoNotificacao);
         
         // Por enquanto apenas loga, pois a implementação depende do AlertaService
         // TODO: Implementar troca de estratégia de notificação
-        logManager.registrarAviso("FachadaSSMH::configurarCanalNotificacao", 
+        SSMH_LOG_AVISO("FachadaSSMH::configurarCanalNotificacao", 
             "Método ainda não implementado no AlertaService");
         
     } catch (const std::exception& e) {
@@ -530,17 +663,19 @@ void FachadaSSMH::configurarCanalNotificacao(const std::string& tipoNotificacao)
 }
 
 bool FachadaSSMH::desativarRegraAlerta(int regraId) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"desativarRegraAlerta\"");
+
     try {
-        logManager.registrarInfo("FachadaSSMH::desativarRegraAlerta", 
+        SSMH_LOG_INFO("FachadaSSMH::desativarRegraAlerta", 
             "Desativando regra ID: " + std::to_string(regraId));
         
         bool resultado = alertaService->desativarRegra(regraId);
         
         if (resultado) {
-            logManager.registrarInfo("FachadaSSMH::desativarRegraAlerta", 
+            SSMH_LOG_INFO("FachadaSSMH::desativarRegraAlerta", 
                 "Regra desativada com sucesso");
         } else {
-            logManager.registrarAviso("FachadaSSMH::desativarRegraAlerta", 
+            SSMH_LOG_AVISO("FachadaSSMH::desativarRegraAlerta", 
                 "Regra não encontrada");
         }
         
@@ -555,6 +690,8 @@ bool FachadaSSMH::desativarRegraAlerta(int regraId) {
 // ==================== MÉTODOS AUXILIARES ====================
 
 bool FachadaSSMH::usuarioExiste(int id) {
+    SSMH_MEDIR_LATENCIA("ssmh_fachada_latencia_segundos", "operacao=\"usuarioExiste\"");
+
     try {
         return usuarioService->usuarioExiste(id);
     } catch (const std::exception& e) {
@@ -197,6 +197,13 @@ public:
      */
     int registrarLeituraManual(const std::string& idSha, int valor);
     
+    /**
+     * @brief Registra uma leitura manual com a data/hora em que foi feita
+     * 
+     * @param dataHora Timestamp da leitura (no lugar do instante atual)
+     */
+    int registrarLeituraManual(const std::string& idSha, int valor, std::time_t dataHora);
+    
     /**
      * @brief Monitora consumo usando padrão Composite
      * 
@@ -258,12 +265,15 @@ public:
      * Usa padrão Strategy para permitir diferentes algoritmos de análise:
      * - "LIMITE_DIARIO": Limite fixo por dia
      * - "MEDIA_MOVEL": Baseado em média histórica
-     * - "DETECCAO_VAZAMENTO": Detecção de consumo anormal
+     * - "DETECCAO_VAZAMENTO": Fluxo contínuo nas leituras dos hidrômetros
+     *   do usuário (não dispara pelo total diário)
      * 
      * @param idUsuario ID do usuário
      * @param tipoEstrategia Tipo de análise ("LIMITE_DIARIO", etc)
      * @param valorParametro Parâmetro da regra (ex: "70" para limite)
      * @return ID da regra criada
+     * @throws std::runtime_error se o usuário não existir
+     * @throws std::invalid_argument se a estratégia ou o parâmetro forem inválidos
      */
     int configurarRegraDeAlerta(
         int idUsuario,
@@ -285,6 +295,19 @@ public:
      */
     void verificarAlertasUsuario(int idUsuario, double consumo);
     
+    /**
+     * @brief Verifica as regras de todos os usuários com o consumo real
+     * 
+     * Coordena os três subsistemas: hidrômetros de cada usuário com regra
+     * ativa (Usuários), consumo do período numa consulta em lote
+     * (Monitoramento) e avaliação em lote das regras (Alertas).
+     * 
+     * @param dataInicio Início do período (0 = 24h antes de dataFim)
+     * @param dataFim Fim do período (0 = agora)
+     * @return Quantidade de alertas disparados
+     */
+    int executarVerificacaoAutomaticaAlertas(std::time_t dataInicio = 0, std::time_t dataFim = 0);
+    
     /**
      * @brief Lista todos os alertas ativos no sistema
      * 
@@ -7,7 +7,7 @@
 #include <sys/stat.h>
 
 AdaptadorOCR::AdaptadorOCR() {
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "AdaptadorOCR::AdaptadorOCR", 
         "Processador OCR inicializado");
 }
@@ -18,7 +18,7 @@ bool AdaptadorOCR::validarCaminho(const std::string& caminhoImagem) {
     bool existe = (stat(caminhoImagem.c_str(), &buffer) == 0);
     
     if (!existe) {
-        Logger::getInstance().log(LogLevel::WARNING, 
+        SSMH_LOG_AVISO(
             "AdaptadorOCR::validarCaminho", 
             "Arquivo não encontrado: " + caminhoImagem);
         return false;
@@ -30,7 +30,7 @@ bool AdaptadorOCR::validarCaminho(const std::string& caminhoImagem) {
                           extensao == "png" || extensao == "bmp");
     
     if (!extensaoValida) {
-        Logger::getInstance().log(LogLevel::WARNING, 
+        SSMH_LOG_AVISO(
             "AdaptadorOCR::validarCaminho", 
             "Extensão de imagem inválida: " + extensao);
         return false;
@@ -40,7 +40,7 @@ bool AdaptadorOCR::validarCaminho(const std::string& caminhoImagem) {
 }
 
 int AdaptadorOCR::extrairNumeros(const std::string& caminhoImagem) {
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "AdaptadorOCR::extrairNumeros", 
         "Processando imagem: " + caminhoImagem);
     
@@ -52,7 +52,7 @@ int AdaptadorOCR::extrairNumeros(const std::string& caminhoImagem) {
     // Simula o processamento OCR
     int valor = simularExtracao(caminhoImagem);
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "AdaptadorOCR::extrairNumeros", 
         "Valor extraído: " + std::to_string(valor) + "L");
     
@@ -73,7 +73,7 @@ int AdaptadorOCR::simularExtracao(const std::string& caminhoImagem) {
         std::uniform_int_distribution<> dis(10, 100);
         valor = dis(gen);
         
-        Logger::getInstance().log(LogLevel::DEBUG, 
+        SSMH_LOG_DEBUG(
             "AdaptadorOCR::simularExtracao", 
             "Valor simulado gerado: " + std::to_string(valor));
     }
@@ -8,7 +8,7 @@ ConsumoHidrometro::ConsumoHidrometro(const std::string& idSha, std::shared_ptr<L
 
 double ConsumoHidrometro::calcularConsumo(std::time_t dataInicio, std::time_t dataFim) {
     if (!repositorio_) {
-        Logger::getInstance().log(LogLevel::ERROR, 
+        SSMH_LOG_ERRO(
             "ConsumoHidrometro::calcularConsumo", 
             "Repositório não inicializado para SHA: " + idSha_);
         return 0.0;
@@ -16,7 +16,7 @@ double ConsumoHidrometro::calcularConsumo(std::time_t dataInicio, std::time_t da
     
     double consumo = repositorio_->consultarConsumo(idSha_, dataInicio, dataFim);
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "ConsumoHidrometro::calcularConsumo", 
         "SHA " + idSha_ + " - Consumo: " + std::to_string(consumo) + "L");
     
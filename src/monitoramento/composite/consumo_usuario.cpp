@@ -9,7 +9,7 @@ ConsumoUsuario::ConsumoUsuario(int idUsuario)
 void ConsumoUsuario::adicionarHidrometro(std::shared_ptr<ConsumoMonitoravel> hidrometro) {
     if (hidrometro) {
         hidrometros_.push_back(hidrometro);
-        Logger::getInstance().log(LogLevel::INFO, 
+        SSMH_LOG_INFO(
             "ConsumoUsuario::adicionarHidrometro", 
             "Hidrômetro " + hidrometro->obterIdentificador() + 
             " adicionado ao usuário " + std::to_string(idUsuario_));
@@ -21,7 +21,7 @@ void ConsumoUsuario::removerHidrometro(std::shared_ptr<ConsumoMonitoravel> hidro
     if (it != hidrometros_.end()) {
         std::string idHidrometro = (*it)->obterIdentificador();
         hidrometros_.erase(it);
-        Logger::getInstance().log(LogLevel::INFO, 
+        SSMH_LOG_INFO(
             "ConsumoUsuario::removerHidrometro", 
             "Hidrômetro " + idHidrometro + 
             " removido do usuário " + std::to_string(idUsuario_));
@@ -31,7 +31,7 @@ void ConsumoUsuario::removerHidrometro(std::shared_ptr<ConsumoMonitoravel> hidro
 double ConsumoUsuario::calcularConsumo(std::time_t dataInicio, std::time_t dataFim) {
     double consumoTotal = 0.0;
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "ConsumoUsuario::calcularConsumo", 
         "Calculando consumo do usuário " + std::to_string(idUsuario_) + 
         " com " + std::to_string(hidrometros_.size()) + " hidrômetros");
@@ -42,7 +42,7 @@ double ConsumoUsuario::calcularConsumo(std::time_t dataInicio, std::time_t dataF
         consumoTotal += consumo;
     }
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "ConsumoUsuario::calcularConsumo", 
         "Usuário " + std::to_string(idUsuario_) + 
         " - Consumo total: " + std::to_string(consumoTotal) + "L");
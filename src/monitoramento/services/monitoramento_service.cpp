@@ -1,5 +1,6 @@
 #include "monitoramento_service.hpp"
 #include "../../utils/logger.hpp"
+#include "../../utils/metricas.hpp"
 #include <stdexcept>
 
 MonitoramentoService::MonitoramentoService(
@@ -15,7 +16,7 @@ MonitoramentoService::MonitoramentoService(
         throw std::invalid_argument("LeituraDAO não pode ser nulo");
     }
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "MonitoramentoService::MonitoramentoService", 
         "Serviço de monitoramento inicializado");
 }
@@ -23,8 +24,9 @@ MonitoramentoService::MonitoramentoService(
 int MonitoramentoService::processarLeitura(
     const std::string& idSha, 
     const std::string& caminhoImagem) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"processarLeitura\"");
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "MonitoramentoService::processarLeitura", 
         "Processando leitura para SHA " + idSha);
     
@@ -37,19 +39,20 @@ int MonitoramentoService::processarLeitura(
         
         // Persiste no repositório
         if (repositorio_->salvarLeitura(leitura)) {
-            Logger::getInstance().log(LogLevel::INFO, 
+            notificarOuvintes(leitura);
+            SSMH_LOG_INFO(
                 "MonitoramentoService::processarLeitura", 
                 "Leitura processada com sucesso: " + std::to_string(valor) + "L");
             return leitura.getId();
         }
         
-        Logger::getInstance().log(LogLevel::ERROR, 
+        SSMH_LOG_ERRO(
             "MonitoramentoService::processarLeitura", 
             "Falha ao salvar leitura");
         return 0;
         
     } catch (const std::exception& e) {
-        Logger::getInstance().log(LogLevel::ERROR, 
+        SSMH_LOG_ERRO(
             "MonitoramentoService::processarLeitura", 
             "Erro ao processar leitura: " + std::string(e.what()));
         return 0;
@@ -57,14 +60,22 @@ int MonitoramentoService::processarLeitura(
 }
 
 int MonitoramentoService::registrarLeituraManual(const std::string& idSha, int valor) {
-    Logger::getInstance().log(LogLevel::INFO, 
+    return registrarLeituraManual(idSha, valor, std::time(nullptr));
+}
+
+int MonitoramentoService::registrarLeituraManual(const std::string& idSha, int valor,
+                                                 std::time_t dataHora) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"registrarLeituraManual\"");
+
+    SSMH_LOGF_INFO(
         "MonitoramentoService::registrarLeituraManual", 
-        "Registrando leitura manual para SHA " + idSha + ": " + std::to_string(valor) + "L");
+        "Registrando leitura manual para SHA {}: {}L", idSha, valor);
     
-    Leitura leitura(0, idSha, valor, std::time(nullptr));
+    Leitura leitura(0, idSha, valor, dataHora);
     
     if (repositorio_->salvarLeitura(leitura)) {
-        Logger::getInstance().log(LogLevel::INFO, 
+        notificarOuvintes(leitura);
+        SSMH_LOG_INFO(
             "MonitoramentoService::registrarLeituraManual", 
             "Leitura manual registrada com sucesso");
         return leitura.getId();
@@ -73,10 +84,22 @@ int MonitoramentoService::registrarLeituraManual(const std::string& idSha, int v
     return 0;
 }
 
+void MonitoramentoService::adicionarOuvinteLeitura(OuvinteLeitura ouvinte) {
+    if (ouvinte) {
+        ouvintesLeitura_.push_back(std::move(ouvinte));
+    }
+}
+
+void MonitoramentoService::notificarOuvintes(const Leitura& leitura) {
+    for (const auto& ouvinte : ouvintesLeitura_) {
+        ouvinte(leitura);
+    }
+}
+
 std::shared_ptr<ConsumoMonitoravel> MonitoramentoService::construirConsumoHidrometro(
     const std::string& idSha) {
     
-    Logger::getInstance().log(LogLevel::DEBUG, 
+    SSMH_LOG_DEBUG(
         "MonitoramentoService::construirConsumoHidrometro", 
         "Construindo ConsumoHidrometro para SHA " + idSha);
     
@@ -87,7 +110,7 @@ std::shared_ptr<ConsumoMonitoravel> MonitoramentoService::construirConsumoUsuari
     int idUsuario, 
     const std::vector<std::string>& listaShas) {
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "MonitoramentoService::construirConsumoUsuario", 
         "Construindo ConsumoUsuario para usuário " + std::to_string(idUsuario) + 
         " com " + std::to_string(listaShas.size()) + " hidrômetros");
@@ -108,15 +131,16 @@ double MonitoramentoService::consultarConsumo(
     std::shared_ptr<ConsumoMonitoravel> monitoravel,
     std::time_t dataInicio,
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"consultarConsumo\"");
     
     if (!monitoravel) {
-        Logger::getInstance().log(LogLevel::ERROR, 
+        SSMH_LOG_ERRO(
             "MonitoramentoService::consultarConsumo", 
             "ConsumoMonitoravel nulo");
         return 0.0;
     }
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "MonitoramentoService::consultarConsumo", 
         "Consultando consumo de " + monitoravel->obterDescricao());
     
@@ -128,6 +152,7 @@ double MonitoramentoService::consultarConsumoHidrometro(
     const std::string& idSha,
     std::time_t dataInicio,
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"consultarConsumoHidrometro\"");
     
     return repositorio_->consultarConsumo(idSha, dataInicio, dataFim);
 }
@@ -136,14 +161,40 @@ double MonitoramentoService::consultarConsumoAgregado(
     const std::vector<std::string>& listaShas,
     std::time_t dataInicio,
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"consultarConsumoAgregado\"");
     
     return repositorio_->consultarConsumoAgregado(listaShas, dataInicio, dataFim);
 }
 
+std::vector<double> MonitoramentoService::consultarConsumoEmLote(
+    const std::vector<std::vector<std::string>>& shasPorGrupo,
+    std::time_t dataInicio,
+    std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"consultarConsumoEmLote\"");
+    
+    std::vector<std::string> todosShas;
+    for (const auto& grupo : shasPorGrupo) {
+        todosShas.insert(todosShas.end(), grupo.begin(), grupo.end());
+    }
+    
+    std::vector<double> consumosSha = repositorio_->consultarConsumoEmLote(todosShas, dataInicio, dataFim);
+    
+    std::vector<double> consumos(shasPorGrupo.size(), 0.0);
+    size_t posicao = 0;
+    for (size_t i = 0; i < shasPorGrupo.size(); ++i) {
+        for (size_t j = 0; j < shasPorGrupo[i].size() && posicao < consumosSha.size(); ++j) {
+            consumos[i] += consumosSha[posicao++];
+        }
+    }
+    
+    return consumos;
+}
+
 std::vector<Leitura> MonitoramentoService::obterLeituras(
     const std::string& idSha,
     std::time_t dataInicio,
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"obterLeituras\"");
     
     return repositorio_->consultarLeituras(idSha, dataInicio, dataFim);
 }
@@ -151,12 +202,13 @@ std::vector<Leitura> MonitoramentoService::obterLeituras(
 double MonitoramentoService::calcularConsumoRecente(
     const std::string& idSha, 
     int periodoHoras) {
+    SSMH_MEDIR_LATENCIA("ssmh_monitoramento_latencia_segundos", "operacao=\"calcularConsumoRecente\"");
     
     // Calcula timestamps
     std::time_t agora = std::time(nullptr);
     std::time_t inicio = agora - (periodoHoras * 3600);
     
-    Logger::getInstance().log(LogLevel::DEBUG, 
+    SSMH_LOG_DEBUG(
         "MonitoramentoService::calcularConsumoRecente", 
         "Calculando consumo das últimas " + std::to_string(periodoHoras) + 
         "h para SHA " + idSha);
@@ -165,7 +217,7 @@ double MonitoramentoService::calcularConsumoRecente(
 }
 
 int MonitoramentoService::removerLeituras(const std::string& idSha) {
-    Logger::getInstance().log(LogLevel::WARNING, 
+    SSMH_LOG_AVISO(
         "MonitoramentoService::removerLeituras", 
         "Removendo leituras do SHA " + idSha);
     
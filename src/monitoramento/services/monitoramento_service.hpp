@@ -7,6 +7,7 @@
 #include "../composite/consumo_hidrometro.hpp"
 #include "../composite/consumo_usuario.hpp"
 #include "../domain/leitura.hpp"
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,11 @@
  */
 class MonitoramentoService {
 public:
+    /**
+     * @brief Callback chamado a cada leitura salva (ex: detecção de vazamento)
+     */
+    using OuvinteLeitura = std::function<void(const Leitura&)>;
+    
     /**
      * @brief Construtor
      * @param ocr Processador OCR para extrair dados de imagens
@@ -61,6 +67,20 @@ public:
      */
     int registrarLeituraManual(const std::string& idSha, int valor);
     
+    /**
+     * @brief Registra uma leitura manual feita em `dataHora` (ex: importação
+     * de leituras antigas, cargas sintéticas)
+     */
+    int registrarLeituraManual(const std::string& idSha, int valor, std::time_t dataHora);
+    
+    /**
+     * @brief Registra um ouvinte para as leituras salvas
+     * 
+     * Os ouvintes são chamados na thread que registrou a leitura, depois de
+     * persisti-la; devem ser adicionados na inicialização, antes das leituras.
+     */
+    void adicionarOuvinteLeitura(OuvinteLeitura ouvinte);
+    
     /**
      * @brief Constrói um objeto Composite para consultar consumo de um hidrômetro
      * @param idSha ID do hidrômetro
@@ -122,6 +142,22 @@ public:
         std::time_t dataInicio,
         std::time_t dataFim);
     
+    /**
+     * @brief Consulta em lote o consumo de vários grupos de hidrômetros
+     * 
+     * Cada grupo (ex: os hidrômetros de um usuário) tem seu consumo somado;
+     * todos os SHAs seguem numa única consulta ao repositório.
+     * 
+     * @param shasPorGrupo Hidrômetros de cada grupo
+     * @param dataInicio Timestamp de início
+     * @param dataFim Timestamp de fim
+     * @return Consumo total em litros de cada grupo, na mesma ordem
+     */
+    std::vector<double> consultarConsumoEmLote(
+        const std::vector<std::vector<std::string>>& shasPorGrupo,
+        std::time_t dataInicio,
+        std::time_t dataFim);
+    
     /**
      * @brief Obtém todas as leituras de um hidrômetro em um período
      * @param idSha ID do hidrômetro
@@ -172,8 +208,11 @@ public:
     std::shared_ptr<ProcessadorOCR> getOCR() const { return ocr_; }
     
 private:
+    void notificarOuvintes(const Leitura& leitura);
+    
     std::shared_ptr<ProcessadorOCR> ocr_;
     std::shared_ptr<LeituraDAO> repositorio_;
+    std::vector<OuvinteLeitura> ouvintesLeitura_;
 };
 
 #endif // MONITORAMENTO_SERVICE_HPP
@@ -70,6 +70,30 @@ public:
         std::time_t dataInicio,
         std::time_t dataFim) = 0;
     
+    /**
+     * @brief Calcula o consumo de cada hidrômetro da lista em uma única consulta
+     * 
+     * Mesmo critério de consultarConsumo(). A implementação padrão apenas
+     * repete consultarConsumo(); repositórios podem sobrescrevê-la para
+     * atender o lote de uma vez (ex: um único lock ou uma única query).
+     * 
+     * @param listaShas Lista de IDs de hidrômetros
+     * @param dataInicio Timestamp de início
+     * @param dataFim Timestamp de fim
+     * @return Consumo em litros de cada hidrômetro, na ordem de listaShas
+     */
+    virtual std::vector<double> consultarConsumoEmLote(
+        const std::vector<std::string>& listaShas,
+        std::time_t dataInicio,
+        std::time_t dataFim) {
+        std::vector<double> consumos;
+        consumos.reserve(listaShas.size());
+        for (const auto& idSha : listaShas) {
+            consumos.push_back(consultarConsumo(idSha, dataInicio, dataFim));
+        }
+        return consumos;
+    }
+    
     /**
      * @brief Remove todas as leituras de um hidrômetro
      * @param idSha ID do hidrômetro
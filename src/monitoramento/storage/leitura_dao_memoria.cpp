@@ -1,15 +1,17 @@
 #include "leitura_dao_memoria.hpp"
 #include "../../utils/logger.hpp"
+#include "../../utils/metricas.hpp"
 #include <algorithm>
 
 LeituraDAOMemoria::LeituraDAOMemoria() 
     : proximoId_(1) {
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "LeituraDAOMemoria::LeituraDAOMemoria", 
         "Repositório de leituras em memória inicializado");
 }
 
 bool LeituraDAOMemoria::salvarLeitura(const Leitura& leitura) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"salvarLeitura\"");
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Cria uma cópia com ID gerado se necessário
@@ -23,16 +25,20 @@ bool LeituraDAOMemoria::salvarLeitura(const Leitura& leitura) {
     
     // Indexa por SHA
     leiturasporSha_[novaLeitura.getIdSha()].push_back(novaLeitura.getId());
+
+    static ContadorMetrica& leiturasSalvas =
+        RegistroMetricas::getInstance().contador("ssmh_leituras_salvas_total");
+    leiturasSalvas.incrementar();
     
-    Logger::getInstance().log(LogLevel::DEBUG, 
+    SSMH_LOGF_DEBUG(
         "LeituraDAOMemoria::salvarLeitura", 
-        "Leitura ID " + std::to_string(novaLeitura.getId()) + 
-        " salva para SHA " + novaLeitura.getIdSha());
+        "Leitura ID {} salva para SHA {}", novaLeitura.getId(), novaLeitura.getIdSha());
     
     return true;
 }
 
 Leitura LeituraDAOMemoria::buscarLeitura(int id) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"buscarLeitura\"");
     std::lock_guard<std::mutex> lock(mutex_);
     
     auto it = leituras_.find(id);
@@ -47,6 +53,7 @@ std::vector<Leitura> LeituraDAOMemoria::consultarLeituras(
     const std::string& idSha, 
     std::time_t dataInicio, 
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"consultarLeituras\"");
     
     std::lock_guard<std::mutex> lock(mutex_);
     std::vector<Leitura> resultado;
@@ -79,6 +86,7 @@ double LeituraDAOMemoria::consultarConsumo(
     const std::string& idSha, 
     std::time_t dataInicio, 
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"consultarConsumo\"");
     
     auto leituras = consultarLeituras(idSha, dataInicio, dataFim);
     
@@ -91,10 +99,9 @@ double LeituraDAOMemoria::consultarConsumo(
     int valorInicial = leituras.front().getValor();
     double consumo = static_cast<double>(valorFinal - valorInicial);
     
-    Logger::getInstance().log(LogLevel::DEBUG, 
+    SSMH_LOGF_DEBUG(
         "LeituraDAOMemoria::consultarConsumo", 
-        "SHA " + idSha + ": " + std::to_string(leituras.size()) + 
-        " leituras, consumo = " + std::to_string(consumo) + "L");
+        "SHA {}: {} leituras, consumo = {}L", idSha, leituras.size(), consumo);
     
     return consumo > 0 ? consumo : 0.0;
 }
@@ -103,6 +110,7 @@ double LeituraDAOMemoria::consultarConsumoAgregado(
     const std::vector<std::string>& listaShas,
     std::time_t dataInicio,
     std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"consultarConsumoAgregado\"");
     
     double consumoTotal = 0.0;
     
@@ -110,7 +118,7 @@ double LeituraDAOMemoria::consultarConsumoAgregado(
         consumoTotal += consultarConsumo(idSha, dataInicio, dataFim);
     }
     
-    Logger::getInstance().log(LogLevel::DEBUG, 
+    SSMH_LOG_DEBUG(
         "LeituraDAOMemoria::consultarConsumoAgregado", 
         std::to_string(listaShas.size()) + " SHAs, consumo total = " + 
         std::to_string(consumoTotal) + "L");
@@ -118,6 +126,68 @@ double LeituraDAOMemoria::consultarConsumoAgregado(
     return consumoTotal;
 }
 
+std::vector<double> LeituraDAOMemoria::consultarConsumoEmLote(
+    const std::vector<std::string>& listaShas,
+    std::time_t dataInicio,
+    std::time_t dataFim) {
+    SSMH_MEDIR_LATENCIA("ssmh_leitura_dao_latencia_segundos", "operacao=\"consultarConsumoEmLote\"");
+    
+    std::vector<double> consumos;
+    consumos.reserve(listaShas.size());
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& idSha : listaShas) {
+        consumos.push_back(calcularConsumoSemLock(idSha, dataInicio, dataFim));
+    }
+    
+    SSMH_LOGF_DEBUG(
+        "LeituraDAOMemoria::consultarConsumoEmLote", 
+        "{} SHAs consultados em lote", listaShas.size());
+    
+    return consumos;
+}
+
+double LeituraDAOMemoria::calcularConsumoSemLock(
+    const std::string& idSha,
+    std::time_t dataInicio,
+    std::time_t dataFim) const {
+    auto it = leiturasporSha_.find(idSha);
+    if (it == leiturasporSha_.end()) {
+        return 0.0;
+    }
+    
+    // Mesmo critério de consultarConsumo: última menos primeira leitura do
+    // período, localizadas numa única passada
+    const Leitura* primeira = nullptr;
+    const Leitura* ultima = nullptr;
+    for (int idLeitura : it->second) {
+        auto itLeitura = leituras_.find(idLeitura);
+        if (itLeitura == leituras_.end()) {
+            continue;
+        }
+        
+        const Leitura& leitura = itLeitura->second;
+        std::time_t dataLeitura = leitura.getDataHora();
+        if (dataLeitura < dataInicio || dataLeitura > dataFim) {
+            continue;
+        }
+        
+        if (!primeira || dataLeitura < primeira->getDataHora()) {
+            primeira = &leitura;
+        }
+        if (!ultima || dataLeitura >= ultima->getDataHora()) {
+            ultima = &leitura;
+        }
+    }
+    
+    if (!primeira) {
+        return 0.0;
+    }
+    
+    double consumo = static_cast<double>(ultima->getValor() - primeira->getValor());
+    return consumo > 0 ? consumo : 0.0;
+}
+
 int LeituraDAOMemoria::removerLeituras(const std::string& idSha) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -134,7 +204,7 @@ int LeituraDAOMemoria::removerLeituras(const std::string& idSha) {
     
     leiturasporSha_.erase(it);
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "LeituraDAOMemoria::removerLeituras", 
         std::to_string(count) + " leituras removidas do SHA " + idSha);
     
@@ -158,7 +228,7 @@ void LeituraDAOMemoria::limpar() {
     leiturasporSha_.clear();
     proximoId_ = 1;
     
-    Logger::getInstance().log(LogLevel::INFO, 
+    SSMH_LOG_INFO(
         "LeituraDAOMemoria::limpar", 
         "Todas as leituras foram removidas");
 }
@@ -31,6 +31,10 @@ public:
         const std::vector<std::string>& listaShas,
         std::time_t dataInicio,
         std::time_t dataFim) override;
+    std::vector<double> consultarConsumoEmLote(
+        const std::vector<std::string>& listaShas,
+        std::time_t dataInicio,
+        std::time_t dataFim) override;
     int removerLeituras(const std::string& idSha) override;
     int contarLeituras(const std::string& idSha) override;
     
@@ -40,6 +44,14 @@ public:
     void limpar();
     
 private:
+    /**
+     * @brief Consumo de um SHA sem copiar nem ordenar leituras (mutex_ já obtido)
+     */
+    double calcularConsumoSemLock(
+        const std::string& idSha,
+        std::time_t dataInicio,
+        std::time_t dataFim) const;
+    
     // Mapa: ID da leitura -> Leitura
     std::map<int, Leitura> leituras_;
     
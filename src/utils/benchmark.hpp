@@ -0,0 +1,145 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <streambuf>
+#include <vector>
+#include <sys/resource.h>
+
+/**
+ * @brief Utilitários compartilhados pelos programas de benchmark (bench_*.cpp)
+ *
+ * Reúne a medição de tempo, a coleta de amostras de latência com cálculo
+ * de percentis e a leitura do pico de memória residente do processo.
+ */
+namespace Benchmark {
+
+/**
+ * @brief Cronômetro de alta resolução baseado em steady_clock
+ */
+class Cronometro {
+public:
+    Cronometro() : inicio_(std::chrono::steady_clock::now()) {}
+
+    void reiniciar() { inicio_ = std::chrono::steady_clock::now(); }
+
+    /**
+     * @brief Tempo decorrido desde a criação/reinício em nanossegundos
+     */
+    int64_t decorridoNs() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio_).count();
+    }
+
+    double decorridoSegundos() const {
+        return decorridoNs() / 1e9;
+    }
+
+private:
+    std::chrono::steady_clock::time_point inicio_;
+};
+
+/**
+ * @brief Conjunto de amostras de latência (em nanossegundos)
+ *
+ * Guarda todas as amostras para permitir percentis exatos; o custo de
+ * memória (8 bytes por amostra) é aceitável nos tamanhos usados nos benchmarks.
+ */
+class AmostrasLatencia {
+public:
+    void reservar(size_t n) { amostras_.reserve(n); }
+
+    void registrar(int64_t ns) {
+        amostras_.push_back(ns);
+        ordenado_ = false;
+    }
+
+    size_t quantidade() const { return amostras_.size(); }
+
+    /**
+     * @brief Percentil p (0-100) pelo método nearest-rank
+     *
+     * Menor amostra com pelo menos p% das amostras ≤ ela: posição
+     * ceil(p/100 × n), contando de 1 (o mesmo critério de HistogramaLatencia).
+     */
+    int64_t percentil(double p) {
+        if (amostras_.empty()) return 0;
+        ordenar();
+        size_t posicao = static_cast<size_t>(std::ceil(p * amostras_.size() / 100.0));
+        return amostras_[std::min(std::max<size_t>(posicao, 1), amostras_.size()) - 1];
+    }
+
+    double media() const {
+        if (amostras_.empty()) return 0.0;
+        long double soma = 0;
+        for (int64_t a : amostras_) soma += a;
+        return static_cast<double>(soma / amostras_.size());
+    }
+
+    int64_t maximo() {
+        if (amostras_.empty()) return 0;
+        ordenar();
+        return amostras_.back();
+    }
+
+    void limpar() {
+        amostras_.clear();
+        ordenado_ = true;
+    }
+
+private:
+    void ordenar() {
+        if (!ordenado_) {
+            std::sort(amostras_.begin(), amostras_.end());
+            ordenado_ = true;
+        }
+    }
+
+    std::vector<int64_t> amostras_;
+    bool ordenado_ = true;
+};
+
+/**
+ * @brief Pico de memória residente (RSS) do processo em KB
+ */
+inline long picoMemoriaKB() {
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) != 0) {
+        return 0;
+    }
+    return uso.ru_maxrss; // Linux: já em KB
+}
+
+/**
+ * @brief Descarta a saída de std::cout enquanto o objeto existir
+ *
+ * Os serviços imprimem mensagens de progresso no console; durante a carga
+ * de dados de um benchmark essa saída é ruído (e polui saídas em JSON).
+ */
+class SilenciarConsole {
+public:
+    SilenciarConsole() : anterior_(std::cout.rdbuf(&descarte_)) {}
+    ~SilenciarConsole() { std::cout.rdbuf(anterior_); }
+
+    SilenciarConsole(const SilenciarConsole&) = delete;
+    SilenciarConsole& operator=(const SilenciarConsole&) = delete;
+
+private:
+    // streambuf que aceita e descarta todos os caracteres
+    class BufferNulo : public std::streambuf {
+    protected:
+        int overflow(int c) override { return c; }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    BufferNulo descarte_;
+    std::streambuf* anterior_;
+};
+
+} // namespace Benchmark
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,77 @@
+#include "cache_timestamp.hpp"
+#include <chrono>
+#include <cstring>
+
+size_t CacheTimestamp::formatarAgora(char* destino, bool comMilissegundos) {
+    if (!comMilissegundos) {
+        return formatar(time(nullptr), -1, destino);
+    }
+
+    int64_t agoraMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return formatar(static_cast<time_t>(agoraMs / 1000), static_cast<int>(agoraMs % 1000), destino);
+}
+
+size_t CacheTimestamp::formatar(time_t instante, int milissegundos, char* destino) {
+    if (!lerCache(instante, destino)) {
+        tm ltm;
+        localtime_r(&instante, &ltm);
+        strftime(destino, TAMANHO + 1, "%Y-%m-%d %H:%M:%S", &ltm);
+
+        // Só avança: registros atrasados (ex: fila assíncrona) não
+        // devem derrubar o segundo corrente do cache
+        if (instante > segundo_.load(std::memory_order_relaxed)) {
+            publicar(instante, destino);
+        }
+    }
+
+    if (milissegundos < 0) {
+        destino[TAMANHO] = '\0';
+        return TAMANHO;
+    }
+
+    destino[TAMANHO] = '.';
+    destino[TAMANHO + 1] = static_cast<char>('0' + milissegundos / 100);
+    destino[TAMANHO + 2] = static_cast<char>('0' + (milissegundos / 10) % 10);
+    destino[TAMANHO + 3] = static_cast<char>('0' + milissegundos % 10);
+    destino[TAMANHO_MS] = '\0';
+    return TAMANHO_MS;
+}
+
+bool CacheTimestamp::lerCache(time_t instante, char* destino) const {
+    uint64_t antes = sequencia_.load(std::memory_order_acquire);
+    if ((antes & 1) != 0 || segundo_.load(std::memory_order_relaxed) != instante) {
+        return false;
+    }
+
+    uint64_t palavras[PALAVRAS];
+    for (size_t i = 0; i < PALAVRAS; ++i) {
+        palavras[i] = texto_[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequencia_.load(std::memory_order_relaxed) != antes) {
+        return false;
+    }
+
+    std::memcpy(destino, palavras, TAMANHO);
+    return true;
+}
+
+void CacheTimestamp::publicar(time_t instante, const char* texto) {
+    uint64_t atual = sequencia_.load(std::memory_order_relaxed);
+    if ((atual & 1) != 0 ||
+        !sequencia_.compare_exchange_strong(atual, atual + 1, std::memory_order_acquire)) {
+        return;  // Outra thread está publicando
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    uint64_t palavras[PALAVRAS] = {};
+    std::memcpy(palavras, texto, TAMANHO);
+    for (size_t i = 0; i < PALAVRAS; ++i) {
+        texto_[i].store(palavras[i], std::memory_order_relaxed);
+    }
+    segundo_.store(instante, std::memory_order_relaxed);
+
+    sequencia_.store(atual + 2, std::memory_order_release);
+}
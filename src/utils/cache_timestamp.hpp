@@ -0,0 +1,54 @@
+#ifndef CACHE_TIMESTAMP_HPP
+#define CACHE_TIMESTAMP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+/**
+ * @brief Timestamp "AAAA-MM-DD HH:MM:SS" formatado uma vez por segundo
+ *
+ * localtime_r + strftime custam centenas de nanossegundos (e o localtime
+ * consulta o fuso e toma um lock da libc); como todas as linhas do mesmo
+ * segundo têm o mesmo texto, ele é formatado uma vez e compartilhado entre
+ * as threads por um seqlock. Um acerto no cache são algumas leituras
+ * atômicas e a cópia de 19 bytes; os milissegundos, quando pedidos, são
+ * anexados à parte a cada chamada.
+ *
+ * Em uma falha (virada do segundo), a thread formata o texto ela mesma e
+ * tenta publicá-lo; quem perder a disputa apenas usa a própria cópia, sem
+ * esperar.
+ */
+class CacheTimestamp {
+public:
+    static constexpr size_t TAMANHO = 19;               // AAAA-MM-DD HH:MM:SS
+    static constexpr size_t TAMANHO_MS = TAMANHO + 4;   // .mmm
+    static constexpr size_t TAMANHO_BUFFER = TAMANHO_MS + 1;
+
+    /**
+     * @brief Escreve o instante atual em `destino` (terminado em '\0')
+     * @param destino Buffer com pelo menos TAMANHO_BUFFER bytes
+     * @return Quantidade de caracteres escritos
+     */
+    size_t formatarAgora(char* destino, bool comMilissegundos = false);
+
+    /**
+     * @brief Escreve `instante` (+ milissegundos opcionais) em `destino`
+     * @param milissegundos 0-999, ou negativo para omitir o sufixo
+     */
+    size_t formatar(time_t instante, int milissegundos, char* destino);
+
+private:
+    static constexpr size_t PALAVRAS = 3;  // 24 bytes comportam os 19 caracteres
+
+    bool lerCache(time_t instante, char* destino) const;
+    void publicar(time_t instante, const char* texto);
+
+    // Par = estável; ímpar = publicação em andamento
+    std::atomic<uint64_t> sequencia_{0};
+    std::atomic<int64_t> segundo_{-1};
+    std::atomic<uint64_t> texto_[PALAVRAS] = {};
+};
+
+#endif // CACHE_TIMESTAMP_HPP
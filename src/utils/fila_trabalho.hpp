@@ -0,0 +1,214 @@
+#ifndef FILA_TRABALHO_HPP
+#define FILA_TRABALHO_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief O que fazer com um item quando a fila está cheia
+ */
+enum class PoliticaFilaCheia {
+    DESCARTAR_MAIS_ANTIGO,  // Abre espaço removendo o item mais antigo da fila
+    DESCARTAR_NOVO          // Mantém a fila e descarta o item que chegou
+};
+
+/**
+ * @brief Fila com uma thread própria que processa os itens em ordem
+ *
+ * enfileirar() só guarda o item e retorna; a thread, criada no primeiro
+ * item, chama `processar` para cada um, fora do mutex da fila. Um item
+ * pode ter prazo: só é processado a partir dele, sem atrasar os demais.
+ *
+ * Com um processador de lotes, cada chamada recebe até `maxPorLote`
+ * itens de uma vez e quantos foram descartados desde o lote anterior;
+ * `maxLotesPorJanela` limita as chamadas por `janela`, e o que chega
+ * enquanto o limite está esgotado se junta ao lote seguinte.
+ *
+ * O destrutor processa o que ainda estiver na fila, sem esperar prazos,
+ * antes de encerrar a thread; por isso a fila deve ser declarada depois
+ * dos membros que `processar` usa. `processar` trata os próprios erros:
+ * uma exceção que escape dele encerra o programa.
+ */
+template <typename T>
+class FilaTrabalho {
+public:
+    struct Configuracao {
+        size_t capacidade = std::numeric_limits<size_t>::max();
+        PoliticaFilaCheia politica = PoliticaFilaCheia::DESCARTAR_NOVO;
+        size_t maxPorLote = 1;           // só com processador de lotes
+        size_t maxLotesPorJanela = 0;    // 0 = sem limite de taxa
+        std::chrono::milliseconds janela{1000};
+    };
+
+    using Processador = std::function<void(T&)>;
+    using ProcessadorLote = std::function<void(std::vector<T>& lote, uint64_t descartados)>;
+
+    explicit FilaTrabalho(Processador processar, Configuracao configuracao = {})
+        : FilaTrabalho(ProcessadorLote([processar = std::move(processar)](std::vector<T>& lote, uint64_t) {
+                           for (T& item : lote) {
+                               processar(item);
+                           }
+                       }),
+                       configuracao) {
+        configuracao_.maxPorLote = 1;
+    }
+
+    FilaTrabalho(ProcessadorLote processar, Configuracao configuracao)
+        : processar_(std::move(processar)), configuracao_(configuracao) {
+        configuracao_.capacidade = std::max<size_t>(1, configuracao_.capacidade);
+        configuracao_.maxPorLote = std::max<size_t>(1, configuracao_.maxPorLote);
+    }
+
+    ~FilaTrabalho() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            encerrar_ = true;
+        }
+        cvTarefa_.notify_one();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    FilaTrabalho(const FilaTrabalho&) = delete;
+    FilaTrabalho& operator=(const FilaTrabalho&) = delete;
+
+    /**
+     * @brief Enfileira o item (não bloqueia)
+     * @return false se a fila estava cheia e um item (o novo ou o mais
+     *         antigo, conforme a política) foi descartado
+     */
+    bool enfileirar(T item) {
+        return enfileirar(std::move(item), std::chrono::steady_clock::time_point::min());
+    }
+
+    /**
+     * @brief Enfileira o item para ser processado a partir de `prazo`
+     */
+    bool enfileirar(T item, std::chrono::steady_clock::time_point prazo) {
+        bool coube = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (fila_.size() >= configuracao_.capacidade) {
+                coube = false;
+                ++descartadosLote_;
+                descartados_.fetch_add(1, std::memory_order_relaxed);
+                if (configuracao_.politica == PoliticaFilaCheia::DESCARTAR_NOVO) {
+                    return false;
+                }
+                fila_.pop_front();
+            }
+            fila_.push_back({std::move(item), prazo});
+            ++enfileirados_;
+            if (!thread_.joinable()) {
+                thread_ = std::thread(&FilaTrabalho::executar, this);
+            }
+        }
+        cvTarefa_.notify_one();
+        return coube;
+    }
+
+    /**
+     * @brief Bloqueia até a fila esvaziar (inclusive os itens com prazo) e o
+     * item em andamento terminar
+     */
+    void aguardar() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cvConcluido_.wait(lock, [this] { return fila_.empty() && !ocupado_; });
+    }
+
+    uint64_t getDescartados() const { return descartados_.load(std::memory_order_relaxed); }
+
+private:
+    void executar() {
+        std::unique_lock<std::mutex> lock(mutex_);
+
+        while (true) {
+            cvTarefa_.wait(lock, [this] { return encerrar_ || !fila_.empty(); });
+            if (fila_.empty()) {
+                break;  // encerrar_ e nada pendente
+            }
+
+            // Primeiro item cujo prazo chegou; no encerramento, o primeiro da fila
+            auto agora = std::chrono::steady_clock::now();
+            auto proximoPrazo = std::chrono::steady_clock::time_point::max();
+            auto it = fila_.begin();
+            for (; it != fila_.end() && !encerrar_ && it->prazo > agora; ++it) {
+                proximoPrazo = std::min(proximoPrazo, it->prazo);
+            }
+            if (it == fila_.end()) {
+                uint64_t vistos = enfileirados_;
+                cvTarefa_.wait_until(lock, proximoPrazo,
+                                     [&] { return encerrar_ || enfileirados_ != vistos; });
+                continue;
+            }
+
+            // Limite de taxa esgotado: espera o lote mais antigo sair da janela
+            // enquanto os novos itens se juntam ao próximo lote
+            if (configuracao_.maxLotesPorJanela > 0 && !encerrar_) {
+                while (!lotesRecentes_.empty() && lotesRecentes_.front() + configuracao_.janela <= agora) {
+                    lotesRecentes_.pop_front();
+                }
+                if (lotesRecentes_.size() >= configuracao_.maxLotesPorJanela) {
+                    cvTarefa_.wait_until(lock, lotesRecentes_.front() + configuracao_.janela,
+                                         [this] { return encerrar_; });
+                    continue;
+                }
+                lotesRecentes_.push_back(agora);
+            }
+
+            std::vector<T> lote;
+            while (it != fila_.end() && lote.size() < configuracao_.maxPorLote) {
+                if (encerrar_ || it->prazo <= agora) {
+                    lote.push_back(std::move(it->valor));
+                    it = fila_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            uint64_t descartados = descartadosLote_;
+            descartadosLote_ = 0;
+            ocupado_ = true;
+            lock.unlock();
+
+            processar_(lote, descartados);
+
+            lock.lock();
+            ocupado_ = false;
+            cvConcluido_.notify_all();
+        }
+    }
+
+    struct Item {
+        T valor;
+        std::chrono::steady_clock::time_point prazo;
+    };
+
+    ProcessadorLote processar_;
+    Configuracao configuracao_;
+
+    std::mutex mutex_;
+    std::condition_variable cvTarefa_;
+    std::condition_variable cvConcluido_;
+    std::deque<Item> fila_;
+    uint64_t enfileirados_ = 0;  // acorda a espera por um prazo quando chega item novo
+    bool encerrar_ = false;
+    bool ocupado_ = false;
+    uint64_t descartadosLote_ = 0;
+    std::deque<std::chrono::steady_clock::time_point> lotesRecentes_;
+    std::atomic<uint64_t> descartados_{0};
+
+    std::thread thread_;
+};
+
+#endif // FILA_TRABALHO_HPP
@@ -0,0 +1,211 @@
+#include "log_binario.hpp"
+#include "rotacao_arquivos.hpp"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+// ==================== LogBinario ====================
+
+std::string LogBinario::substituirMarcadores(std::string_view formato,
+                                             const std::vector<std::string>& textos) {
+    std::string resultado;
+    resultado.reserve(formato.size() + 16 * textos.size());
+
+    size_t proximoTexto = 0;
+    size_t inicio = 0;
+    size_t marcador;
+    while ((marcador = formato.find("{}", inicio)) != std::string_view::npos) {
+        resultado.append(formato.substr(inicio, marcador - inicio));
+        if (proximoTexto < textos.size()) {
+            resultado += textos[proximoTexto++];
+        } else {
+            resultado += "{}";
+        }
+        inicio = marcador + 2;
+    }
+    resultado.append(formato.substr(inicio));
+
+    return resultado;
+}
+
+// ==================== ArquivoLogBinario ====================
+
+ArquivoLogBinario::~ArquivoLogBinario() {
+    fechar();
+}
+
+bool ArquivoLogBinario::abrir(const std::string& caminho, size_t tamanhoMaximoBytes, int maxArquivos) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (arquivo_.is_open()) {
+        gravarBuffer();
+        arquivo_.close();
+    }
+
+    caminho_ = caminho;
+    tamanhoMaximo_ = tamanhoMaximoBytes;
+    maxArquivos_ = maxArquivos;
+    buffer_.resize(2 * TAMANHO_BUFFER);
+
+    return abrirArquivoAtual();
+}
+
+void ArquivoLogBinario::fechar() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arquivo_.is_open()) {
+        gravarBuffer();
+        arquivo_.close();
+    }
+}
+
+bool ArquivoLogBinario::aberto() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return arquivo_.is_open();
+}
+
+void ArquivoLogBinario::descarregar() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (arquivo_.is_open()) {
+        gravarBuffer();
+        arquivo_.flush();
+    }
+}
+
+int64_t ArquivoLogBinario::agoraNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+uint16_t ArquivoLogBinario::internar(std::string_view texto) {
+    auto it = dicionario_.find(texto);
+    if (it != dicionario_.end()) {
+        return it->second;
+    }
+
+    uint16_t id = static_cast<uint16_t>(dicionario_.size());
+    dicionario_.emplace(std::string(texto), id);
+
+    uint16_t tamanho = static_cast<uint16_t>(std::min<size_t>(texto.size(), UINT16_MAX));
+    anexar(static_cast<uint8_t>(LogBinario::REGISTRO_TEXTO));
+    anexar(id);
+    anexar(tamanho);
+    anexarBytes(texto.data(), tamanho);
+
+    return id;
+}
+
+void ArquivoLogBinario::rotacionarSeNecessario() {
+    // Dicionário cheio também força um novo arquivo (ids de 16 bits)
+    bool tamanhoExcedido = tamanhoMaximo_ > 0 && bytesArquivo_ + usado_ >= tamanhoMaximo_;
+    bool dicionarioCheio = dicionario_.size() >= UINT16_MAX - 1;
+    if (!tamanhoExcedido && !dicionarioCheio) {
+        return;
+    }
+
+    gravarBuffer();
+    arquivo_.close();
+    rotacionarArquivos(caminho_, maxArquivos_);
+    abrirArquivoAtual();
+}
+
+void ArquivoLogBinario::gravarBuffer() {
+    if (usado_ == 0) {
+        return;
+    }
+    arquivo_.write(buffer_.data(), static_cast<std::streamsize>(usado_));
+    bytesArquivo_ += usado_;
+    usado_ = 0;
+}
+
+bool ArquivoLogBinario::abrirArquivoAtual() {
+    arquivo_.open(caminho_, std::ios::binary | std::ios::trunc);
+    dicionario_.clear();
+    usado_ = 0;
+    bytesArquivo_ = 0;
+
+    if (!arquivo_.is_open()) {
+        return false;
+    }
+
+    arquivo_.write(LogBinario::ASSINATURA, sizeof(LogBinario::ASSINATURA));
+    bytesArquivo_ = sizeof(LogBinario::ASSINATURA);
+    return true;
+}
+
+// ==================== LeitorLogBinario ====================
+
+LeitorLogBinario::LeitorLogBinario(const std::string& caminho)
+    : arquivo_(caminho, std::ios::binary) {
+    if (!arquivo_.is_open()) {
+        throw std::runtime_error("Não foi possível abrir " + caminho);
+    }
+
+    char assinatura[sizeof(LogBinario::ASSINATURA)];
+    if (!arquivo_.read(assinatura, sizeof(assinatura)) ||
+        std::memcmp(assinatura, LogBinario::ASSINATURA, sizeof(assinatura)) != 0) {
+        throw std::runtime_error("Arquivo não é um log binário do SSMH: " + caminho);
+    }
+}
+
+bool LeitorLogBinario::lerTexto(size_t tamanho, std::string& texto) {
+    texto.resize(tamanho);
+    return tamanho == 0 || static_cast<bool>(arquivo_.read(&texto[0], tamanho));
+}
+
+bool LeitorLogBinario::proximo(Registro& registro) {
+    uint8_t tipo;
+    while (ler(tipo)) {
+        if (tipo == LogBinario::REGISTRO_TEXTO) {
+            uint16_t id, tamanho;
+            std::string texto;
+            if (!ler(id) || !ler(tamanho) || !lerTexto(tamanho, texto)) {
+                return false;
+            }
+            dicionario_[id] = std::move(texto);
+            continue;
+        }
+
+        if (tipo != LogBinario::REGISTRO_MENSAGEM) {
+            return false;  // Arquivo corrompido
+        }
+
+        uint16_t idContexto, idFormato;
+        uint8_t numArgumentos;
+        if (!ler(registro.nivel) || !ler(idContexto) || !ler(idFormato) ||
+            !ler(registro.timestampNs) || !ler(numArgumentos)) {
+            return false;
+        }
+
+        std::vector<std::string> textos;
+        textos.reserve(numArgumentos);
+        for (uint8_t i = 0; i < numArgumentos; ++i) {
+            uint8_t tipoArgumento;
+            if (!ler(tipoArgumento)) {
+                return false;
+            }
+
+            if (tipoArgumento == LogBinario::ARG_INTEIRO) {
+                int64_t valor;
+                if (!ler(valor)) return false;
+                textos.push_back(std::to_string(valor));
+            } else if (tipoArgumento == LogBinario::ARG_REAL) {
+                double valor;
+                if (!ler(valor)) return false;
+                textos.push_back(std::to_string(valor));
+            } else if (tipoArgumento == LogBinario::ARG_TEXTO) {
+                uint32_t tamanho;
+                std::string texto;
+                if (!ler(tamanho) || !lerTexto(tamanho, texto)) return false;
+                textos.push_back(std::move(texto));
+            } else {
+                return false;
+            }
+        }
+
+        registro.contexto = dicionario_[idContexto];
+        registro.mensagem = LogBinario::substituirMarcadores(dicionario_[idFormato], textos);
+        return true;
+    }
+
+    return false;
+}
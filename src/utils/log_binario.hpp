@@ -0,0 +1,211 @@
+#ifndef LOG_BINARIO_HPP
+#define LOG_BINARIO_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Formato binário estruturado do log (arquivos .blog)
+ *
+ * Arquivo: assinatura de 8 bytes seguida de registros. Inteiros em ordem
+ * de bytes do host (o decodificador roda na mesma arquitetura).
+ *
+ * - TEXTO:    [u8 tipo][u16 id][u16 tamanho][bytes]
+ *             Entrada do dicionário (contextos e formatos), emitida antes do
+ *             primeiro uso em cada arquivo, de modo que cada arquivo
+ *             rotacionado seja decodificável sozinho.
+ * - MENSAGEM: [u8 tipo][u8 nível][u16 id contexto][u16 id formato]
+ *             [i64 timestamp ns][u8 nº args] + args
+ * - Argumento: [u8 tipo] + i64 | f64 | [u32 tamanho][bytes]
+ *
+ * O formato usa "{}" como marcador de cada argumento.
+ */
+namespace LogBinario {
+
+constexpr char ASSINATURA[8] = {'S', 'S', 'M', 'H', 'L', 'O', 'G', '1'};
+
+enum TipoRegistro : uint8_t {
+    REGISTRO_TEXTO = 1,
+    REGISTRO_MENSAGEM = 2
+};
+
+enum TipoArgumento : uint8_t {
+    ARG_INTEIRO = 1,
+    ARG_REAL = 2,
+    ARG_TEXTO = 3
+};
+
+/**
+ * @brief Substitui cada "{}" do formato pelo próximo texto da lista
+ */
+std::string substituirMarcadores(std::string_view formato, const std::vector<std::string>& textos);
+
+template <typename T>
+std::string paraTexto(const T& valor) {
+    if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+        return std::to_string(valor);
+    } else {
+        return std::string(std::string_view(valor));
+    }
+}
+
+/**
+ * @brief Renderiza formato + argumentos no mesmo texto que o decodificador gera
+ */
+template <typename... Args>
+std::string formatar(std::string_view formato, const Args&... args) {
+    return substituirMarcadores(formato, {paraTexto(args)...});
+}
+
+} // namespace LogBinario
+
+/**
+ * @brief Escritor de log binário com rotação por tamanho
+ *
+ * registrar() apenas copia bytes para um buffer em memória (sob um mutex
+ * de curta duração); o buffer vai para o disco quando passa de 64 KB, em
+ * descarregar() ou ao fechar. Ao atingir o tamanho máximo, o arquivo é
+ * rotacionado (caminho.1, caminho.2, ...) e o dicionário recomeça.
+ */
+class ArquivoLogBinario {
+public:
+    ArquivoLogBinario() = default;
+    ~ArquivoLogBinario();
+
+    ArquivoLogBinario(const ArquivoLogBinario&) = delete;
+    ArquivoLogBinario& operator=(const ArquivoLogBinario&) = delete;
+
+    /**
+     * @return true se o arquivo foi aberto
+     */
+    bool abrir(const std::string& caminho, size_t tamanhoMaximoBytes, int maxArquivos);
+    void fechar();
+    bool aberto() const;
+
+    template <typename... Args>
+    void registrar(uint8_t nivel, std::string_view contexto, std::string_view formato,
+                   const Args&... args) {
+        static_assert(sizeof...(Args) < 256, "Argumentos demais para um registro");
+        int64_t timestampNs = agoraNs();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!arquivo_.is_open()) {
+            return;
+        }
+        rotacionarSeNecessario();
+
+        uint16_t idContexto = internar(contexto);
+        uint16_t idFormato = internar(formato);
+
+        anexar(static_cast<uint8_t>(LogBinario::REGISTRO_MENSAGEM));
+        anexar(nivel);
+        anexar(idContexto);
+        anexar(idFormato);
+        anexar(timestampNs);
+        anexar(static_cast<uint8_t>(sizeof...(Args)));
+        (anexarArgumento(args), ...);
+
+        if (usado_ >= TAMANHO_BUFFER) {
+            gravarBuffer();
+        }
+    }
+
+    /**
+     * @brief Grava no disco o que estiver no buffer
+     */
+    void descarregar();
+
+private:
+    static constexpr size_t TAMANHO_BUFFER = 64 * 1024;
+
+    static int64_t agoraNs();
+
+    template <typename T>
+    void anexar(const T& valor) {
+        anexarBytes(&valor, sizeof(T));
+    }
+
+    void anexarBytes(const void* dados, size_t tamanho) {
+        if (usado_ + tamanho > buffer_.size()) {
+            buffer_.resize(std::max(buffer_.size() * 2, usado_ + tamanho));
+        }
+        std::memcpy(buffer_.data() + usado_, dados, tamanho);
+        usado_ += tamanho;
+    }
+
+    template <typename T>
+    void anexarArgumento(const T& valor) {
+        if constexpr (std::is_integral_v<T>) {
+            anexar(static_cast<uint8_t>(LogBinario::ARG_INTEIRO));
+            anexar(static_cast<int64_t>(valor));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            anexar(static_cast<uint8_t>(LogBinario::ARG_REAL));
+            anexar(static_cast<double>(valor));
+        } else {
+            std::string_view texto(valor);
+            anexar(static_cast<uint8_t>(LogBinario::ARG_TEXTO));
+            anexar(static_cast<uint32_t>(texto.size()));
+            anexarBytes(texto.data(), texto.size());
+        }
+    }
+
+    uint16_t internar(std::string_view texto);
+    void rotacionarSeNecessario();
+    void gravarBuffer();
+    bool abrirArquivoAtual();
+
+    mutable std::mutex mutex_;
+    std::ofstream arquivo_;
+    std::string caminho_;
+    size_t tamanhoMaximo_ = 0;
+    int maxArquivos_ = 1;
+    size_t bytesArquivo_ = 0;
+    std::vector<char> buffer_;  // cresce só para registros maiores que a folga
+    size_t usado_ = 0;
+    std::map<std::string, uint16_t, std::less<>> dicionario_;
+};
+
+/**
+ * @brief Leitor sequencial de um arquivo de log binário
+ */
+class LeitorLogBinario {
+public:
+    struct Registro {
+        uint8_t nivel = 0;
+        int64_t timestampNs = 0;
+        std::string contexto;
+        std::string mensagem;
+    };
+
+    /**
+     * @throws std::runtime_error se o arquivo não abrir ou não for um log binário
+     */
+    explicit LeitorLogBinario(const std::string& caminho);
+
+    /**
+     * @brief Lê a próxima mensagem (entradas de dicionário são consumidas)
+     * @return false no fim do arquivo ou em registro truncado
+     */
+    bool proximo(Registro& registro);
+
+private:
+    template <typename T>
+    bool ler(T& valor) {
+        return static_cast<bool>(arquivo_.read(reinterpret_cast<char*>(&valor), sizeof(T)));
+    }
+
+    bool lerTexto(size_t tamanho, std::string& texto);
+
+    std::ifstream arquivo_;
+    std::map<uint16_t, std::string> dicionario_;
+};
+
+#endif // LOG_BINARIO_HPP
@@ -1,29 +1,83 @@
 #include "logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 
 bool Logger::showDebug = false;
 bool Logger::runtimeStarted = false;
 Logger* Logger::instance_ = nullptr;
 std::mutex Logger::mutex_;
 
+// Intervalo máximo entre duas gravações da thread de escrita
+static const std::chrono::milliseconds INTERVALO_ESCRITA(50);
+
+/**
+ * @brief Mensagem enfileirada no modo assíncrono (formatada só na escrita)
+ */
+struct Logger::RegistroLog {
+    LogLevel level = LogLevel::INFO;
+    bool console = false;
+    time_t instante = 0;
+    int16_t milissegundos = -1;  // -1: sem milissegundos no timestamp
+    std::string contexto;
+    std::string mensagem;
+};
+
+/**
+ * @brief Buffer circular de uma thread produtora (um produtor, um consumidor)
+ *
+ * Apenas a thread dona avança `cauda` e apenas a thread de escrita avança
+ * `cabeca`; os slots são reaproveitados (as strings mantêm a capacidade).
+ */
+struct Logger::BufferThread {
+    explicit BufferThread(size_t capacidade) : registros(capacidade) {}
+
+    std::vector<RegistroLog> registros;
+    alignas(64) std::atomic<size_t> cabeca{0};
+    alignas(64) std::atomic<size_t> cauda{0};
+    std::atomic<bool> produzindo{false};  // dona dentro de enfileirar()
+    std::atomic<bool> encerrado{false};   // thread dona já terminou
+};
+
 // Construtor privado
-Logger::Logger() : usarArquivo_(false) {
+Logger::Logger()
+    : usarArquivo_(false),
+      rotacaoTamanhoMaximo_(0),
+      rotacaoIdadeMaxima_(0),
+      rotacaoMaxArquivos_(5),
+      rotacaoComprimir_(false),
+      bytesArquivo_(0),
+      aberturaArquivo_(0),
+      sequenciaRotacao_(0),
+      timestampMilissegundos_(false),
+      modoBinario_(false),
+      modoAssincrono_(false),
+      executando_(false),
+      capacidadeBuffer_(8192),
+      descartadas_(0),
+      pedidosDescarga_(0),
+      descargasAtendidas_(0) {
 }
 
 // Destrutor
 Logger::~Logger() {
+    setModoAssincrono(false);
     fecharArquivo();
 }
 
 // Método Singleton
 Logger& Logger::getInstance() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (instance_ == nullptr) {
+    // Inicialização de estática local é thread-safe: o acesso não
+    // precisa do mutex global
+    static Logger* instancia = [] {
         instance_ = new Logger();
-    }
-    return *instance_;
+        return instance_;
+    }();
+    return *instancia;
 }
 
 void Logger::setArquivoLog(const std::string& caminho) {
+    descarregar();
     std::lock_guard<std::mutex> lock(mutex_);
     
     // Fecha arquivo anterior se houver
@@ -32,8 +86,7 @@ void Logger::setArquivoLog(const std::string& caminho) {
     }
     
     caminhoArquivo_ = caminho;
-    arquivoLog_.open(caminhoArquivo_, std::ios::app);
-    usarArquivo_ = arquivoLog_.is_open();
+    abrirArquivoTexto();
     
     if (usarArquivo_) {
         arquivoLog_ << "\n========== Nova Sessão: " << getTimestamp() << " ==========\n";
@@ -41,25 +94,151 @@ void Logger::setArquivoLog(const std::string& caminho) {
     }
 }
 
+void Logger::abrirArquivoTexto() {
+    arquivoLog_.open(caminhoArquivo_, std::ios::app);
+    usarArquivo_ = arquivoLog_.is_open();
+    
+    // Em modo append a posição inicial não reflete o tamanho do arquivo
+    arquivoLog_.seekp(0, std::ios::end);
+    std::streamoff tamanho = usarArquivo_ ? static_cast<std::streamoff>(arquivoLog_.tellp()) : 0;
+    bytesArquivo_ = tamanho > 0 ? static_cast<size_t>(tamanho) : 0;
+    aberturaArquivo_ = time(nullptr);
+}
+
+void Logger::setRotacao(size_t tamanhoMaximoBytes, long idadeMaximaSegundos,
+                        int maxArquivos, bool comprimir) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rotacaoTamanhoMaximo_ = tamanhoMaximoBytes;
+    rotacaoIdadeMaxima_ = static_cast<time_t>(idadeMaximaSegundos);
+    rotacaoMaxArquivos_ = maxArquivos < 1 ? 1 : maxArquivos;
+    rotacaoComprimir_ = comprimir;
+    garantirDescargaNoEncerramento();
+}
+
+void Logger::rotacionarSeNecessario(size_t bytesNovos) {
+    bool porTamanho = rotacaoTamanhoMaximo_ > 0 && bytesArquivo_ > 0 &&
+                      bytesArquivo_ + bytesNovos > rotacaoTamanhoMaximo_;
+    bool porIdade = rotacaoIdadeMaxima_ > 0 &&
+                    time(nullptr) - aberturaArquivo_ >= rotacaoIdadeMaxima_;
+    if (!porTamanho && !porIdade) {
+        return;
+    }
+    
+    arquivoLog_.close();
+    
+    if (rotacaoComprimir_) {
+        // Só o rename acontece aqui; deslocar a série e comprimir fica
+        // com a thread do compressor
+        std::string pendente = caminhoArquivo_ + ".pendente." + std::to_string(++sequenciaRotacao_);
+        if (std::rename(caminhoArquivo_.c_str(), pendente.c_str()) == 0) {
+            compressor_.enfileirar(pendente, caminhoArquivo_, rotacaoMaxArquivos_);
+        }
+    } else {
+        rotacionarArquivos(caminhoArquivo_, rotacaoMaxArquivos_);
+    }
+    
+    abrirArquivoTexto();
+}
+
 void Logger::log(LogLevel level, const std::string& contexto, const std::string& mensagem) {
+    if (modoBinario_.load(std::memory_order_acquire)) {
+        arquivoBinario_.registrar(static_cast<uint8_t>(level), contexto, "{}", mensagem);
+        if (deveIrParaConsole(level)) {
+            escreverConsole(level, contexto, mensagem);
+        }
+        return;
+    }
+    
+    if (modoAssincrono_.load(std::memory_order_acquire) && enfileirar(level, contexto, mensagem)) {
+        return;
+    }
+    
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::string logLine = "[" + getTimestamp() + "] [" + getLevelString(level) + "] " +
-                          "[" + contexto + "] " + mensagem;
+    char timestamp[CacheTimestamp::TAMANHO_BUFFER];
+    size_t tamanhoTimestamp = cacheTimestamp_.formatarAgora(
+        timestamp, timestampMilissegundos_.load(std::memory_order_relaxed));
+    
+    std::string logLine;
+    anexarLinha(logLine, std::string_view(timestamp, tamanhoTimestamp), level, contexto, mensagem);
     
     // Log em arquivo
     if (usarArquivo_ && arquivoLog_.is_open()) {
-        arquivoLog_ << logLine << std::endl;
+        rotacionarSeNecessario(logLine.size());
+        arquivoLog_.write(logLine.data(), static_cast<std::streamsize>(logLine.size()));
         arquivoLog_.flush();
+        bytesArquivo_ += logLine.size();
     }
     
     // Log no console (apenas para INFO, WARNING, ERROR se não estiver em runtime)
-    if (!runtimeStarted && (level == LogLevel::INFO || level == LogLevel::WARNING || level == LogLevel::ERROR)) {
-        std::cout << logLine << std::endl;
+    if (deveIrParaConsole(level)) {
+        std::cout << logLine << std::flush;
+    }
+}
+
+void Logger::anexarLinha(std::string& destino, std::string_view timestamp, LogLevel level,
+                         const std::string& contexto, const std::string& mensagem) {
+    if (destino.empty()) {
+        destino.reserve(timestamp.size() + contexto.size() + mensagem.size() + 24);
     }
+    destino += '[';
+    destino += timestamp;
+    destino += "] [";
+    destino += nomeNivel(level);
+    destino += "] [";
+    destino += contexto;
+    destino += "] ";
+    destino += mensagem;
+    destino += '\n';
+}
+
+void Logger::setTimestampMilissegundos(bool ativo) {
+    timestampMilissegundos_.store(ativo, std::memory_order_relaxed);
+}
+
+bool Logger::deveIrParaConsole(LogLevel level) const {
+    return !runtimeStarted &&
+           (level == LogLevel::INFO || level == LogLevel::WARNING || level == LogLevel::ERROR);
+}
+
+void Logger::escreverConsole(LogLevel level, const std::string& contexto, const std::string& mensagem) {
+    std::string linha;
+    anexarLinha(linha, getTimestamp(), level, contexto, mensagem);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::cout << linha << std::flush;
+}
+
+bool Logger::setArquivoLogBinario(const std::string& caminho, size_t tamanhoMaximoBytes, int maxArquivos) {
+    bool aberto = arquivoBinario_.abrir(caminho, tamanhoMaximoBytes, maxArquivos);
+    modoBinario_.store(aberto, std::memory_order_release);
+    if (aberto) {
+        garantirDescargaNoEncerramento();
+    }
+    return aberto;
+}
+
+void Logger::fecharArquivoBinario() {
+    modoBinario_.store(false, std::memory_order_release);
+    arquivoBinario_.fechar();
+}
+
+void Logger::garantirDescargaNoEncerramento() {
+    // O Singleton nunca é destruído: sem isso o que estiver em buffer
+    // (modo assíncrono ou binário) se perderia ao fim do programa
+    static std::once_flag registrado;
+    std::call_once(registrado, [] {
+        std::atexit([] {
+            Logger& logger = Logger::getInstance();
+            logger.setModoAssincrono(false);
+            logger.arquivoBinario_.descarregar();
+            logger.compressor_.aguardar();
+        });
+    });
 }
 
 void Logger::fecharArquivo() {
+    descarregar();
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (arquivoLog_.is_open()) {
@@ -70,6 +249,10 @@ void Logger::fecharArquivo() {
 }
 
 std::string Logger::getLevelString(LogLevel level) const {
+    return nomeNivel(level);
+}
+
+const char* Logger::nomeNivel(LogLevel level) {
     switch (level) {
         case LogLevel::STARTUP:  return "STARTUP";
         case LogLevel::SHUTDOWN: return "SHUTDOWN";
@@ -83,12 +266,226 @@ std::string Logger::getLevelString(LogLevel level) const {
 }
 
 std::string Logger::getTimestamp() const {
-    time_t now = time(nullptr);
-    tm* ltm = localtime(&now);
+    char buffer[CacheTimestamp::TAMANHO_BUFFER];
+    size_t tamanho = cacheTimestamp_.formatarAgora(
+        buffer, timestampMilissegundos_.load(std::memory_order_relaxed));
+    return std::string(buffer, tamanho);
+}
+
+// ==================== Modo assíncrono ====================
+
+void Logger::setModoAssincrono(bool ativo, size_t capacidadePorThread) {
+    if (ativo == modoAssincrono_.load()) {
+        return;
+    }
+    
+    if (ativo) {
+        // Vale para os buffers criados a partir de agora
+        capacidadeBuffer_ = std::max<size_t>(capacidadePorThread, 1);
+        executando_.store(true);
+        threadEscrita_ = std::thread(&Logger::executarEscrita, this);
+        
+        garantirDescargaNoEncerramento();
+        
+        modoAssincrono_.store(true, std::memory_order_release);
+    } else {
+        // Quem ainda vir o modo ligado já marcou o buffer como em produção:
+        // espera essas mensagens entrarem no buffer antes da última drenagem
+        modoAssincrono_.store(false);
+        {
+            std::lock_guard<std::mutex> lock(mutexBuffers_);
+            for (const auto& buffer : buffers_) {
+                while (buffer->produzindo.load()) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutexDescarga_);
+            executando_.store(false);
+        }
+        cvEscrita_.notify_one();
+        if (threadEscrita_.joinable()) {
+            threadEscrita_.join();
+        }
+    }
+}
+
+void Logger::descarregar() {
+    arquivoBinario_.descarregar();
+    
+    if (!executando_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (arquivoLog_.is_open()) {
+            arquivoLog_.flush();
+        }
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(mutexDescarga_);
+    uint64_t pedido = ++pedidosDescarga_;
+    cvEscrita_.notify_one();
+    cvDescarga_.wait(lock, [&] {
+        return descargasAtendidas_ >= pedido || !executando_.load();
+    });
+}
+
+Logger::BufferThread& Logger::bufferDaThread() {
+    // Ao terminar a thread o buffer é marcado e removido pela thread de
+    // escrita assim que estiver vazio
+    struct Portador {
+        std::shared_ptr<BufferThread> buffer;
+        ~Portador() {
+            if (buffer) buffer->encerrado.store(true, std::memory_order_release);
+        }
+    };
+    thread_local Portador portador;
+    
+    if (!portador.buffer) {
+        portador.buffer = std::make_shared<BufferThread>(capacidadeBuffer_);
+        std::lock_guard<std::mutex> lock(mutexBuffers_);
+        buffers_.push_back(portador.buffer);
+    }
+    return *portador.buffer;
+}
+
+bool Logger::enfileirar(LogLevel level, const std::string& contexto, const std::string& mensagem) {
+    BufferThread& buffer = bufferDaThread();
+    
+    // Marca e só então confere o modo (ambos seq_cst): ou setModoAssincrono(false)
+    // vê a marca e espera, ou esta thread vê o modo desligado e grava direto
+    buffer.produzindo.store(true);
+    if (!modoAssincrono_.load()) {
+        buffer.produzindo.store(false, std::memory_order_release);
+        return false;
+    }
+    
+    size_t capacidade = buffer.registros.size();
+    size_t cauda = buffer.cauda.load(std::memory_order_relaxed);
     
-    char buffer[20];
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", ltm);
-    return std::string(buffer);
+    if (cauda - buffer.cabeca.load(std::memory_order_acquire) >= capacidade) {
+        descartadas_.fetch_add(1, std::memory_order_relaxed);
+        buffer.produzindo.store(false, std::memory_order_release);
+        return true;
+    }
+    
+    RegistroLog& registro = buffer.registros[cauda % capacidade];
+    registro.level = level;
+    registro.console = deveIrParaConsole(level);
+    if (timestampMilissegundos_.load(std::memory_order_relaxed)) {
+        int64_t agoraMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        registro.instante = static_cast<time_t>(agoraMs / 1000);
+        registro.milissegundos = static_cast<int16_t>(agoraMs % 1000);
+    } else {
+        registro.instante = time(nullptr);
+        registro.milissegundos = -1;
+    }
+    registro.contexto.assign(contexto);
+    registro.mensagem.assign(mensagem);
+    
+    buffer.cauda.store(cauda + 1, std::memory_order_release);
+    buffer.produzindo.store(false, std::memory_order_release);
+    return true;
+}
+
+void Logger::drenarBuffers(std::string& loteArquivo, std::string& loteConsole) {
+    char timestamp[CacheTimestamp::TAMANHO_BUFFER];
+    
+    std::vector<std::shared_ptr<BufferThread>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(mutexBuffers_);
+        buffers = buffers_;
+    }
+    
+    bool haEncerrados = false;
+    for (const auto& buffer : buffers) {
+        bool encerrado = buffer->encerrado.load(std::memory_order_acquire);
+        size_t capacidade = buffer->registros.size();
+        size_t cabeca = buffer->cabeca.load(std::memory_order_relaxed);
+        size_t cauda = buffer->cauda.load(std::memory_order_acquire);
+        
+        for (size_t i = cabeca; i != cauda; ++i) {
+            const RegistroLog& registro = buffer->registros[i % capacidade];
+            
+            size_t tamanhoTimestamp = cacheTimestamp_.formatar(
+                registro.instante, registro.milissegundos, timestamp);
+            
+            size_t inicioLinha = loteArquivo.size();
+            anexarLinha(loteArquivo, std::string_view(timestamp, tamanhoTimestamp),
+                        registro.level, registro.contexto, registro.mensagem);
+            
+            if (registro.console) {
+                loteConsole.append(loteArquivo, inicioLinha, std::string::npos);
+            }
+        }
+        
+        buffer->cabeca.store(cauda, std::memory_order_release);
+        haEncerrados = haEncerrados || encerrado;
+    }
+    
+    if (haEncerrados) {
+        std::lock_guard<std::mutex> lock(mutexBuffers_);
+        buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+            [](const std::shared_ptr<BufferThread>& b) {
+                return b->encerrado.load(std::memory_order_acquire) &&
+                       b->cabeca.load() == b->cauda.load();
+            }), buffers_.end());
+    }
+}
+
+void Logger::executarEscrita() {
+    std::string loteArquivo;
+    std::string loteConsole;
+    uint64_t descartadasReportadas = 0;
+    
+    while (true) {
+        uint64_t pedido;
+        bool continuar;
+        {
+            std::unique_lock<std::mutex> lock(mutexDescarga_);
+            cvEscrita_.wait_for(lock, INTERVALO_ESCRITA, [&] {
+                return !executando_.load() || pedidosDescarga_ != descargasAtendidas_;
+            });
+            pedido = pedidosDescarga_;
+            continuar = executando_.load();
+        }
+        
+        loteArquivo.clear();
+        loteConsole.clear();
+        drenarBuffers(loteArquivo, loteConsole);
+        
+        uint64_t descartadas = descartadas_.load(std::memory_order_relaxed);
+        if (descartadas != descartadasReportadas) {
+            loteArquivo += "[" + getTimestamp() + "] [WARNING] [Logger] " +
+                std::to_string(descartadas - descartadasReportadas) +
+                " mensagens descartadas (buffer cheio)\n";
+            descartadasReportadas = descartadas;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!loteArquivo.empty() && usarArquivo_ && arquivoLog_.is_open()) {
+                rotacionarSeNecessario(loteArquivo.size());
+                arquivoLog_.write(loteArquivo.data(), loteArquivo.size());
+                arquivoLog_.flush();
+                bytesArquivo_ += loteArquivo.size();
+            }
+            if (!loteConsole.empty()) {
+                std::cout << loteConsole << std::flush;
+            }
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(mutexDescarga_);
+            descargasAtendidas_ = pedido;
+        }
+        cvDescarga_.notify_all();
+        
+        if (!continuar) {
+            break;
+        }
+    }
 }
 
 // Métodos estáticos originais (mantidos para compatibilidade)
@@ -158,7 +555,7 @@ void Logger::registrarErro(const std::string& contexto, const std::string& mensa
 }
 
 void Logger::registrarDebug(const std::string& contexto, const std::string& mensagem) {
-    if (showDebug) {
+    if (nivelHabilitado(LogLevel::DEBUG)) {
         log(LogLevel::DEBUG, contexto, mensagem);
     }
 }
@@ -7,6 +7,25 @@
 #include <fstream>
 #include <mutex>
 #include <ctime>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "cache_timestamp.hpp"
+#include "log_binario.hpp"
+#include "rotacao_arquivos.hpp"
+
+/**
+ * @brief Nível mínimo compilado para as macros SSMH_LOG_*
+ *
+ * 0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR. Chamadas abaixo do nível
+ * são removidas na compilação (ex: -DSSMH_LOG_NIVEL_MINIMO=1 em produção).
+ */
+#ifndef SSMH_LOG_NIVEL_MINIMO
+#define SSMH_LOG_NIVEL_MINIMO 0
+#endif
 
 enum class LogLevel {
     STARTUP,    // Logs de inicialização
@@ -28,7 +47,45 @@ private:
     static std::mutex mutex_;
     std::ofstream arquivoLog_;
     std::string caminhoArquivo_;
-    bool usarArquivo_;
+    std::atomic<bool> usarArquivo_;
+    
+    // Rotação do arquivo texto (protegida por mutex_)
+    size_t rotacaoTamanhoMaximo_;
+    time_t rotacaoIdadeMaxima_;
+    int rotacaoMaxArquivos_;
+    bool rotacaoComprimir_;
+    size_t bytesArquivo_;
+    time_t aberturaArquivo_;
+    uint64_t sequenciaRotacao_;
+    CompressorRotacao compressor_;
+    
+    // Texto do timestamp compartilhado entre as threads (ver cache_timestamp.hpp)
+    mutable CacheTimestamp cacheTimestamp_;
+    std::atomic<bool> timestampMilissegundos_;
+    
+    // Modo binário: substitui o arquivo texto (ver log_binario.hpp)
+    ArquivoLogBinario arquivoBinario_;
+    std::atomic<bool> modoBinario_;
+    
+    // Modo assíncrono: um buffer circular por thread produtora, drenado
+    // por uma thread de escrita que formata e grava em lote
+    struct RegistroLog;
+    struct BufferThread;
+    
+    std::atomic<bool> modoAssincrono_;
+    std::atomic<bool> executando_;
+    std::thread threadEscrita_;
+    size_t capacidadeBuffer_;
+    std::atomic<uint64_t> descartadas_;
+    
+    std::mutex mutexBuffers_;  // protege apenas o registro de buffers
+    std::vector<std::shared_ptr<BufferThread>> buffers_;
+    
+    std::mutex mutexDescarga_;
+    std::condition_variable cvEscrita_;
+    std::condition_variable cvDescarga_;
+    uint64_t pedidosDescarga_;
+    uint64_t descargasAtendidas_;
     
     // Construtor privado para Singleton
     Logger();
@@ -55,6 +112,118 @@ public:
     void log(LogLevel level, const std::string& contexto, const std::string& mensagem);
     void fecharArquivo();
     
+    /**
+     * @brief Acrescenta milissegundos ao timestamp das linhas (AAAA-MM-DD HH:MM:SS.mmm)
+     */
+    void setTimestampMilissegundos(bool ativo);
+    
+    /**
+     * @brief Configura a rotação do arquivo texto
+     *
+     * O arquivo é rotacionado (app.log → app.log.1, ...) ao passar de
+     * `tamanhoMaximoBytes` ou após `idadeMaximaSegundos` aberto (0 desliga
+     * cada critério); são mantidos `maxArquivos` anteriores. Com `comprimir`,
+     * o arquivo rotacionado vira app.log.N.gz numa thread em segundo plano:
+     * quem está logando só paga um rename e a reabertura do arquivo.
+     */
+    void setRotacao(size_t tamanhoMaximoBytes, long idadeMaximaSegundos = 0,
+                    int maxArquivos = 5, bool comprimir = true);
+    
+    /**
+     * @brief Liga/desliga o modo assíncrono
+     *
+     * Ligado, log() apenas copia a mensagem para o buffer da thread que
+     * chamou (sem locks); uma thread de escrita formata e grava em lote.
+     * Cada buffer guarda até `capacidadePorThread` mensagens: com o buffer
+     * cheio a mensagem é descartada e contabilizada. Ao desligar (ou no
+     * encerramento do processo) as mensagens pendentes são gravadas,
+     * inclusive as de threads que estavam enfileirando naquele instante;
+     * as chamadas seguintes gravam direto.
+     */
+    void setModoAssincrono(bool ativo, size_t capacidadePorThread = 8192);
+    bool isModoAssincrono() const { return modoAssincrono_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Bloqueia até que todas as mensagens enfileiradas estejam no arquivo
+     */
+    void descarregar();
+    
+    /**
+     * @brief Liga o modo binário estruturado, gravando em `caminho`
+     *
+     * Enquanto ativo, as mensagens vão para o arquivo binário (decodificável
+     * com a ferramenta logdecode) no lugar do arquivo texto. Ao passar de
+     * `tamanhoMaximoBytes` o arquivo é rotacionado, mantendo `maxArquivos`
+     * anteriores. O console continua recebendo texto como antes.
+     *
+     * @return true se o arquivo foi aberto
+     */
+    bool setArquivoLogBinario(const std::string& caminho,
+                              size_t tamanhoMaximoBytes = 64 * 1024 * 1024,
+                              int maxArquivos = 5);
+    void fecharArquivoBinario();
+    bool isModoBinario() const { return modoBinario_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Registra uma mensagem com argumentos tipados
+     *
+     * `formato` usa "{}" para cada argumento (inteiros, reais ou textos).
+     * No modo binário os argumentos são copiados sem formatação; nos demais
+     * modos a mensagem é montada e segue pelo log() normal.
+     */
+    template <typename... Args>
+    void logEstruturado(LogLevel level, const char* contexto, const char* formato, const Args&... args) {
+        if (modoBinario_.load(std::memory_order_acquire)) {
+            arquivoBinario_.registrar(static_cast<uint8_t>(level), contexto, formato, args...);
+            if (deveIrParaConsole(level)) {
+                escreverConsole(level, contexto, LogBinario::formatar(formato, args...));
+            }
+            return;
+        }
+        log(level, contexto, LogBinario::formatar(formato, args...));
+    }
+    
+    /**
+     * @brief Nome do nível como aparece no log texto
+     */
+    static const char* nomeNivel(LogLevel level);
+    
+    /**
+     * @brief Total de mensagens descartadas por buffer cheio no modo assíncrono
+     */
+    uint64_t getMensagensDescartadas() const { return descartadas_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief Indica se uma mensagem do nível chegaria a algum destino
+     *
+     * DEBUG exige o modo debug e arquivo (texto ou binário) aberto; INFO/WARNING/ERROR exigem
+     * arquivo aberto ou console fora do modo runtime. Usado pelas macros
+     * SSMH_LOG_* para só montar a mensagem quando ela será gravada.
+     */
+    bool nivelHabilitado(LogLevel level) const {
+        bool arquivo = usarArquivo_.load(std::memory_order_relaxed) ||
+                       modoBinario_.load(std::memory_order_relaxed);
+        switch (level) {
+            case LogLevel::DEBUG:
+                return showDebug && arquivo;
+            case LogLevel::INFO:
+            case LogLevel::WARNING:
+            case LogLevel::ERROR:
+                return arquivo || !runtimeStarted;
+            default:
+                return arquivo;
+        }
+    }
+    
+    /**
+     * @brief Severidade do nível na escala de SSMH_LOG_NIVEL_MINIMO
+     */
+    static constexpr int severidade(LogLevel level) {
+        return level == LogLevel::DEBUG   ? 0 :
+               level == LogLevel::WARNING ? 2 :
+               level == LogLevel::ERROR   ? 3 : 1;
+    }
+    
     // Métodos de conveniência para a Fachada
     void registrarInfo(const std::string& contexto, const std::string& mensagem);
     void registrarErro(const std::string& contexto, const std::string& mensagem);
@@ -64,6 +233,64 @@ public:
 private:
     std::string getLevelString(LogLevel level) const;
     std::string getTimestamp() const;
+    
+    bool deveIrParaConsole(LogLevel level) const;
+    void abrirArquivoTexto();
+    void rotacionarSeNecessario(size_t bytesNovos);
+    void escreverConsole(LogLevel level, const std::string& contexto, const std::string& mensagem);
+    static void anexarLinha(std::string& destino, std::string_view timestamp, LogLevel level,
+                            const std::string& contexto, const std::string& mensagem);
+    static void garantirDescargaNoEncerramento();
+    // false se o modo assíncrono foi desligado nesse meio tempo (grava-se direto)
+    bool enfileirar(LogLevel level, const std::string& contexto, const std::string& mensagem);
+    BufferThread& bufferDaThread();
+    void executarEscrita();
+    void drenarBuffers(std::string& loteArquivo, std::string& loteConsole);
 };
 
+/**
+ * @brief Registra no log montando a mensagem só se o nível estiver ativo
+ *
+ * A expressão da mensagem (concatenações, std::to_string...) não é avaliada
+ * quando o nível está abaixo de SSMH_LOG_NIVEL_MINIMO (código removido na
+ * compilação) ou quando nenhum destino aceitaria a mensagem.
+ *
+ * Exemplo: SSMH_LOG_DEBUG("Classe::metodo", "ID: " + std::to_string(id));
+ */
+#define SSMH_LOG(level, contexto, mensagem)                                   \
+    do {                                                                      \
+        if constexpr (Logger::severidade(level) >= SSMH_LOG_NIVEL_MINIMO) {   \
+            Logger& loggerSsmh_ = Logger::getInstance();                      \
+            if (loggerSsmh_.nivelHabilitado(level)) {                         \
+                loggerSsmh_.log(level, contexto, mensagem);                   \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define SSMH_LOG_DEBUG(contexto, mensagem) SSMH_LOG(LogLevel::DEBUG, contexto, mensagem)
+#define SSMH_LOG_INFO(contexto, mensagem)  SSMH_LOG(LogLevel::INFO, contexto, mensagem)
+#define SSMH_LOG_AVISO(contexto, mensagem) SSMH_LOG(LogLevel::WARNING, contexto, mensagem)
+#define SSMH_LOG_ERRO(contexto, mensagem)  SSMH_LOG(LogLevel::ERROR, contexto, mensagem)
+
+/**
+ * @brief Versão com argumentos tipados: SSMH_LOGF(nível, contexto, formato, args...)
+ *
+ * Exemplo: SSMH_LOGF_DEBUG("Classe::metodo", "Leitura {} do SHA {}", id, sha);
+ * No modo binário os argumentos são apenas copiados para o buffer.
+ */
+#define SSMH_LOGF(level, contexto, ...)                                       \
+    do {                                                                      \
+        if constexpr (Logger::severidade(level) >= SSMH_LOG_NIVEL_MINIMO) {   \
+            Logger& loggerSsmh_ = Logger::getInstance();                      \
+            if (loggerSsmh_.nivelHabilitado(level)) {                         \
+                loggerSsmh_.logEstruturado(level, contexto, __VA_ARGS__);     \
+            }                                                                 \
+        }                                                                     \
+    } while (0)
+
+#define SSMH_LOGF_DEBUG(contexto, ...) SSMH_LOGF(LogLevel::DEBUG, contexto, __VA_ARGS__)
+#define SSMH_LOGF_INFO(contexto, ...)  SSMH_LOGF(LogLevel::INFO, contexto, __VA_ARGS__)
+#define SSMH_LOGF_AVISO(contexto, ...) SSMH_LOGF(LogLevel::WARNING, contexto, __VA_ARGS__)
+#define SSMH_LOGF_ERRO(contexto, ...)  SSMH_LOGF(LogLevel::ERROR, contexto, __VA_ARGS__)
+
 #endif
@@ -0,0 +1,225 @@
+#include "metricas.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+// ==================== ContadorMetrica ====================
+
+size_t ContadorMetrica::indiceFatiaThread() {
+    static std::atomic<size_t> proximaFatia{0};
+    thread_local size_t indice =
+        proximaFatia.fetch_add(1, std::memory_order_relaxed) % NUM_FATIAS;
+    return indice;
+}
+
+uint64_t ContadorMetrica::valor() const {
+    uint64_t total = 0;
+    for (const auto& fatia : fatias_) {
+        total += fatia.valor.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// ==================== HistogramaLatencia ====================
+
+int HistogramaLatencia::indiceBucket(uint64_t ns) {
+    if (ns < static_cast<uint64_t>(SUBFAIXAS)) {
+        return static_cast<int>(ns);
+    }
+
+    int expoente = 63 - __builtin_clzll(ns);
+    if (expoente > EXPOENTE_MAXIMO) {
+        return NUM_BUCKETS - 1;
+    }
+
+    int subfaixa = static_cast<int>((ns >> (expoente - BITS_SUBFAIXA)) & (SUBFAIXAS - 1));
+    return (expoente - BITS_SUBFAIXA + 1) * SUBFAIXAS + subfaixa;
+}
+
+uint64_t HistogramaLatencia::limiteSuperior(int indice) {
+    if (indice < SUBFAIXAS) {
+        return static_cast<uint64_t>(indice);
+    }
+
+    int grupo = indice / SUBFAIXAS;
+    int subfaixa = indice % SUBFAIXAS;
+    int deslocamento = grupo - 1;  // expoente - BITS_SUBFAIXA
+
+    uint64_t inferior = static_cast<uint64_t>(SUBFAIXAS + subfaixa) << deslocamento;
+    return inferior + (uint64_t(1) << deslocamento) - 1;
+}
+
+std::vector<uint64_t> HistogramaLatencia::copiarBuckets() const {
+    std::vector<uint64_t> copia(NUM_BUCKETS);
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        copia[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    return copia;
+}
+
+ResumoHistograma HistogramaLatencia::resumir() const {
+    ResumoHistograma resumo;
+    std::vector<uint64_t> buckets = copiarBuckets();
+
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        resumo.contagem += buckets[i];
+        if (buckets[i] > 0) {
+            resumo.maxNs = limiteSuperior(i);
+        }
+    }
+    resumo.somaNs = somaNs();
+
+    if (resumo.contagem == 0) {
+        return resumo;
+    }
+
+    // Percentis pelo limite superior do bucket que contém a posição desejada
+    auto posicao = [&](double p) {
+        uint64_t alvo = static_cast<uint64_t>(p * resumo.contagem + 0.999999);
+        return alvo == 0 ? 1 : alvo;
+    };
+    uint64_t alvo50 = posicao(0.50), alvo90 = posicao(0.90), alvo99 = posicao(0.99);
+
+    uint64_t acumulado = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        if (buckets[i] == 0) continue;
+        uint64_t anterior = acumulado;
+        acumulado += buckets[i];
+        if (anterior < alvo50 && acumulado >= alvo50) resumo.p50Ns = limiteSuperior(i);
+        if (anterior < alvo90 && acumulado >= alvo90) resumo.p90Ns = limiteSuperior(i);
+        if (anterior < alvo99 && acumulado >= alvo99) resumo.p99Ns = limiteSuperior(i);
+    }
+
+    return resumo;
+}
+
+// ==================== RegistroMetricas ====================
+
+RegistroMetricas& RegistroMetricas::getInstance() {
+    // Nunca destruído: referências estáticas às métricas podem ser usadas
+    // por outras threads durante o encerramento do processo
+    static RegistroMetricas* instancia = new RegistroMetricas();
+    return *instancia;
+}
+
+ContadorMetrica& RegistroMetricas::contador(const std::string& nome, const std::string& rotulos) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = contadores_[Chave(nome, rotulos)];
+    if (!slot) {
+        slot = std::make_unique<ContadorMetrica>();
+    }
+    return *slot;
+}
+
+HistogramaLatencia& RegistroMetricas::histograma(const std::string& nome, const std::string& rotulos) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = histogramas_[Chave(nome, rotulos)];
+    if (!slot) {
+        slot = std::make_unique<HistogramaLatencia>();
+    }
+    return *slot;
+}
+
+SnapshotMetricas RegistroMetricas::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    SnapshotMetricas snap;
+
+    for (const auto& par : contadores_) {
+        snap.contadores.push_back({par.first.first, par.first.second, par.second->valor()});
+    }
+
+    for (const auto& par : histogramas_) {
+        snap.histogramas.push_back({par.first.first, par.first.second, par.second->resumir()});
+    }
+
+    return snap;
+}
+
+namespace {
+
+// Monta o bloco de rótulos combinando os rótulos da métrica com um extra
+std::string rotulosPrometheus(const std::string& rotulos, const std::string& extra = "") {
+    if (rotulos.empty() && extra.empty()) return "";
+    if (rotulos.empty()) return "{" + extra + "}";
+    if (extra.empty()) return "{" + rotulos + "}";
+    return "{" + rotulos + "," + extra + "}";
+}
+
+} // namespace
+
+std::string RegistroMetricas::exportarPrometheus() const {
+    // Limites dos buckets exportados (em segundos)
+    static const double limitesSegundos[] = {
+        1e-6, 5e-6, 1e-5, 2.5e-5, 5e-5, 1e-4, 2.5e-4, 5e-4,
+        1e-3, 2.5e-3, 5e-3, 1e-2, 2.5e-2, 5e-2, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream saida;
+
+    std::string familiaAtual;
+    for (const auto& par : contadores_) {
+        const std::string& nome = par.first.first;
+        if (nome != familiaAtual) {
+            saida << "# TYPE " << nome << " counter\n";
+            familiaAtual = nome;
+        }
+        saida << nome << rotulosPrometheus(par.first.second) << " "
+              << par.second->valor() << "\n";
+    }
+
+    familiaAtual.clear();
+    for (const auto& par : histogramas_) {
+        const std::string& nome = par.first.first;
+        const std::string& rotulos = par.first.second;
+        if (nome != familiaAtual) {
+            saida << "# TYPE " << nome << " histogram\n";
+            familiaAtual = nome;
+        }
+
+        std::vector<uint64_t> buckets = par.second->copiarBuckets();
+        uint64_t total = 0;
+        for (uint64_t c : buckets) total += c;
+
+        // Um bucket HDR entra no limite `le` quando todo o seu intervalo cabe nele
+        int indice = 0;
+        uint64_t acumulado = 0;
+        for (double limite : limitesSegundos) {
+            uint64_t limiteNs = static_cast<uint64_t>(limite * 1e9);
+            while (indice < HistogramaLatencia::NUM_BUCKETS &&
+                   HistogramaLatencia::limiteSuperior(indice) <= limiteNs) {
+                acumulado += buckets[indice++];
+            }
+            std::ostringstream le;
+            le << "le=\"" << limite << "\"";
+            saida << nome << "_bucket" << rotulosPrometheus(rotulos, le.str())
+                  << " " << acumulado << "\n";
+        }
+        saida << nome << "_bucket" << rotulosPrometheus(rotulos, "le=\"+Inf\"")
+              << " " << total << "\n";
+        saida << nome << "_sum" << rotulosPrometheus(rotulos) << " "
+              << std::setprecision(9) << par.second->somaNs() / 1e9 << "\n";
+        saida << nome << "_count" << rotulosPrometheus(rotulos) << " " << total << "\n";
+    }
+
+    return saida.str();
+}
+
+bool RegistroMetricas::exportarPrometheusArquivo(const std::string& caminho) const {
+    std::string conteudo = exportarPrometheus();
+    std::string temporario = caminho + ".tmp";
+
+    {
+        std::ofstream arquivo(temporario, std::ios::trunc);
+        if (!arquivo.is_open()) {
+            return false;
+        }
+        arquivo << conteudo;
+        if (!arquivo.good()) {
+            return false;
+        }
+    }
+
+    return std::rename(temporario.c_str(), caminho.c_str()) == 0;
+}
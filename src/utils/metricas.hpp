@@ -0,0 +1,207 @@
+#ifndef METRICAS_HPP
+#define METRICAS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contador monotônico de baixo custo
+ *
+ * Cada thread incrementa uma das fatias (alinhadas em linha de cache),
+ * escolhida pela ordem em que a thread usou contadores pela primeira vez.
+ * Assim threads diferentes não disputam a mesma linha de cache e a leitura
+ * soma as fatias. Incremento: um fetch_add relaxed.
+ */
+class ContadorMetrica {
+public:
+    static constexpr size_t NUM_FATIAS = 16;
+
+    ContadorMetrica() = default;
+    ContadorMetrica(const ContadorMetrica&) = delete;
+    ContadorMetrica& operator=(const ContadorMetrica&) = delete;
+
+    void incrementar(uint64_t n = 1) {
+        fatias_[indiceFatiaThread()].valor.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    uint64_t valor() const;
+
+    /**
+     * @brief Índice da fatia usada pela thread corrente
+     */
+    static size_t indiceFatiaThread();
+
+private:
+    struct alignas(64) Fatia {
+        std::atomic<uint64_t> valor{0};
+    };
+
+    std::array<Fatia, NUM_FATIAS> fatias_;
+};
+
+/**
+ * @brief Resumo de um histograma em um instante
+ */
+struct ResumoHistograma {
+    uint64_t contagem = 0;
+    uint64_t somaNs = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t maxNs = 0;
+};
+
+/**
+ * @brief Histograma de latências no estilo HDR (log-linear)
+ *
+ * Os valores (em nanossegundos) são distribuídos em faixas de potência de 2,
+ * cada uma dividida em 16 sub-faixas lineares: erro relativo máximo de ~6%
+ * em qualquer ordem de grandeza, com memória fixa (~5 KB) e registro em
+ * O(1) sem locks (um fetch_add por bucket e um pela soma).
+ */
+class HistogramaLatencia {
+public:
+    static constexpr int BITS_SUBFAIXA = 4;
+    static constexpr int SUBFAIXAS = 1 << BITS_SUBFAIXA;
+    static constexpr int EXPOENTE_MAXIMO = 42;  // ~73 minutos em ns
+    static constexpr int NUM_BUCKETS = (EXPOENTE_MAXIMO - BITS_SUBFAIXA + 2) * SUBFAIXAS;
+
+    HistogramaLatencia() = default;
+    HistogramaLatencia(const HistogramaLatencia&) = delete;
+    HistogramaLatencia& operator=(const HistogramaLatencia&) = delete;
+
+    void registrar(uint64_t ns) {
+        buckets_[indiceBucket(ns)].fetch_add(1, std::memory_order_relaxed);
+        somaNs_.fetch_add(ns, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copia as contagens atuais dos buckets
+     */
+    std::vector<uint64_t> copiarBuckets() const;
+
+    uint64_t somaNs() const { return somaNs_.load(std::memory_order_relaxed); }
+
+    ResumoHistograma resumir() const;
+
+    static int indiceBucket(uint64_t ns);
+
+    /**
+     * @brief Maior valor (inclusive) que cai no bucket indicado
+     */
+    static uint64_t limiteSuperior(int indice);
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> buckets_{};
+    std::atomic<uint64_t> somaNs_{0};
+};
+
+/**
+ * @brief Mede o tempo de vida do escopo e registra no histograma
+ */
+class MedidorLatencia {
+public:
+    explicit MedidorLatencia(HistogramaLatencia& histograma)
+        : histograma_(histograma), inicio_(std::chrono::steady_clock::now()) {}
+
+    ~MedidorLatencia() {
+        histograma_.registrar(static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - inicio_).count()));
+    }
+
+    MedidorLatencia(const MedidorLatencia&) = delete;
+    MedidorLatencia& operator=(const MedidorLatencia&) = delete;
+
+private:
+    HistogramaLatencia& histograma_;
+    std::chrono::steady_clock::time_point inicio_;
+};
+
+/**
+ * @brief Fotografia de todas as métricas registradas
+ */
+struct SnapshotMetricas {
+    struct Contador {
+        std::string nome;
+        std::string rotulos;
+        uint64_t valor;
+    };
+
+    struct Histograma {
+        std::string nome;
+        std::string rotulos;
+        ResumoHistograma resumo;
+    };
+
+    std::vector<Contador> contadores;
+    std::vector<Histograma> histogramas;
+};
+
+/**
+ * @brief Registro central de métricas do sistema (Singleton)
+ *
+ * Métricas são identificadas por nome (família, no formato Prometheus) e
+ * rótulos opcionais (ex: `operacao="buscarUsuario"`). A busca por nome
+ * usa mutex e deve ser feita uma vez por ponto de instrumentação
+ * (ver SSMH_MEDIR_LATENCIA); as referências retornadas são estáveis.
+ */
+class RegistroMetricas {
+public:
+    static RegistroMetricas& getInstance();
+
+    ContadorMetrica& contador(const std::string& nome, const std::string& rotulos = "");
+    HistogramaLatencia& histograma(const std::string& nome, const std::string& rotulos = "");
+
+    SnapshotMetricas snapshot() const;
+
+    /**
+     * @brief Renderiza as métricas no formato texto do Prometheus (0.0.4)
+     *
+     * Histogramas são exportados em segundos com buckets cumulativos
+     * fixos de 1us a 10s.
+     */
+    std::string exportarPrometheus() const;
+
+    /**
+     * @brief Grava a exportação Prometheus em arquivo
+     *
+     * Escreve em um arquivo temporário e renomeia, de forma que coletores
+     * (ex: textfile collector do node_exporter) nunca leiam arquivo parcial.
+     *
+     * @return true se gravou com sucesso
+     */
+    bool exportarPrometheusArquivo(const std::string& caminho) const;
+
+private:
+    RegistroMetricas() = default;
+    RegistroMetricas(const RegistroMetricas&) = delete;
+    RegistroMetricas& operator=(const RegistroMetricas&) = delete;
+
+    using Chave = std::pair<std::string, std::string>;  // (nome, rótulos)
+
+    mutable std::mutex mutex_;
+    std::map<Chave, std::unique_ptr<ContadorMetrica>> contadores_;
+    std::map<Chave, std::unique_ptr<HistogramaLatencia>> histogramas_;
+};
+
+/**
+ * @brief Mede a latência do escopo atual no histograma (nome, rótulos)
+ *
+ * A busca no registro acontece uma única vez por ponto de chamada
+ * (referência estática local); as chamadas seguintes custam apenas a
+ * leitura do relógio e dois fetch_add.
+ */
+#define SSMH_MEDIR_LATENCIA(nome, rotulos) \
+    static HistogramaLatencia& histogramaEscopo_ = \
+        RegistroMetricas::getInstance().histograma(nome, rotulos); \
+    MedidorLatencia medidorEscopo_(histogramaEscopo_)
+
+#endif // METRICAS_HPP
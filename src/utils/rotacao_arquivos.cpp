@@ -0,0 +1,86 @@
+#include "rotacao_arquivos.hpp"
+#include <cstdio>
+#include <iostream>
+#include <vector>
+#include <zlib.h>
+
+std::string caminhoRotacionado(const std::string& caminho, int indice, const std::string& sufixo) {
+    return caminho + "." + std::to_string(indice) + sufixo;
+}
+
+void deslocarRotacionados(const std::string& caminho, int maxArquivos, const std::string& sufixo) {
+    if (maxArquivos < 1) {
+        maxArquivos = 1;
+    }
+
+    std::remove(caminhoRotacionado(caminho, maxArquivos, sufixo).c_str());
+
+    for (int i = maxArquivos - 1; i >= 1; --i) {
+        std::rename(caminhoRotacionado(caminho, i, sufixo).c_str(),
+                    caminhoRotacionado(caminho, i + 1, sufixo).c_str());
+    }
+}
+
+void rotacionarArquivos(const std::string& caminho, int maxArquivos) {
+    deslocarRotacionados(caminho, maxArquivos, "");
+    std::rename(caminho.c_str(), caminhoRotacionado(caminho, 1).c_str());
+}
+
+bool comprimirGzip(const std::string& origem, const std::string& destino) {
+    FILE* entrada = std::fopen(origem.c_str(), "rb");
+    if (!entrada) {
+        return false;
+    }
+
+    gzFile saida = gzopen(destino.c_str(), "wb6");
+    if (!saida) {
+        std::fclose(entrada);
+        return false;
+    }
+
+    std::vector<char> bloco(256 * 1024);
+    bool ok = true;
+    size_t lidos;
+    while ((lidos = std::fread(bloco.data(), 1, bloco.size(), entrada)) > 0) {
+        if (gzwrite(saida, bloco.data(), static_cast<unsigned>(lidos)) != static_cast<int>(lidos)) {
+            ok = false;
+            break;
+        }
+    }
+
+    ok = !std::ferror(entrada) && ok;
+    std::fclose(entrada);
+    ok = gzclose(saida) == Z_OK && ok;
+
+    if (!ok) {
+        std::remove(destino.c_str());
+    }
+    return ok;
+}
+
+// ==================== CompressorRotacao ====================
+
+CompressorRotacao::CompressorRotacao() : fila_(&CompressorRotacao::comprimir) {}
+
+void CompressorRotacao::enfileirar(const std::string& pendente, const std::string& caminhoBase,
+                                   int maxArquivos) {
+    fila_.enfileirar({pendente, caminhoBase, maxArquivos});
+}
+
+void CompressorRotacao::aguardar() {
+    fila_.aguardar();
+}
+
+void CompressorRotacao::comprimir(Tarefa& tarefa) {
+    deslocarRotacionados(tarefa.caminhoBase, tarefa.maxArquivos, ".gz");
+    std::string destino = caminhoRotacionado(tarefa.caminhoBase, 1, ".gz");
+
+    if (comprimirGzip(tarefa.pendente, destino)) {
+        std::remove(tarefa.pendente.c_str());
+    } else {
+        // Mantém o conteúdo sem compressão no lugar do .gz
+        std::cerr << "[CompressorRotacao] Falha ao comprimir " << tarefa.pendente << std::endl;
+        std::rename(tarefa.pendente.c_str(),
+                    caminhoRotacionado(tarefa.caminhoBase, 1).c_str());
+    }
+}
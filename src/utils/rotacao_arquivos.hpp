@@ -0,0 +1,76 @@
+#ifndef ROTACAO_ARQUIVOS_HPP
+#define ROTACAO_ARQUIVOS_HPP
+
+#include "fila_trabalho.hpp"
+#include <string>
+
+/**
+ * @brief Caminho do arquivo rotacionado de ordem `indice` (ex: app.log.2)
+ */
+std::string caminhoRotacionado(const std::string& caminho, int indice,
+                               const std::string& sufixo = "");
+
+/**
+ * @brief Rotaciona `caminho` no esquema do logrotate
+ *
+ * caminho.(N-1) → caminho.N, ..., caminho → caminho.1; o mais antigo além
+ * de `maxArquivos` é removido. O arquivo `caminho` deixa de existir e pode
+ * ser recriado vazio pelo chamador.
+ *
+ * @param maxArquivos Quantidade de arquivos rotacionados mantidos (>= 1)
+ */
+void rotacionarArquivos(const std::string& caminho, int maxArquivos);
+
+/**
+ * @brief Desloca apenas os arquivos já rotacionados (caminho.i + sufixo)
+ *
+ * Libera a posição 1 e remove o que passar de `maxArquivos`.
+ */
+void deslocarRotacionados(const std::string& caminho, int maxArquivos,
+                          const std::string& sufixo);
+
+/**
+ * @brief Comprime `origem` em `destino` no formato gzip
+ * @return true se o arquivo comprimido foi gravado por completo
+ */
+bool comprimirGzip(const std::string& origem, const std::string& destino);
+
+/**
+ * @brief Compressão em segundo plano de arquivos rotacionados
+ *
+ * O escritor do log apenas renomeia o arquivo cheio para um nome
+ * temporário e o entrega aqui; esta thread desloca a série
+ * caminho.N.gz, comprime o temporário em caminho.1.gz e o remove.
+ * Processar a fila em ordem, numa única thread (uma FilaTrabalho), mantém
+ * a numeração consistente mesmo com rotações em sequência.
+ */
+class CompressorRotacao {
+public:
+    CompressorRotacao();
+
+    CompressorRotacao(const CompressorRotacao&) = delete;
+    CompressorRotacao& operator=(const CompressorRotacao&) = delete;
+
+    /**
+     * @brief Enfileira `pendente` para virar caminhoBase.1.gz
+     */
+    void enfileirar(const std::string& pendente, const std::string& caminhoBase, int maxArquivos);
+
+    /**
+     * @brief Bloqueia até que a fila esteja vazia
+     */
+    void aguardar();
+
+private:
+    struct Tarefa {
+        std::string pendente;
+        std::string caminhoBase;
+        int maxArquivos;
+    };
+
+    static void comprimir(Tarefa& tarefa);
+
+    FilaTrabalho<Tarefa> fila_;
+};
+
+#endif // ROTACAO_ARQUIVOS_HPP
@@ -13,17 +13,50 @@
 #include "src/alertas/services/alerta_service_factory.hpp"
 #include "src/alertas/strategies/limite_diario_strategy.hpp"
 #include "src/alertas/strategies/media_movel_strategy.hpp"
+#include "src/alertas/strategies/janela_consumo.hpp"
 #include "src/alertas/strategies/deteccao_vazamento_strategy.hpp"
+#include "src/alertas/strategies/expressao_strategy.hpp"
+#include "src/alertas/strategies/limites_vetorizados.hpp"
 #include "src/alertas/notifications/notificacao_console_log.hpp"
 #include "src/alertas/notifications/notificacao_windows_popup.hpp"
 #include "src/alertas/notifications/notificacao_email.hpp"
+#include "src/alertas/notifications/notificacao_agrupada.hpp"
+#include "src/alertas/notifications/pool_conexoes_curl.hpp"
+#include "src/alertas/notifications/cache_tokens_oauth.hpp"
 #include "src/alertas/observers/painel_observer.hpp"
 #include "src/alertas/observers/logger_observer.hpp"
 #include "src/alertas/observers/notificacao_observer.hpp"
+#include "src/alertas/observers/observer_assincrono.hpp"
+#include "src/alertas/storage/repositorio_alertas.hpp"
+#include "src/alertas/storage/persistencia_alertas_sqlite.hpp"
+#include "src/core/fachada_ssmh.hpp"
+#include "src/monitoramento/services/monitoramento_service_factory.hpp"
+#include "src/usuarios/services/usuario_service.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 void imprimirSeparador(const std::string& titulo = "") {
     std::cout << "\n" << std::string(70, '=') << "\n";
@@ -142,11 +175,11 @@ void teste5_EstrategiasAnalise() {
     
     std::cout << "\n--- Testando Média Móvel ---\n";
     service->salvarRegra(302, "MEDIA_MOVEL", "50"); // 50% acima da média
-    service->verificarRegras(302, 100.0); // Deve alertar se média histórica for ~50L
+    service->verificarRegras(302, 100.0); // Sem histórico ainda: não há média para comparar
     
     std::cout << "\n--- Testando Detecção de Vazamento ---\n";
     service->salvarRegra(303, "DETECCAO_VAZAMENTO", "24h");
-    service->verificarRegras(303, 48.0); // 2L/h constante = possível vazamento
+    service->verificarRegras(303, 48.0); // Só o total diário: vazamento vem das leituras (teste 15)
     
     auto alertas = service->buscarAlertasAtivos();
     std::cout << "\n✓ Total de alertas: " << alertas.size() << "\n";
@@ -271,6 +304,1528 @@ void teste10_EstatisticasCompletas() {
     std::cout << "\n✓ Relatório de estatísticas gerado\n";
 }
 
+void teste11_IndiceRegras() {
+    imprimirSeparador("TESTE 11: Índice de Regras por Usuário");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    
+    // Regras intercaladas entre usuários
+    int regraA1 = service->salvarRegra(700, "LIMITE_DIARIO", "70");
+    service->salvarRegra(701, "LIMITE_DIARIO", "200");
+    int regraA2 = service->salvarRegra(700, "LIMITE_DIARIO", "100");
+    
+    if (service->buscarRegrasPorUsuario(700).size() != 2 ||
+        service->buscarRegrasPorUsuario(701).size() != 1 ||
+        !service->buscarRegrasPorUsuario(702).empty()) {
+        throw std::runtime_error("índice por usuário retornou regras erradas");
+    }
+    
+    // 150L viola as duas regras do usuário 700 e nenhuma do 701
+    service->verificarRegras(700, 150.0);
+    service->verificarRegras(701, 150.0);
+    if (service->buscarAlertasPorUsuario(700).size() != 2 ||
+        !service->buscarAlertasPorUsuario(701).empty()) {
+        throw std::runtime_error("verificação usou regras de outro usuário");
+    }
+    
+    // Regra desativada deixa de ser avaliada
+    if (!service->desativarRegra(regraA1) || service->desativarRegra(9999)) {
+        throw std::runtime_error("desativarRegra não localizou a regra pelo id");
+    }
+    service->verificarRegras(700, 85.0);
+    if (service->buscarAlertasPorUsuario(700).size() != 2) {
+        throw std::runtime_error("regra desativada ainda foi avaliada");
+    }
+    service->verificarRegras(700, 150.0);
+    if (service->buscarAlertasPorUsuario(700).size() != 3) {
+        throw std::runtime_error("regra " + std::to_string(regraA2) + " não foi avaliada");
+    }
+    
+    std::cout << "\n✓ Índice de regras consistente\n";
+}
+
+void teste12_ParametrosInvalidos() {
+    imprimirSeparador("TESTE 12: Validação de Parâmetros na Criação da Regra");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    
+    // Parâmetros inválidos são recusados ao salvar, sem valor padrão silencioso
+    const std::pair<const char*, const char*> invalidos[] = {
+        {"LIMITE_DIARIO", "setenta"},
+        {"LIMITE_DIARIO", "-5"},
+        {"LIMITE_DIARIO", "70L"},
+        {"MEDIA_MOVEL", ""},
+        {"DETECCAO_VAZAMENTO", "24x"},
+        {"DETECCAO_VAZAMENTO", "1.5h"},
+    };
+    for (const auto& [tipo, valor] : invalidos) {
+        if (service->salvarRegra(800, tipo, valor) != -1) {
+            throw std::runtime_error(std::string("parâmetro inválido aceito: ") + tipo + "=" + valor);
+        }
+    }
+    if (!service->buscarRegrasPorUsuario(800).empty()) {
+        throw std::runtime_error("regra inválida foi cadastrada");
+    }
+    
+    // Formatos válidos continuam aceitos
+    if (service->salvarRegra(801, "LIMITE_DIARIO", "72.5") < 0 ||
+        service->salvarRegra(802, "DETECCAO_VAZAMENTO", "12") < 0 ||
+        service->salvarRegra(802, "DETECCAO_VAZAMENTO", "48h") < 0) {
+        throw std::runtime_error("parâmetro válido recusado");
+    }
+    
+    // O limite compilado é usado na avaliação
+    if (service->verificarRegras(801, 72.0) || !service->verificarRegras(801, 73.0)) {
+        throw std::runtime_error("limite compilado avaliado incorretamente");
+    }
+    
+    std::cout << "\n✓ Parâmetros validados na criação da regra\n";
+}
+
+void teste13_VerificacaoEmLote() {
+    imprimirSeparador("TESTE 13: Verificação Automática em Lote");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    
+    // Sem fonte de consumo nada é verificado (nenhum valor simulado)
+    service->salvarRegra(900, "LIMITE_DIARIO", "70");
+    if (service->executarVerificacaoAutomatica() != 0) {
+        throw std::runtime_error("verificação sem fonte de consumo disparou alertas");
+    }
+    
+    // 2000 usuários: os pares consomem acima do limite
+    const int NUM_USUARIOS = 2000;
+    std::map<int, double> consumos;
+    for (int id = 1000; id < 1000 + NUM_USUARIOS; ++id) {
+        service->salvarRegra(id, "LIMITE_DIARIO", "100");
+        consumos[id] = (id % 2 == 0) ? 150.0 : 50.0;
+    }
+    
+    std::vector<int> consultados;
+    service->definirFonteConsumo(
+        [&](const std::vector<int>& usuarios, std::time_t, std::time_t) {
+            consultados = usuarios;
+            std::map<int, double> resultado;
+            for (int id : usuarios) {
+                auto it = consumos.find(id);
+                resultado[id] = it != consumos.end() ? it->second : 0.0;
+            }
+            return resultado;
+        });
+    
+    // Com 4 partições o resultado deve ser o mesmo de uma avaliação sequencial
+    auto disparados = service->verificarRegrasEmLote(consumos, 4);
+    if (disparados.size() != NUM_USUARIOS / 2) {
+        throw std::runtime_error("lote disparou " + std::to_string(disparados.size()) + " alertas");
+    }
+    for (size_t i = 1; i < disparados.size(); ++i) {
+        if (disparados[i].getUsuarioId() <= disparados[i - 1].getUsuarioId()) {
+            throw std::runtime_error("alertas do lote fora da ordem de usuário");
+        }
+    }
+    
+    int automaticos = service->executarVerificacaoAutomatica();
+    if (automaticos != NUM_USUARIOS / 2 ||
+        consultados.size() != static_cast<size_t>(NUM_USUARIOS + 1)) {
+        throw std::runtime_error("verificação automática não usou a fonte de consumo");
+    }
+    
+    std::cout << "\n✓ Lote de " << NUM_USUARIOS << " usuários avaliado em partições\n";
+}
+
+void teste14_MediaMovel() {
+    imprimirSeparador("TESTE 14: Média Móvel com Histórico Real");
+    
+    // Janela deslizante: após dar a volta, média e variância batem com o cálculo direto
+    JanelaConsumo janela(5);
+    const double amostras[] = {40.0, 55.0, 48.0, 61.0, 52.0, 47.0, 58.0, 50.0};
+    for (double amostra : amostras) {
+        janela.adicionar(amostra);
+    }
+    double soma = 0.0;
+    for (int i = 3; i < 8; ++i) {
+        soma += amostras[i];
+    }
+    double mediaDireta = soma / 5.0;
+    double m2Direto = 0.0;
+    for (int i = 3; i < 8; ++i) {
+        m2Direto += (amostras[i] - mediaDireta) * (amostras[i] - mediaDireta);
+    }
+    if (janela.quantidade() != 5 || std::abs(janela.media() - mediaDireta) > 1e-9 ||
+        std::abs(janela.variancia() - m2Direto / 4.0) > 1e-9) {
+        throw std::runtime_error("janela deslizante com média/variância incorretas");
+    }
+    if (std::abs(janela.mediaUltimas(2) - 54.0) > 1e-9) {
+        throw std::runtime_error("média das últimas amostras incorreta");
+    }
+    
+    // Pelo serviço: as verificações alimentam o histórico do usuário
+    auto service = AlertaServiceFactory::criarParaTeste();
+    service->salvarRegra(1401, "MEDIA_MOVEL", "50");
+    
+    for (int dia = 0; dia < 10; ++dia) {
+        if (service->verificarRegras(1401, 50.0)) {
+            throw std::runtime_error("média móvel alertou com consumo estável");
+        }
+    }
+    if (service->verificarRegras(1401, 70.0)) {
+        throw std::runtime_error("média móvel alertou dentro da tolerância (70 <= 75)");
+    }
+    if (!service->verificarRegras(1401, 90.0)) {
+        throw std::runtime_error("média móvel não alertou com consumo 80% acima da média");
+    }
+    
+    // Outro usuário não herda o histórico
+    service->salvarRegra(1402, "MEDIA_MOVEL", "50");
+    if (service->verificarRegras(1402, 500.0)) {
+        throw std::runtime_error("média móvel alertou sem histórico do usuário");
+    }
+    
+    std::cout << "\n✓ Média móvel comparou com o histórico de cada usuário\n";
+}
+
+void teste15_VazamentoPorLeituras() {
+    imprimirSeparador("TESTE 15: Detecção de Vazamento pelas Leituras");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    service->salvarRegra(1501, "DETECCAO_VAZAMENTO", "24h");
+    service->salvarRegra(1502, "DETECCAO_VAZAMENTO", "24h");
+    service->vincularHidrometro(1501, "SHA-VAZ-01");
+    service->vincularHidrometro(1502, "SHA-VAZ-02");
+    
+    // O total diário sozinho não indica vazamento: as verificações
+    // agregadas pulam a regra, mas continuam avaliando as demais do usuário
+    service->salvarRegra(1502, "LIMITE_DIARIO", "100");
+    service->definirFonteConsumo([](const std::vector<int>& usuarios, std::time_t, std::time_t) {
+        std::map<int, double> consumo;
+        for (int id : usuarios) {
+            consumo[id] = 150.0;
+        }
+        return consumo;
+    });
+    auto lote = service->verificarRegrasEmLote({{1501, 150.0}, {1502, 150.0}});
+    if (service->verificarRegras(1501, 72.0) || lote.size() != 1 || lote[0].getUsuarioId() != 1502 ||
+        lote[0].getTipoRegra() != "LIMITE_DIARIO") {
+        throw std::runtime_error("vazamento avaliado pelo total diário");
+    }
+    service->resolverAlerta(lote[0].getId());
+    service->desativarRegra(service->buscarRegrasPorUsuario(1502).back().getId());
+    if (service->executarVerificacaoAutomatica() != 0) {
+        throw std::runtime_error("verificação automática avaliou vazamento pelo total diário");
+    }
+    
+    // Hidrômetro 1: 3 L a cada hora, sem nunca parar
+    const std::time_t inicio = 1700000000;
+    int horaDisparo = -1;
+    int disparos = 0;
+    for (int hora = 0; hora < 36; ++hora) {
+        int novos = service->processarLeitura("SHA-VAZ-01", 1000.0 + 3.0 * hora, inicio + hora * 3600);
+        if (novos > 0 && horaDisparo < 0) {
+            horaDisparo = hora;
+        }
+        disparos += novos;
+    }
+    if (disparos != 1 || horaDisparo != 24) {
+        throw std::runtime_error("vazamento: " + std::to_string(disparos) + 
+                                 " alertas, primeiro na hora " + std::to_string(horaDisparo));
+    }
+    
+    // Hidrômetro 2: mesmo volume, mas o fluxo para a cada 6 horas
+    double valor = 500.0;
+    for (int hora = 0; hora < 48; ++hora) {
+        if (hora % 6 != 0) {
+            valor += 3.0;
+        }
+        if (service->processarLeitura("SHA-VAZ-02", valor, inicio + hora * 3600) != 0) {
+            throw std::runtime_error("vazamento alertado com fluxo que zera");
+        }
+    }
+    
+    // Hidrômetro sem dono é ignorado
+    if (service->processarLeitura("SHA-SEM-DONO", 1.0, inicio) != 0) {
+        throw std::runtime_error("leitura de hidrômetro não vinculado disparou alerta");
+    }
+    
+    std::cout << "\n✓ Vazamento detectado após 24h de fluxo contínuo\n";
+}
+
+void teste16_AvaliacaoPorLeitura() {
+    imprimirSeparador("TESTE 16: Avaliação Incremental a Cada Leitura");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    service->salvarRegra(1601, "LIMITE_DIARIO", "100");
+    service->vincularHidrometro(1601, "SHA-INC-A");
+    service->vincularHidrometro(1601, "SHA-INC-B");
+    
+    // 10/03/2024 08:00, hora local
+    std::tm base = {};
+    base.tm_year = 124;
+    base.tm_mon = 2;
+    base.tm_mday = 10;
+    base.tm_hour = 8;
+    base.tm_isdst = -1;
+    const std::time_t inicio = std::mktime(&base);
+    
+    // Dois hidrômetros, 10 L cada por leitura: o dia soma 20 L a cada rodada
+    int rodadaDisparo = -1;
+    int disparos = 0;
+    for (int rodada = 0; rodada < 10; ++rodada) {
+        std::time_t instante = inicio + rodada * 600;
+        int novos = service->processarLeitura("SHA-INC-A", 1000.0 + 10.0 * rodada, instante);
+        novos += service->processarLeitura("SHA-INC-B", 2000.0 + 10.0 * rodada, instante + 60);
+        if (novos > 0 && rodadaDisparo < 0) {
+            rodadaDisparo = rodada;
+        }
+        disparos += novos;
+    }
+    // Rodada 0 é a base; na 5 o dia chega a 100 L e na 6 passa do limite
+    if (disparos != 1 || rodadaDisparo != 6) {
+        throw std::runtime_error("limite por leitura: " + std::to_string(disparos) + 
+                                 " alertas, primeiro na rodada " + std::to_string(rodadaDisparo));
+    }
+    if (std::abs(service->consumoDiarioIncremental(1601) - 180.0) > 1e-9) {
+        throw std::runtime_error("consumo diário incremental incorreto");
+    }
+    
+    // Dia seguinte: o consumo recomeça (o intervalo conta no dia da leitura)
+    // e a regra pode disparar de novo
+    std::time_t amanha = inicio + 24 * 3600;
+    service->processarLeitura("SHA-INC-A", 1095.0, amanha);
+    if (std::abs(service->consumoDiarioIncremental(1601) - 5.0) > 1e-9) {
+        throw std::runtime_error("consumo diário não reiniciou na virada do dia");
+    }
+    if (service->processarLeitura("SHA-INC-A", 1300.0, amanha + 600) != 1) {
+        throw std::runtime_error("regra não disparou no dia seguinte");
+    }
+    
+    std::cout << "\n✓ Alerta disparado na leitura que ultrapassou o limite\n";
+}
+
+/**
+ * @brief Observer lento e que falha nas primeiras entregas, para os testes assíncronos
+ */
+class ObserverLentoTeste : public AlertObserver {
+public:
+    ObserverLentoTeste(std::chrono::milliseconds demora, int falhasIniciais = 0)
+        : demora(demora), falhasRestantes(falhasIniciais) {}
+    
+    void atualizar(const AlertaAtivo&) override {
+        std::this_thread::sleep_for(demora);
+        if (falhasRestantes > 0) {
+            --falhasRestantes;
+            throw std::runtime_error("falha simulada");
+        }
+        ++recebidos;
+    }
+    std::string getNome() const override { return "ObserverLentoTeste"; }
+    
+    std::chrono::milliseconds demora;
+    std::atomic<int> falhasRestantes;
+    std::atomic<int> recebidos{0};
+};
+
+void teste17_NotificacaoAssincrona() {
+    imprimirSeparador("TESTE 17: Notificação Assíncrona dos Observers");
+    
+    // Um observer de 300 ms não atrasa a verificação
+    auto service = AlertaServiceFactory::criarParaTeste();
+    auto lento = std::make_shared<ObserverLentoTeste>(std::chrono::milliseconds(300));
+    service->anexarObserver(lento);
+    service->definirNotificacaoAssincrona(true);
+    service->salvarRegra(1701, "LIMITE_DIARIO", "70");
+    
+    auto antes = std::chrono::steady_clock::now();
+    if (!service->verificarRegras(1701, 90.0)) {
+        throw std::runtime_error("regra não violada no modo assíncrono");
+    }
+    auto decorrido = std::chrono::steady_clock::now() - antes;
+    if (decorrido >= std::chrono::milliseconds(200)) {
+        throw std::runtime_error("verificarRegras esperou o observer lento");
+    }
+    service->aguardarNotificacoes();
+    if (lento->recebidos != 1) {
+        throw std::runtime_error("observer assíncrono não recebeu o alerta");
+    }
+    
+    // Fila de 2 com descarte do mais antigo: o que não couber é contado
+    AlertaAtivo alerta(1, 1701, "teste", 90.0, "LIMITE_DIARIO");
+    auto bloqueado = std::make_shared<ObserverLentoTeste>(std::chrono::milliseconds(50));
+    ObserverAssincrono::Configuracao limitada;
+    limitada.capacidadeFila = 2;
+    {
+        ObserverAssincrono despachante(bloqueado, limitada);
+        for (int i = 0; i < 6; ++i) {
+            despachante.atualizar(alerta);
+        }
+        despachante.aguardar();
+        if (despachante.getDescartados() < 3 ||
+            despachante.getEntregues() + despachante.getDescartados() != 6) {
+            throw std::runtime_error("fila limitada: " + std::to_string(despachante.getEntregues()) +
+                                     " entregues, " + std::to_string(despachante.getDescartados()) +
+                                     " descartados");
+        }
+    }
+    
+    // Duas falhas e sucesso na terceira tentativa
+    auto instavel = std::make_shared<ObserverLentoTeste>(std::chrono::milliseconds(0), 2);
+    ObserverAssincrono::Configuracao comRepeticao;
+    comRepeticao.esperaEntreTentativas = std::chrono::milliseconds(1);
+    ObserverAssincrono despachante(instavel, comRepeticao);
+    despachante.atualizar(alerta);
+    despachante.aguardar();
+    if (instavel->recebidos != 1 || despachante.getFalhas() != 0) {
+        throw std::runtime_error("entrega não foi repetida após falha");
+    }
+    
+    std::cout << "\n✓ Observers notificados fora da verificação, com fila limitada\n";
+}
+
+/**
+ * @brief Servidor TCP mínimo em 127.0.0.1, base dos servidores de teste
+ * 
+ * A porta é escolhida pelo sistema. Uma thread por conexão: o cliente pode
+ * abrir uma sessão nova sem fechar a anterior. Subclasses implementam
+ * atender() e chamam parar() no próprio destrutor, enquanto atender()
+ * ainda pode ser chamado.
+ */
+class ServidorLoopbackTeste {
+public:
+    virtual ~ServidorLoopbackTeste() { parar(); }
+    
+    int iniciar() {
+        socketEscuta = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in endereco{};
+        endereco.sin_family = AF_INET;
+        endereco.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        endereco.sin_port = 0;
+        socklen_t tamanho = sizeof(endereco);
+        if (socketEscuta < 0 ||
+            bind(socketEscuta, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) != 0 ||
+            listen(socketEscuta, 4) != 0 ||
+            getsockname(socketEscuta, reinterpret_cast<sockaddr*>(&endereco), &tamanho) != 0) {
+            throw std::runtime_error(std::string("não foi possível abrir o servidor ") + nome + " de teste");
+        }
+        thread = std::thread(&ServidorLoopbackTeste::aceitar, this);
+        return ntohs(endereco.sin_port);
+    }
+    
+    void parar() {
+        if (socketEscuta >= 0) {
+            shutdown(socketEscuta, SHUT_RDWR);
+        }
+        if (thread.joinable()) {
+            thread.join();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutexConexoes);
+            for (int cliente : clientes) {
+                shutdown(cliente, SHUT_RDWR);
+            }
+        }
+        for (auto& atendimento : atendimentos) {
+            atendimento.join();
+        }
+        atendimentos.clear();
+        for (int cliente : clientes) {
+            close(cliente);
+        }
+        clientes.clear();
+        if (socketEscuta >= 0) {
+            close(socketEscuta);
+            socketEscuta = -1;
+        }
+    }
+    
+    int getConexoes() const { return conexoes; }
+    
+protected:
+    explicit ServidorLoopbackTeste(const char* nome) : nome(nome) {}
+    
+    /**
+     * @brief Conversa com um cliente até ele desconectar (thread própria)
+     */
+    virtual void atender(int cliente) = 0;
+    
+    static void responder(int cliente, const std::string& texto) {
+        send(cliente, texto.data(), texto.size(), MSG_NOSIGNAL);
+    }
+    
+private:
+    void aceitar() {
+        int cliente;
+        while ((cliente = accept(socketEscuta, nullptr, nullptr)) >= 0) {
+            ++conexoes;
+            std::lock_guard<std::mutex> lock(mutexConexoes);
+            clientes.push_back(cliente);
+            atendimentos.emplace_back(&ServidorLoopbackTeste::atender, this, cliente);
+        }
+    }
+    
+    const char* nome;
+    int socketEscuta = -1;
+    std::thread thread;
+    std::vector<std::thread> atendimentos;
+    std::vector<int> clientes;
+    std::mutex mutexConexoes;
+    std::atomic<int> conexoes{0};
+};
+
+std::string decodificarBase64Teste(const std::string& texto) {
+    static const std::string ALFABETO =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string resultado;
+    uint32_t acumulado = 0;
+    int bits = 0;
+    for (char c : texto) {
+        size_t valor = ALFABETO.find(c);
+        if (valor == std::string::npos) {
+            continue;
+        }
+        acumulado = (acumulado << 6) | static_cast<uint32_t>(valor);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            resultado.push_back(static_cast<char>((acumulado >> bits) & 0xFF));
+        }
+    }
+    return resultado;
+}
+
+/**
+ * @brief Servidor SMTP mínimo que aceita e conta as mensagens
+ * 
+ * Anuncia AUTH XOAUTH2 e guarda o remetente (MAIL FROM) e a credencial
+ * decodificada ("user=...\x01auth=Bearer ...") recebidos por último.
+ */
+class ServidorSMTPTeste : public ServidorLoopbackTeste {
+public:
+    ServidorSMTPTeste() : ServidorLoopbackTeste("SMTP") {}
+    ~ServidorSMTPTeste() override { parar(); }
+    
+    int getMensagens() const { return mensagens; }
+    std::string getUltimaMensagem() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ultimaMensagem;
+    }
+    std::string getUltimoRemetente() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ultimoRemetente;
+    }
+    std::string getUltimaCredencial() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ultimaCredencial;
+    }
+    
+private:
+    void atender(int cliente) override {
+        responder(cliente, "220 teste ESMTP\r\n");
+        std::string buffer;
+        bool emDados = false;
+        bool aguardandoCredencial = false;
+        char bloco[4096];
+        ssize_t lidos;
+        while ((lidos = recv(cliente, bloco, sizeof(bloco), 0)) > 0) {
+            buffer.append(bloco, static_cast<size_t>(lidos));
+            while (true) {
+                if (emDados) {
+                    size_t fim = buffer.find("\r\n.\r\n");
+                    if (fim == std::string::npos) {
+                        break;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ultimaMensagem = buffer.substr(0, fim);
+                    }
+                    buffer.erase(0, fim + 5);
+                    emDados = false;
+                    ++mensagens;
+                    responder(cliente, "250 OK\r\n");
+                    continue;
+                }
+                size_t fim = buffer.find("\r\n");
+                if (fim == std::string::npos) {
+                    break;
+                }
+                std::string linha = buffer.substr(0, fim);
+                std::string comando = linha.substr(0, 4);
+                buffer.erase(0, fim + 2);
+                if (aguardandoCredencial) {
+                    guardarCredencial(linha);
+                    aguardandoCredencial = false;
+                    responder(cliente, "235 Autenticado\r\n");
+                } else if (comando == "EHLO") {
+                    responder(cliente, "250-teste\r\n250 AUTH XOAUTH2\r\n");
+                } else if (comando == "AUTH") {
+                    // "AUTH XOAUTH2 <credencial>" ou a credencial na linha seguinte
+                    size_t espaco = linha.find(' ', 5);
+                    if (espaco == std::string::npos) {
+                        aguardandoCredencial = true;
+                        responder(cliente, "334 \r\n");
+                    } else {
+                        guardarCredencial(linha.substr(espaco + 1));
+                        responder(cliente, "235 Autenticado\r\n");
+                    }
+                } else if (comando == "MAIL") {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        ultimoRemetente = linha.substr(std::min<size_t>(linha.size(), 10));
+                    }
+                    responder(cliente, "250 OK\r\n");
+                } else if (comando == "DATA") {
+                    emDados = true;
+                    responder(cliente, "354 Fim com <CRLF>.<CRLF>\r\n");
+                } else if (comando == "QUIT") {
+                    responder(cliente, "221 Tchau\r\n");
+                    return;
+                } else {
+                    responder(cliente, "250 OK\r\n");
+                }
+            }
+        }
+    }
+    
+    void guardarCredencial(const std::string& base64) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ultimaCredencial = decodificarBase64Teste(base64);
+    }
+    
+    std::atomic<int> mensagens{0};
+    std::mutex mutex;
+    std::string ultimaMensagem;
+    std::string ultimoRemetente;
+    std::string ultimaCredencial;
+};
+
+void teste18_ResumoEmail() {
+    imprimirSeparador("TESTE 18: Resumo de Emails e Conexão SMTP Persistente");
+    
+    ServidorSMTPTeste servidor;
+    int porta = servidor.iniciar();
+    
+    auto email = std::make_shared<NotificacaoEmail>();
+    email->configurarServidorSemAutenticacao("127.0.0.1", porta);
+    email->configurarRemetente("alertas@ssmh.local", "SSMH");
+    
+    // Envios diretos reaproveitam a mesma conexão
+    for (int i = 0; i < 3; ++i) {
+        if (!email->enviar("Alerta " + std::to_string(i), "morador@exemplo.com")) {
+            throw std::runtime_error("envio ao servidor SMTP local falhou");
+        }
+    }
+    if (servidor.getMensagens() != 3 || servidor.getConexoes() != 1) {
+        throw std::runtime_error("SMTP: " + std::to_string(servidor.getMensagens()) + " mensagens em " +
+                                 std::to_string(servidor.getConexoes()) + " conexões");
+    }
+    
+    // 40 alertas para 2 destinatários viram 2 emails
+    {
+        NotificacaoAgrupada agrupada(email, std::chrono::seconds(60));
+        for (int i = 0; i < 40; ++i) {
+            agrupada.enviar("Consumo acima do limite #" + std::to_string(i),
+                            i % 2 == 0 ? "a@exemplo.com" : "b@exemplo.com");
+        }
+        agrupada.descarregar();
+        if (agrupada.getResumosEnviados() != 2 || agrupada.getMensagensAgrupadas() != 40 ||
+            servidor.getMensagens() != 5 || servidor.getConexoes() != 1) {
+            throw std::runtime_error("resumo não agrupou os alertas por destinatário");
+        }
+        if (servidor.getUltimaMensagem().find("Resumo de 20 alertas") == std::string::npos) {
+            throw std::runtime_error("email de resumo sem o cabeçalho esperado");
+        }
+    }
+    
+    // Grupo cheio é enviado sem esperar a janela
+    {
+        NotificacaoAgrupada agrupada(email, std::chrono::seconds(60), 5);
+        for (int i = 0; i < 5; ++i) {
+            agrupada.enviar("Alerta " + std::to_string(i), "c@exemplo.com");
+        }
+        auto limite = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (agrupada.getResumosEnviados() == 0 && std::chrono::steady_clock::now() < limite) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (agrupada.getResumosEnviados() != 1) {
+            throw std::runtime_error("grupo cheio não foi enviado antes da janela");
+        }
+    }
+    
+    // Fim da janela: o grupo sai no prazo da primeira mensagem, sem descarregar()
+    {
+        NotificacaoAgrupada agrupada(email, std::chrono::milliseconds(100));
+        auto inicio = std::chrono::steady_clock::now();
+        agrupada.enviar("Alerta 0", "d@exemplo.com");
+        agrupada.enviar("Alerta 1", "d@exemplo.com");
+        auto limite = inicio + std::chrono::seconds(5);
+        while (agrupada.getResumosEnviados() == 0 && std::chrono::steady_clock::now() < limite) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        if (agrupada.getResumosEnviados() != 1 || agrupada.getMensagensAgrupadas() != 2 ||
+            std::chrono::steady_clock::now() - inicio < std::chrono::milliseconds(100)) {
+            throw std::runtime_error("grupo não foi enviado no fim da janela");
+        }
+    }
+    
+    email.reset();
+    servidor.parar();
+    std::cout << "\n✓ 45 alertas entregues em 7 emails por uma única conexão SMTP\n";
+}
+
+/**
+ * @brief Endpoint de token OAuth2 mínimo em 127.0.0.1 (HTTP/1.1 com keep-alive)
+ */
+class ServidorHTTPTeste : public ServidorLoopbackTeste {
+public:
+    ServidorHTTPTeste() : ServidorLoopbackTeste("HTTP") {}
+    ~ServidorHTTPTeste() override { parar(); }
+    
+    int getRequisicoes() const { return requisicoes; }
+    std::string getUltimoCorpo() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ultimoCorpo;
+    }
+    
+private:
+    void atender(int cliente) override {
+        std::string buffer;
+        char bloco[4096];
+        ssize_t lidos;
+        while ((lidos = recv(cliente, bloco, sizeof(bloco), 0)) > 0) {
+            buffer.append(bloco, static_cast<size_t>(lidos));
+            while (true) {
+                size_t fimCabecalho = buffer.find("\r\n\r\n");
+                if (fimCabecalho == std::string::npos) {
+                    break;
+                }
+                size_t tamanhoCorpo = 0;
+                size_t pos = buffer.find("Content-Length:");
+                if (pos != std::string::npos && pos < fimCabecalho) {
+                    tamanhoCorpo = std::strtoul(buffer.c_str() + pos + 15, nullptr, 10);
+                }
+                if (buffer.size() < fimCabecalho + 4 + tamanhoCorpo) {
+                    break;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    ultimoCorpo = buffer.substr(fimCabecalho + 4, tamanhoCorpo);
+                }
+                buffer.erase(0, fimCabecalho + 4 + tamanhoCorpo);
+                
+                int numero = ++requisicoes;
+                std::string corpo = "{\"access_token\":\"tok-" + std::to_string(numero) +
+                                    "\",\"expires_in\":3600}";
+                responder(cliente, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+                                   "Content-Length: " + std::to_string(corpo.size()) +
+                                   "\r\n\r\n" + corpo);
+            }
+        }
+    }
+    
+    std::atomic<int> requisicoes{0};
+    std::mutex mutex;
+    std::string ultimoCorpo;
+};
+
+void teste19_PoolConexoesETokens() {
+    imprimirSeparador("TESTE 19: Pool de Conexões e Cache de Tokens OAuth2");
+    
+    ServidorSMTPTeste servidorSmtp;
+    ServidorHTTPTeste servidorToken;
+    int portaSmtp = servidorSmtp.iniciar();
+    int portaToken = servidorToken.iniciar();
+    
+    CacheTokensOAuth& cache = CacheTokensOAuth::getInstance();
+    cache.limpar();
+    PoolConexoesCurl::getInstance().limpar();
+    
+    // Duas instâncias com as mesmas credenciais compartilham token e conexões
+    std::vector<std::shared_ptr<NotificacaoEmail>> canais;
+    for (int i = 0; i < 2; ++i) {
+        auto email = std::make_shared<NotificacaoEmail>("alertas@ssmh.local", "client-id",
+                                                        "client-secret", "refresh-token");
+        email->configurarServidor("127.0.0.1", portaSmtp, false);
+        email->configurarEndpointToken("http://127.0.0.1:" + std::to_string(portaToken) + "/token");
+        canais.push_back(email);
+    }
+    
+    for (int i = 0; i < 10; ++i) {
+        if (!canais[i % 2]->enviar("Alerta " + std::to_string(i), "morador@exemplo.com")) {
+            throw std::runtime_error("envio com OAuth2 ao servidor local falhou");
+        }
+    }
+    if (servidorSmtp.getMensagens() != 10 || servidorSmtp.getConexoes() != 1) {
+        throw std::runtime_error("SMTP: " + std::to_string(servidorSmtp.getMensagens()) + " mensagens em " +
+                                 std::to_string(servidorSmtp.getConexoes()) + " conexões");
+    }
+    if (servidorToken.getRequisicoes() != 1) {
+        throw std::runtime_error("token obtido " + std::to_string(servidorToken.getRequisicoes()) +
+                                 " vezes para 10 envios");
+    }
+    
+    // Credenciais nos campos certos: refresh token e client id no endpoint,
+    // remetente no MAIL FROM e, com o token obtido, no XOAUTH2
+    std::string corpoToken = servidorToken.getUltimoCorpo();
+    if (corpoToken.find("client_id=client-id") == std::string::npos ||
+        corpoToken.find("refresh_token=refresh-token") == std::string::npos) {
+        throw std::runtime_error("requisição de token sem as credenciais configuradas: " + corpoToken);
+    }
+    if (servidorSmtp.getUltimoRemetente().find("alertas@ssmh.local") == std::string::npos ||
+        servidorSmtp.getUltimaCredencial() != "user=alertas@ssmh.local\x01" "auth=Bearer tok-1\x01\x01") {
+        throw std::runtime_error("SMTP recebeu remetente '" + servidorSmtp.getUltimoRemetente() +
+                                 "' e credencial '" + servidorSmtp.getUltimaCredencial() + "'");
+    }
+    
+    // Dentro da margem o token é renovado antes de expirar, pela mesma conexão
+    // HTTP; o token novo exige uma nova sessão SMTP autenticada
+    cache.setMargemRenovacao(std::chrono::seconds(3599));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    bool enviado = canais[0]->enviar("Alerta após renovação", "morador@exemplo.com");
+    cache.setMargemRenovacao(std::chrono::seconds(300));
+    if (!enviado || servidorToken.getRequisicoes() != 2 || servidorToken.getConexoes() != 1 ||
+        servidorSmtp.getConexoes() != 2) {
+        throw std::runtime_error("renovação proativa: " + std::to_string(servidorToken.getRequisicoes()) +
+                                 " tokens em " + std::to_string(servidorToken.getConexoes()) +
+                                 " conexões HTTP, " + std::to_string(servidorSmtp.getConexoes()) +
+                                 " sessões SMTP");
+    }
+    if (servidorSmtp.getUltimaCredencial().find("auth=Bearer tok-2") == std::string::npos) {
+        throw std::runtime_error("sessão SMTP nova não usou o token renovado");
+    }
+    
+    canais.clear();
+    PoolConexoesCurl::getInstance().limpar();
+    servidorSmtp.parar();
+    servidorToken.parar();
+    std::cout << "\n✓ 11 emails de 2 instâncias: 1 conexão HTTP, 2 tokens e 1 sessão SMTP por token\n";
+}
+
+void teste20_SupressaoAlertas() {
+    imprimirSeparador("TESTE 20: Supressão de Alertas Repetidos e Escalada");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    service->definirJanelaSupressao(std::chrono::hours(1));
+    service->salvarRegra(2001, "LIMITE_DIARIO", "70");
+    
+    // Violação sustentada: um alerta, as demais só contadas
+    for (int i = 0; i < 100; ++i) {
+        if (!service->verificarRegras(2001, 85.0)) {
+            throw std::runtime_error("violação suprimida deixou de ser reportada");
+        }
+    }
+    if (service->buscarAlertasPorUsuario(2001).size() != 1 || service->getAlertasSuprimidos() != 99) {
+        throw std::runtime_error("violações repetidas geraram " +
+                                 std::to_string(service->buscarAlertasPorUsuario(2001).size()) + " alertas");
+    }
+    
+    // Severidade maior fura a janela; menor ou igual continua suprimida
+    service->verificarRegras(2001, 150.0);
+    service->verificarRegras(2001, 90.0);
+    service->verificarRegras(2001, 150.0);
+    auto alertas = service->buscarAlertasPorUsuario(2001);
+    if (alertas.size() != 2 || alertas.back().getSeveridade() != AlertaAtivo::CRITICA) {
+        throw std::runtime_error("escalada de severidade não gerou exatamente um alerta");
+    }
+    
+    // Resolver um alerta já substituído pela escalada não mexe na supressão
+    service->resolverAlerta(alertas.front().getId());
+    service->verificarRegras(2001, 150.0);
+    if (service->buscarAlertasPorUsuario(2001).size() != 2) {
+        throw std::runtime_error("alerta antigo resolvido encerrou a supressão do atual");
+    }
+    
+    // Resolver o alerta encerra a supressão
+    service->resolverAlerta(alertas.back().getId());
+    service->verificarRegras(2001, 150.0);
+    service->verificarRegras(2001, 150.0);
+    if (service->buscarAlertasPorUsuario(2001).size() != 3) {
+        throw std::runtime_error("alerta resolvido manteve a regra suprimida");
+    }
+    
+    // Fim da janela: novo alerta, com a contagem do que foi suprimido
+    service->definirJanelaSupressao(std::chrono::seconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    service->verificarRegras(2001, 150.0);
+    alertas = service->buscarAlertasPorUsuario(2001);
+    if (alertas.size() != 4 ||
+        alertas.back().getMensagem().find("1 ocorrências suprimidas") == std::string::npos) {
+        throw std::runtime_error("janela expirada não gerou o alerta com o resumo da supressão");
+    }
+    
+    // No modo por leitura a janela corre no tempo das leituras: três
+    // vazamentos de 1h10, os dois primeiros dentro de 3h
+    service->definirJanelaSupressao(std::chrono::hours(3));
+    service->salvarRegra(2002, "DETECCAO_VAZAMENTO", "1h");
+    service->vincularHidrometro(2002, "SHA-SUP-01");
+    const std::time_t inicio = 1700000000;
+    double valor = 500.0;
+    int disparados = 0;
+    uint64_t suprimidosAntes = service->getAlertasSuprimidos();
+    for (int inicioFluxo : {0, 80, 400}) {
+        for (int minuto = inicioFluxo; minuto <= inicioFluxo + 70; minuto += 5) {
+            valor += (minuto == inicioFluxo) ? 0.0 : 2.0;
+            disparados += service->processarLeitura("SHA-SUP-01", valor, inicio + minuto * 60);
+        }
+        // Fluxo para
+        disparados += service->processarLeitura("SHA-SUP-01", valor, inicio + (inicioFluxo + 75) * 60);
+    }
+    if (disparados != 2 || service->getAlertasSuprimidos() != suprimidosAntes + 1) {
+        throw std::runtime_error("supressão por leitura: " + std::to_string(disparados) + " alertas");
+    }
+    
+    // Os dois relógios na mesma regra: o alerta da verificação (relógio do
+    // sistema) não suprime a violação de leituras antigas, nem o inverso
+    service->salvarRegra(2003, "LIMITE_DIARIO", "70");
+    service->vincularHidrometro(2003, "SHA-SUP-02");
+    service->verificarRegras(2003, 150.0);
+    disparados = service->processarLeitura("SHA-SUP-02", 1000.0, inicio);
+    disparados += service->processarLeitura("SHA-SUP-02", 1150.0, inicio + 3600);
+    if (disparados != 1) {
+        throw std::runtime_error("leitura antiga suprimida pelo alerta no relógio do sistema");
+    }
+    service->verificarRegras(2003, 150.0);
+    if (service->buscarAlertasPorUsuario(2003).size() != 3) {
+        throw std::runtime_error("relógios misturados geraram " +
+                                 std::to_string(service->buscarAlertasPorUsuario(2003).size()) + " alertas");
+    }
+    
+    std::cout << "\n✓ " << service->getAlertasSuprimidos() << " violações suprimidas\n";
+}
+
+void teste21_RepositorioAlertas() {
+    imprimirSeparador("TESTE 21: Repositório Indexado de Alertas");
+    
+    // Encerrados além do limite saem, os mais antigos primeiro
+    RepositorioAlertas repositorio(3);
+    const std::time_t inicio = 1700000000;
+    for (int id = 1; id <= 10; ++id) {
+        AlertaAtivo alerta(id, id % 2 == 0 ? 21 : 22, "Alerta " + std::to_string(id), 80.0, "LIMITE_DIARIO");
+        alerta.setDataDisparo(inicio + id * 60);
+        repositorio.inserir(alerta);
+    }
+    for (int id = 1; id <= 5; ++id) {
+        repositorio.alterarStatus(id, id == 4 ? AlertaAtivo::IGNORADO : AlertaAtivo::RESOLVIDO);
+    }
+    if (repositorio.tamanho() != 8 || repositorio.buscar(1) || repositorio.buscar(2) ||
+        !repositorio.buscar(3) || repositorio.contarPorStatus(AlertaAtivo::ATIVO) != 5) {
+        throw std::runtime_error("limite de encerrados descartou os alertas errados");
+    }
+    
+    auto doUsuario = repositorio.listarPorUsuario(21);
+    if (doUsuario.size() != 4 || doUsuario.front().getId() != 4 || doUsuario.back().getId() != 10) {
+        throw std::runtime_error("alertas do usuário fora da ordem de disparo");
+    }
+    
+    if (repositorio.removerAnteriores(inicio + 7 * 60) != 4 || repositorio.tamanho() != 4 ||
+        repositorio.listarPorStatus(AlertaAtivo::ATIVO).front().getId() != 7) {
+        throw std::runtime_error("remoção por data incorreta");
+    }
+    
+    // Histórico grande: listar e resolver não dependem do total
+    auto service = AlertaServiceFactory::criarMinimalista();
+    service->definirLimiteAlertasEncerrados(1000);
+    service->salvarRegra(2101, "LIMITE_DIARIO", "70");
+    service->salvarRegra(2102, "LIMITE_DIARIO", "70");
+    const int TOTAL = 5000;
+    for (int i = 0; i < TOTAL; ++i) {
+        service->verificarRegras(2101, 85.0);
+        service->resolverAlerta(service->buscarAlertasAtivos().back().getId());
+    }
+    service->verificarRegras(2102, 85.0);
+    
+    auto ativos = service->buscarAlertasAtivos();
+    if (ativos.size() != 1 || ativos.front().getUsuarioId() != 2102 ||
+        service->buscarAlertasPorUsuario(2101).size() != 1000) {
+        throw std::runtime_error("serviço não limitou o histórico de alertas encerrados");
+    }
+    
+    std::cout << "\n✓ " << TOTAL << " alertas resolvidos, 1000 mantidos, 1 ativo\n";
+}
+
+void teste22_PersistenciaSqlite() {
+    imprimirSeparador("TESTE 22: Persistência de Regras e Alertas em SQLite");
+    
+    const std::string caminho = "test_alertas_persistencia.db";
+    auto apagarBanco = [&caminho]() {
+        std::remove(caminho.c_str());
+        std::remove((caminho + "-wal").c_str());
+        std::remove((caminho + "-shm").c_str());
+    };
+    apagarBanco();
+    
+    int regraLimite;
+    int alertaResolvido;
+    {
+        auto service = AlertaServiceFactory::criarParaTeste();
+        auto banco = std::make_shared<PersistenciaAlertasSqlite>(caminho);
+        if (!service->definirPersistencia(banco)) {
+            throw std::runtime_error("persistência vazia não foi aceita");
+        }
+        
+        regraLimite = service->salvarRegra(2201, "LIMITE_DIARIO", "70");
+        int regraMedia = service->salvarRegra(2201, "MEDIA_MOVEL", "30");
+        service->desativarRegra(regraMedia);
+        service->verificarRegras(2201, 85.0);
+        service->verificarRegras(2201, 150.0);
+        alertaResolvido = service->buscarAlertasPorUsuario(2201).front().getId();
+        service->resolverAlerta(alertaResolvido);
+        
+        // Lote: todos os alertas numa única transação
+        std::map<int, double> consumos;
+        for (int usuario = 2210; usuario < 2310; ++usuario) {
+            service->salvarRegra(usuario, "LIMITE_DIARIO", "70");
+            consumos[usuario] = 100.0;
+        }
+        size_t transacoesAntes = banco->getTransacoes();
+        if (service->verificarRegrasEmLote(consumos).size() != 100 ||
+            banco->getTransacoes() != transacoesAntes + 1 || banco->getPendentes() != 0) {
+            throw std::runtime_error("alertas do lote não foram gravados numa transação");
+        }
+    }
+    
+    // Reinício: regras, alertas e ids continuam
+    auto service = AlertaServiceFactory::criarParaTeste();
+    if (!service->definirPersistencia(std::make_shared<PersistenciaAlertasSqlite>(caminho))) {
+        throw std::runtime_error("falha ao carregar o banco gravado");
+    }
+    
+    auto regras = service->buscarRegrasPorUsuario(2201);
+    if (regras.size() != 2 || !regras[0].isAtivo() || regras[1].isAtivo() ||
+        regras[0].getParametros().limiteLitros != 70.0) {
+        throw std::runtime_error("regras não foram recarregadas com parâmetros e estado");
+    }
+    auto alertas = service->buscarAlertasPorUsuario(2201);
+    if (alertas.size() != 2 || alertas[0].getStatus() != AlertaAtivo::RESOLVIDO ||
+        alertas[1].getSeveridade() != AlertaAtivo::CRITICA ||
+        service->buscarAlertasAtivos().size() != 101) {
+        throw std::runtime_error("alertas não foram recarregados");
+    }
+    
+    if (service->salvarRegra(2202, "LIMITE_DIARIO", "50") <= regraLimite + 101 ||
+        !service->verificarRegras(2202, 60.0) ||
+        service->buscarAlertasPorUsuario(2202).front().getId() != alertaResolvido + 102) {
+        throw std::runtime_error("ids recomeçaram após o reinício");
+    }
+    
+    // Ids de alertas removidos pela retenção não voltam
+    const int maiorId = service->buscarAlertasPorUsuario(2202).front().getId();
+    service.reset();
+    {
+        PersistenciaAlertasSqlite banco(caminho);
+        banco.removerAlertasAnteriores(std::time(nullptr) + 3600);
+        banco.confirmar();
+        if (!banco.carregarAlertas(0).empty() || banco.maiorIdAlerta() != maiorId) {
+            throw std::runtime_error("id de alerta removido seria reutilizado");
+        }
+    }
+    
+    // Banco travado por outra conexão: as escritas acumulam até o limite,
+    // e a falha e os descartes são contados
+    {
+        PersistenciaAlertasSqlite banco(caminho, 1000, 5);
+        sqlite3* outra = nullptr;
+        sqlite3_open(caminho.c_str(), &outra);
+        sqlite3_exec(outra, "BEGIN EXCLUSIVE;", nullptr, nullptr, nullptr);
+        for (int i = 1; i <= 8; ++i) {
+            banco.salvarAlerta(AlertaAtivo(maiorId + i, 2203, "banco travado", 90.0, "LIMITE_DIARIO"));
+        }
+        bool falhou = false;
+        try {
+            banco.confirmar();
+        } catch (const std::runtime_error&) {
+            falhou = true;
+        }
+        if (!falhou || banco.getFalhas() != 1 || banco.getPendentes() != 5 || banco.getDescartadas() != 3) {
+            throw std::runtime_error("banco travado: " + std::to_string(banco.getFalhas()) + " falhas, " +
+                                     std::to_string(banco.getPendentes()) + " pendentes, " +
+                                     std::to_string(banco.getDescartadas()) + " descartadas");
+        }
+        sqlite3_exec(outra, "ROLLBACK;", nullptr, nullptr, nullptr);
+        sqlite3_close(outra);
+        
+        banco.confirmar();
+        if (banco.getPendentes() != 0 || banco.maiorIdAlerta() != maiorId + 5) {
+            throw std::runtime_error("escritas pendentes não foram gravadas ao liberar o banco");
+        }
+    }
+    
+    apagarBanco();
+    std::cout << "\n✓ Regras, alertas e ids preservados entre execuções\n";
+}
+
+/**
+ * @brief Estratégia que acusa avaliações simultâneas de um mesmo usuário
+ */
+class EstrategiaSerializacaoTeste : public EstrategiaAnaliseConsumo {
+public:
+    mutable std::atomic<bool> sobreposicao{false};
+
+    ParametrosRegra compilarParametros(const std::string&) const override { return {}; }
+    bool analisar(double, const ParametrosRegra&) const override { return false; }
+    std::string getNome() const override { return "SERIALIZACAO"; }
+    std::string gerarMensagem(double, const ParametrosRegra&) const override { return ""; }
+
+    bool analisar(int usuarioId, double, const ParametrosRegra&) const override {
+        marcar(usuarioId);
+        return false;
+    }
+    void registrarConsumo(int usuarioId, double) override { marcar(usuarioId); }
+
+private:
+    mutable std::array<std::atomic<int>, 64> emAvaliacao{};
+
+    void marcar(int usuarioId) const {
+        auto& contador = emAvaliacao[static_cast<size_t>(usuarioId) % emAvaliacao.size()];
+        if (contador.fetch_add(1) != 0) {
+            sobreposicao = true;
+        }
+        std::this_thread::yield();
+        contador.fetch_sub(1);
+    }
+};
+
+void teste23_ConcorrenciaAlertaService() {
+    imprimirSeparador("TESTE 23: Avaliação Concorrente no AlertaService");
+    
+    auto service = AlertaServiceFactory::criarParaTeste();
+    auto contador = std::make_shared<ObserverLentoTeste>(std::chrono::milliseconds(0));
+    service->anexarObserver(contador);
+    
+    auto serializacao = std::make_shared<EstrategiaSerializacaoTeste>();
+    service->registrarEstrategiaAnalise("SERIALIZACAO", serializacao);
+    
+    const int NUM_USUARIOS = 16;
+    for (int usuario = 3000; usuario < 3000 + NUM_USUARIOS; ++usuario) {
+        service->salvarRegra(usuario, "LIMITE_DIARIO", "70");
+        service->salvarRegra(usuario, "MEDIA_MOVEL", "50");
+        service->salvarRegra(usuario, "SERIALIZACAO", "");
+        service->vincularHidrometro(usuario, "SHA-CONC-" + std::to_string(usuario));
+    }
+    
+    // Threads de ingestão avaliam os mesmos usuários (toda chamada viola o
+    // limite) enquanto um lote reavalia todos eles e outras threads
+    // cadastram regras, resolvem e consultam alertas
+    const int NUM_THREADS = 8;
+    const int ITERACOES = 200;
+    std::atomic<bool> falhou{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&, t]() {
+            try {
+                for (int i = 0; i < ITERACOES; ++i) {
+                    int usuario = 3000 + (t + i) % NUM_USUARIOS;
+                    service->verificarRegras(usuario, 85.0);
+                    service->processarLeitura("SHA-CONC-" + std::to_string(usuario),
+                                              1000.0 + i, 1700000000 + i * 60);
+                }
+            } catch (const std::exception&) {
+                falhou = true;
+            }
+        });
+    }
+    threads.emplace_back([&]() {
+        std::map<int, double> lote;
+        for (int usuario = 3000; usuario < 3000 + NUM_USUARIOS; ++usuario) {
+            lote[usuario] = 85.0;
+        }
+        for (int i = 0; i < ITERACOES / 10; ++i) {
+            service->verificarRegrasEmLote(lote, 2);
+        }
+    });
+    threads.emplace_back([&]() {
+        for (int i = 0; i < ITERACOES; ++i) {
+            service->salvarRegra(4000 + i, "LIMITE_DIARIO", "500");
+        }
+    });
+    threads.emplace_back([&]() {
+        for (int i = 0; i < ITERACOES; ++i) {
+            auto ativos = service->buscarAlertasAtivos();
+            if (!ativos.empty()) {
+                service->resolverAlerta(ativos.front().getId());
+            }
+            service->getEstatisticas();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (falhou) {
+        throw std::runtime_error("exceção durante a avaliação concorrente");
+    }
+    if (serializacao->sobreposicao) {
+        throw std::runtime_error("um mesmo usuário foi avaliado por duas threads ao mesmo tempo");
+    }
+    
+    // Cada disparo gera um alerta com id único e uma notificação
+    std::vector<AlertaAtivo> todos;
+    for (int usuario = 3000; usuario < 3000 + NUM_USUARIOS; ++usuario) {
+        auto alertas = service->buscarAlertasPorUsuario(usuario);
+        todos.insert(todos.end(), alertas.begin(), alertas.end());
+    }
+    std::set<int> ids;
+    for (const auto& alerta : todos) {
+        ids.insert(alerta.getId());
+    }
+    if (todos.size() < static_cast<size_t>(NUM_THREADS * ITERACOES) || ids.size() != todos.size() ||
+        contador->recebidos != static_cast<int>(todos.size())) {
+        throw std::runtime_error("alertas concorrentes: " + std::to_string(todos.size()) + " alertas, " +
+                                 std::to_string(ids.size()) + " ids, " +
+                                 std::to_string(contador->recebidos) + " notificações");
+    }
+    if (service->buscarRegrasPorUsuario(3000).size() != 3 || service->buscarRegrasAtivas().size() !=
+        static_cast<size_t>(3 * NUM_USUARIOS + ITERACOES)) {
+        throw std::runtime_error("regras cadastradas em paralelo se perderam");
+    }
+    
+    std::cout << "\n✓ " << todos.size() << " alertas de " << NUM_THREADS
+              << " threads, ids únicos e todos notificados\n";
+}
+
+void teste24_PainelObserverCircular() {
+    imprimirSeparador("TESTE 24: Buffer Circular do PainelObserver");
+    
+    // Cheio, o mais antigo é sobrescrito e a ordem de chegada se mantém
+    PainelObserver painel(3);
+    for (int id = 1; id <= 5; ++id) {
+        painel.atualizar(AlertaAtivo(id, 1, "alerta " + std::to_string(id), 80.0, "LIMITE_DIARIO"));
+    }
+    auto recentes = painel.getAlertasRecentes();
+    if (recentes.size() != 3 || recentes[0].getId() != 3 || recentes[2].getId() != 5 ||
+        painel.getUltimoAlerta().getId() != 5 || painel.getVersao() != 5) {
+        throw std::runtime_error("buffer circular fora de ordem");
+    }
+    
+    // O snapshot compartilha os alertas em vez de copiá-los
+    if (painel.getSnapshot()[0].get() != painel.getSnapshot()[0].get()) {
+        throw std::runtime_error("snapshot copiou os alertas");
+    }
+    
+    painel.limparAlertas();
+    if (painel.getQuantidadeAlertas() != 0 || painel.getUltimoAlerta().getId() != 0) {
+        throw std::runtime_error("limparAlertas manteve alertas");
+    }
+    painel.atualizar(AlertaAtivo(6, 1, "alerta 6", 80.0, "LIMITE_DIARIO"));
+    if (painel.getQuantidadeAlertas() != 1 || painel.getUltimoAlerta().getId() != 6) {
+        throw std::runtime_error("buffer não voltou a receber após a limpeza");
+    }
+    
+    // Leitores em paralelo com a escrita sempre veem ids consecutivos
+    const int TOTAL = 2000;
+    PainelObserver concorrente(16);
+    std::atomic<bool> terminou{false};
+    std::atomic<int> inconsistentes{0};
+    std::atomic<int> leituras{0};
+    std::vector<std::thread> leitores;
+    for (int l = 0; l < 3; ++l) {
+        leitores.emplace_back([&]() {
+            while (!terminou) {
+                auto snapshot = concorrente.getSnapshot();
+                for (size_t i = 1; i < snapshot.size(); ++i) {
+                    if (snapshot[i]->getId() != snapshot[i - 1]->getId() + 1) {
+                        ++inconsistentes;
+                    }
+                }
+                if (snapshot.size() > 16) {
+                    ++inconsistentes;
+                }
+                ++leituras;
+            }
+        });
+    }
+    for (int id = 1; id <= TOTAL; ++id) {
+        concorrente.atualizar(AlertaAtivo(id, 1, "fluxo", 80.0, "LIMITE_DIARIO"));
+    }
+    terminou = true;
+    for (auto& leitor : leitores) {
+        leitor.join();
+    }
+    if (inconsistentes != 0 || concorrente.getUltimoAlerta().getId() != TOTAL ||
+        concorrente.getQuantidadeAlertas() != 16) {
+        throw std::runtime_error(std::to_string(inconsistentes) + " snapshots inconsistentes");
+    }
+    
+    std::cout << "\n✓ " << leituras << " snapshots consistentes durante " << TOTAL << " escritas\n";
+}
+
+void teste25_PopupNaoBloqueante() {
+    imprimirSeparador("TESTE 25: Popup Assíncrono com Limite de Taxa");
+    
+    // "true" faz o papel do notify-send: sai com sucesso sem exibir nada
+    NotificacaoWindowsPopup::Configuracao configuracao;
+    configuracao.comando = "true";
+    configuracao.maxPopupsPorJanela = 2;
+    configuracao.janela = std::chrono::milliseconds(500);
+    NotificacaoWindowsPopup popup(configuracao);
+    if (!popup.isNotificadorNativo()) {
+        throw std::runtime_error("comando presente no PATH não foi encontrado");
+    }
+    
+    // Rajada: poucos processos, todos os alertas cobertos pelos resumos
+    const int RAJADA = 100;
+    for (int i = 0; i < RAJADA; ++i) {
+        if (!popup.enviar("Consumo elevado " + std::to_string(i), "usuario_" + std::to_string(i % 5))) {
+            throw std::runtime_error("enviar() recusou o popup");
+        }
+    }
+    popup.aguardar();
+    if (popup.getPopupsExibidos() > 3 || popup.getAlertasExibidos() != RAJADA || popup.getFalhas() != 0) {
+        throw std::runtime_error("rajada gerou " + std::to_string(popup.getPopupsExibidos()) +
+                                 " popups para " + std::to_string(popup.getAlertasExibidos()) + " alertas");
+    }
+    
+    // Sem notificador no PATH o popup cai para o console
+    configuracao.comando = "ssmh-notificador-inexistente";
+    NotificacaoWindowsPopup semNotificador(configuracao);
+    semNotificador.enviar("Consumo elevado", "usuario_teste");
+    semNotificador.aguardar();
+    if (semNotificador.isNotificadorNativo() || semNotificador.getAlertasExibidos() != 1) {
+        throw std::runtime_error("fallback para o console não foi usado");
+    }
+    
+    // Os resumos nomeiam todos os destinatários, não só o do último alerta:
+    // o notificador falso grava os argumentos recebidos
+    const std::string registro = "test_alertas_popup.txt";
+    const std::string notificador = "./test_alertas_notificador.sh";
+    std::remove(registro.c_str());
+    {
+        std::ofstream script(notificador);
+        script << "#!/bin/sh\nprintf '%s\\n' \"$@\" >> " << registro << "\n";
+    }
+    chmod(notificador.c_str(), 0755);
+    configuracao.comando = notificador;
+    {
+        NotificacaoWindowsPopup gravado(configuracao);
+        for (int i = 0; i < RAJADA; ++i) {
+            gravado.enviar("Consumo elevado " + std::to_string(i), "usuario_" + std::to_string(i % 5));
+        }
+        gravado.aguardar();
+    }
+    std::ifstream argumentos(registro);
+    std::string conteudo((std::istreambuf_iterator<char>(argumentos)), std::istreambuf_iterator<char>());
+    std::remove(registro.c_str());
+    std::remove(notificador.c_str());
+    for (int usuario = 0; usuario < 5; ++usuario) {
+        if (conteudo.find("usuario_" + std::to_string(usuario)) == std::string::npos) {
+            throw std::runtime_error("resumo de popups omitiu o destinatário usuario_" +
+                                     std::to_string(usuario));
+        }
+    }
+    
+    std::cout << "\n✓ " << RAJADA << " alertas em " << popup.getPopupsExibidos() << " popups\n";
+}
+
+void teste26_EstrategiaExpressao() {
+    imprimirSeparador("TESTE 26: Estratégias Definidas por Expressão");
+    
+    // Precedência, curto-circuito e constantes resolvidas na compilação
+    double variaveis[ExpressaoRegra::NUM_VARIAVEIS] = {};
+    auto avaliar = [&](const std::string& texto) {
+        return ExpressaoRegra::compilar(texto).avaliar(variaveis);
+    };
+    if (avaliar("1 + 2 * 3 == 7") != 1.0 || avaliar("-2 * -3") != 6.0 || avaliar("nao 0 e 0") != 0.0 ||
+        avaliar("1 ou 0 e 0") != 1.0 || avaliar("(1 ou 0) e 0") != 0.0 || avaliar("0 && (1 / 0 > 0)") != 0.0 ||
+        avaliar("não falso || !verdadeiro") != 1.0) {
+        throw std::runtime_error("expressão avaliada com precedência errada");
+    }
+    if (ExpressaoRegra::compilar("1 + 2 * 3 == 7").getNumInstrucoes() != 1 ||
+        ExpressaoRegra::compilar("consumo >= 10 * 15").getNumInstrucoes() != 1) {
+        throw std::runtime_error("constantes não foram resolvidas na compilação");
+    }
+    
+    variaveis[ExpressaoRegra::CONSUMO] = 160.0;
+    variaveis[ExpressaoRegra::PARAMETRO] = 100.0;
+    variaveis[ExpressaoRegra::HORA] = 23.0;
+    auto composta = ExpressaoRegra::compilar("consumo > parametro * 1.5 e (dia_util ou hora >= 22)");
+    if (composta.avaliar(variaveis) != 1.0 || !composta.usaVariavel(ExpressaoRegra::HORA) ||
+        composta.usaVariavel(ExpressaoRegra::VAZAO)) {
+        throw std::runtime_error("expressão composta avaliada incorretamente");
+    }
+    variaveis[ExpressaoRegra::HORA] = 10.0;
+    if (composta.avaliar(variaveis) != 0.0) {
+        throw std::runtime_error("curto-circuito de 'ou' com os dois lados falsos");
+    }
+    
+    for (const char* invalida : {"", "consumo >", "consumo > > 1", "volume > 1", "consumo < 1 < 2",
+                                 "(consumo > 1", "consumo = 1", "consumo & 1", "1 2"}) {
+        try {
+            ExpressaoRegra::compilar(invalida);
+            throw std::runtime_error(std::string("expressão inválida aceita: '") + invalida + "'");
+        } catch (const std::invalid_argument&) {
+        }
+    }
+    
+    // Aninhamento patológico é recusado antes de esgotar a pilha de chamadas
+    if (avaliar(std::string(100, '(') + "1" + std::string(100, ')')) != 1.0) {
+        throw std::runtime_error("100 parênteses aninhados recusados");
+    }
+    std::string nao;
+    for (int i = 0; i < 100; ++i) {
+        nao += "nao ";
+    }
+    if (avaliar(nao + "falso") != 0.0) {
+        throw std::runtime_error("100 'nao' aninhados recusados");
+    }
+    for (const std::string& patologica : {std::string(100000, '(') + "1" + std::string(100000, ')'),
+                                           std::string(100000, '-') + "1",
+                                           std::string(129, '(') + "1" + std::string(129, ')')}) {
+        try {
+            ExpressaoRegra::compilar(patologica);
+            throw std::runtime_error("expressão com " + std::to_string(patologica.size()) +
+                                     " caracteres aninhados aceita");
+        } catch (const std::invalid_argument& e) {
+            if (std::string(e.what()).find("aninhada demais") == std::string::npos) {
+                throw std::runtime_error(std::string("aninhamento recusado com outro erro: ") + e.what());
+            }
+        }
+    }
+    
+    // Regra sobre o consumo, cadastrada como qualquer outra estratégia
+    auto service = AlertaServiceFactory::criarParaTeste();
+    service->registrarEstrategiaAnalise("CONSUMO_DOBRO",
+        std::make_shared<ExpressaoStrategy>("CONSUMO_DOBRO", "consumo > parametro * 2"));
+    service->salvarRegra(2601, "CONSUMO_DOBRO", "50");
+    if (service->salvarRegra(2601, "CONSUMO_DOBRO", "abc") != -1) {
+        throw std::runtime_error("parâmetro não numérico aceito");
+    }
+    if (service->verificarRegras(2601, 90.0) || !service->verificarRegras(2601, 120.0)) {
+        throw std::runtime_error("regra de expressão sobre o consumo não disparou corretamente");
+    }
+    
+    // Regra por leitura: vazão noturna de 20 L/h por mais de 3h, um alerta por ocorrência
+    service->registrarEstrategiaAnalise("VAZAMENTO_NOTURNO",
+        std::make_shared<ExpressaoStrategy>("VAZAMENTO_NOTURNO", "vazao_noturna > parametro e horas_fluxo >= 3"));
+    service->salvarRegra(2602, "VAZAMENTO_NOTURNO", "10");
+    service->vincularHidrometro(2602, "SHA-EXPR-01");
+    std::tm meiaNoite = {};
+    meiaNoite.tm_year = 124;
+    meiaNoite.tm_mon = 2;
+    meiaNoite.tm_mday = 6;
+    meiaNoite.tm_isdst = -1;
+    const std::time_t inicio = std::mktime(&meiaNoite);
+    int disparados = 0;
+    for (int passo = 0; passo <= 10; ++passo) {
+        disparados += service->processarLeitura("SHA-EXPR-01", 1000.0 + 10.0 * passo, inicio + passo * 1800);
+    }
+    if (disparados != 1) {
+        throw std::runtime_error("vazamento noturno por expressão gerou " + std::to_string(disparados) + " alertas");
+    }
+    
+    std::cout << "\n✓ Expressões compiladas, avaliadas por consumo e por leitura\n";
+}
+
+// Mesma regra que LimiteDiarioStrategy, mas de outro tipo: o serviço a avalia regra a regra
+class LimiteDiarioEscalarTeste : public LimiteDiarioStrategy {};
+
+void teste27_LimitesVetorizados() {
+    imprimirSeparador("TESTE 27: Limite Diário Vetorizado");
+    
+    // Máscara SIMD contra a comparação escalar, com NaN e sobras fora do vetor
+    const size_t N = 203;
+    std::vector<double> consumos(N), limites(N);
+    for (size_t i = 0; i < N; ++i) {
+        consumos[i] = static_cast<double>((i * 37) % 101);
+        limites[i] = (i % 11 == 0) ? std::nan("") : static_cast<double>((i * 53) % 97);
+    }
+    consumos[5] = std::nan("");
+    std::vector<uint64_t> mascara((N + 63) / 64);
+    LimitesVetorizados::compararMaiorQue(consumos.data(), limites.data(), N, mascara.data());
+    for (size_t i = 0; i < N; ++i) {
+        bool bit = (mascara[i / 64] >> (i % 64)) & 1u;
+        if (bit != (consumos[i] > limites[i])) {
+            throw std::runtime_error("máscara divergente no índice " + std::to_string(i));
+        }
+    }
+    if (mascara.back() >> (N % 64) != 0) {
+        throw std::runtime_error("máscara marcou índices além do fim");
+    }
+    
+    // O lote vetorizado dispara os mesmos alertas, na mesma ordem, que a avaliação regra a regra
+    auto vetorizado = AlertaServiceFactory::criarParaTeste();
+    auto escalar = AlertaServiceFactory::criarParaTeste();
+    escalar->registrarEstrategiaAnalise("LIMITE_DIARIO", std::make_shared<LimiteDiarioEscalarTeste>());
+    
+    const int NUM_USUARIOS = 700;
+    std::map<int, double> consumoPorUsuario;
+    for (auto& service : {vetorizado, escalar}) {
+        for (int id = 2700; id < 2700 + NUM_USUARIOS; ++id) {
+            int regra = service->salvarRegra(id, "LIMITE_DIARIO", std::to_string(50 + id % 40));
+            if (id % 3 == 0) {
+                service->salvarRegra(id, "LIMITE_DIARIO", std::to_string(80 + id % 13));
+            }
+            if (id % 5 == 0) {
+                service->salvarRegra(id, "MEDIA_MOVEL", "50");
+            }
+            if (id % 7 == 0) {
+                service->desativarRegra(regra);
+            }
+        }
+    }
+    for (int id = 2700; id < 2700 + NUM_USUARIOS; id += 2) {
+        consumoPorUsuario[id] = static_cast<double>(id % 120);
+    }
+    
+    auto disparadosVetorizado = vetorizado->verificarRegrasEmLote(consumoPorUsuario, 3);
+    auto disparadosEscalar = escalar->verificarRegrasEmLote(consumoPorUsuario, 3);
+    if (disparadosVetorizado.empty() || disparadosVetorizado.size() != disparadosEscalar.size()) {
+        throw std::runtime_error("lote vetorizado disparou " + std::to_string(disparadosVetorizado.size()) +
+                                 " alertas, o escalar " + std::to_string(disparadosEscalar.size()));
+    }
+    for (size_t i = 0; i < disparadosVetorizado.size(); ++i) {
+        const AlertaAtivo& a = disparadosVetorizado[i];
+        const AlertaAtivo& b = disparadosEscalar[i];
+        if (a.getUsuarioId() != b.getUsuarioId() || a.getMensagem() != b.getMensagem() ||
+            a.getSeveridade() != b.getSeveridade()) {
+            throw std::runtime_error("alerta " + std::to_string(i) + " difere entre os lotes");
+        }
+    }
+    
+    // Regras salvas depois continuam entrando na avaliação em bloco
+    int nova = vetorizado->salvarRegra(2701, "LIMITE_DIARIO", "10");
+    auto disparadosNova = vetorizado->verificarRegrasEmLote({{2701, 30.0}}, 1);
+    if (disparadosNova.size() != 1 || disparadosNova[0].getUsuarioId() != 2701 || nova < 0) {
+        throw std::runtime_error("regra nova não entrou na avaliação vetorizada");
+    }
+    
+    std::cout << "\n✓ " << disparadosVetorizado.size()
+              << " alertas idênticos aos da avaliação regra a regra\n";
+}
+
+void teste28_FachadaLiberaServicos() {
+    imprimirSeparador("TESTE 28: Fachada Não Prende os Serviços");
+    
+    // Fonte de consumo (Alertas → Monitoramento) e ouvinte de leituras
+    // (Monitoramento → Alertas) não podem formar um ciclo de shared_ptr
+    std::weak_ptr<AlertaService> alertasFraco;
+    std::weak_ptr<MonitoramentoService> monitoramentoFraco;
+    std::weak_ptr<UsuarioService> usuariosFraco;
+    {
+        auto usuarios = std::make_shared<UsuarioService>();
+        auto monitoramento = MonitoramentoServiceFactory::criar();
+        auto alertas = AlertaServiceFactory::criarMinimalista();
+        alertasFraco = alertas;
+        monitoramentoFraco = monitoramento;
+        usuariosFraco = usuarios;
+        
+        auto fachada = std::make_unique<FachadaSSMH>(usuarios, monitoramento, alertas);
+        alertas->salvarRegra(2801, "LIMITE_DIARIO", "10");
+        fachada->registrarLeituraManual("SHA2801", 100);
+        alertas->executarVerificacaoAutomatica();
+        
+        // Sem o AlertaService, o ouvinte que ficou no Monitoramento é ignorado
+        auto outroMonitoramento = MonitoramentoServiceFactory::criar();
+        {
+            auto outrosAlertas = AlertaServiceFactory::criarMinimalista();
+            FachadaSSMH outra(usuarios, outroMonitoramento, outrosAlertas);
+        }
+        outroMonitoramento->registrarLeituraManual("SHA2802", 50);
+        
+        fachada.reset();
+    }
+    
+    if (!alertasFraco.expired() || !monitoramentoFraco.expired() || !usuariosFraco.expired()) {
+        throw std::runtime_error("serviços continuam vivos depois da Fachada e dos donos");
+    }
+    std::cout << "\n✓ AlertaService, MonitoramentoService e UsuarioService destruídos com a Fachada\n";
+}
+
 int main() {
     std::cout << "\n";
     std::cout << "╔═══════════════════════════════════════════════════════════════════╗\n";
@@ -289,6 +1844,24 @@ int main() {
         teste8_FactoryPatterns();
         teste9_GerenciamentoAlertas();
         teste10_EstatisticasCompletas();
+        teste11_IndiceRegras();
+        teste12_ParametrosInvalidos();
+        teste13_VerificacaoEmLote();
+        teste14_MediaMovel();
+        teste15_VazamentoPorLeituras();
+        teste16_AvaliacaoPorLeitura();
+        teste17_NotificacaoAssincrona();
+        teste18_ResumoEmail();
+        teste19_PoolConexoesETokens();
+        teste20_SupressaoAlertas();
+        teste21_RepositorioAlertas();
+        teste22_PersistenciaSqlite();
+        teste23_ConcorrenciaAlertaService();
+        teste24_PainelObserverCircular();
+        teste25_PopupNaoBloqueante();
+        teste26_EstrategiaExpressao();
+        teste27_LimitesVetorizados();
+        teste28_FachadaLiberaServicos();
 
         imprimirSeparador("RESULTADO FINAL");
         std::cout << "\n✅ TODOS OS TESTES EXECUTADOS COM SUCESSO!\n\n";
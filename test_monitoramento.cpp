@@ -9,10 +9,19 @@
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#include <atomic>
+#include <chrono>
 #include <ctime>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <zlib.h>
 #include "src/monitoramento/services/monitoramento_service_factory.hpp"
 #include "src/monitoramento/domain/leitura.hpp"
 #include "src/utils/logger.hpp"
+#include "src/utils/metricas.hpp"
 
 using namespace std;
 
@@ -228,6 +237,18 @@ void testarConsultasAvancadas() {
         cout << "   • " << leitura.getDataHoraFormatada() 
              << " - " << leitura.getValor() << "L\n";
     }
+    
+    // Teste 5: Consulta em lote (um grupo por usuário)
+    cout << "\n5. Consumo em lote (grupos de hidrômetros):\n";
+    vector<vector<string>> grupos = {{sha1}, {sha2}, {sha1, sha2}, {}, {"SHA_INEXISTENTE"}};
+    vector<double> consumosLote = servico->consultarConsumoEmLote(grupos, inicio, fim);
+    vector<double> esperados = {consumo1, consumo2, consumoAgregado, 0.0, 0.0};
+    
+    if (consumosLote != esperados) {
+        throw runtime_error("consulta em lote divergiu das consultas individuais");
+    }
+    cout << "   " << grupos.size() << " grupos consultados de uma vez, "
+         << "resultados iguais às consultas individuais\n";
 }
 
 void testarPadroesIntegrados() {
@@ -269,6 +290,559 @@ void testarPadroesIntegrados() {
     cout << "\n✅ Mesma interface para ambos os casos (ConsumoMonitoravel)!\n";
 }
 
+// Linhas da exportação Prometheus que mencionam `prefixo`
+string linhasExportadas(const string& exportacao, const string& prefixo) {
+    istringstream entrada(exportacao);
+    string linha;
+    string selecionadas;
+    while (getline(entrada, linha)) {
+        if (linha.find(prefixo) != string::npos) {
+            selecionadas += linha + "\n";
+        }
+    }
+    return selecionadas;
+}
+
+void testarRegistroMetricas() {
+    imprimirTitulo("TESTE 7: Registro de Métricas e Exportação Prometheus");
+    
+    RegistroMetricas& registro = RegistroMetricas::getInstance();
+    
+    // Contadores: mesma chave, mesma referência; incrementos de várias threads
+    ContadorMetrica& contadorA = registro.contador("ssmh_teste_operacoes_total", "operacao=\"a\"");
+    ContadorMetrica& contadorB = registro.contador("ssmh_teste_operacoes_total", "operacao=\"b\"");
+    if (&contadorA != &registro.contador("ssmh_teste_operacoes_total", "operacao=\"a\"") ||
+        &contadorA == &contadorB) {
+        throw runtime_error("contadores não são identificados por (nome, rótulos)");
+    }
+    vector<thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&contadorA]() {
+            for (int i = 0; i < 10000; ++i) {
+                contadorA.incrementar();
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    contadorB.incrementar(3);
+    if (contadorA.valor() != 80000 || contadorB.valor() != 3) {
+        throw runtime_error("contador somou " + to_string(contadorA.valor()) + " de 80000 incrementos");
+    }
+    cout << "\n✓ 80000 incrementos de 8 threads somados nas fatias\n";
+    
+    // Buckets: cada valor cai no bucket cujo intervalo o contém, com erro
+    // relativo de no máximo 1/16
+    for (uint64_t base = 1; base < (uint64_t(1) << 40); base <<= 1) {
+        for (uint64_t valor : {base - 1, base, base + 1, base + base / 3}) {
+            int indice = HistogramaLatencia::indiceBucket(valor);
+            uint64_t superior = HistogramaLatencia::limiteSuperior(indice);
+            uint64_t inferior = indice == 0 ? 0 : HistogramaLatencia::limiteSuperior(indice - 1) + 1;
+            if (valor < inferior || valor > superior || (superior - inferior) * 16 > max<uint64_t>(valor, 16)) {
+                throw runtime_error("valor " + to_string(valor) + " no bucket [" + to_string(inferior) +
+                                    ", " + to_string(superior) + "]");
+            }
+        }
+    }
+    if (HistogramaLatencia::indiceBucket(uint64_t(1) << 62) != HistogramaLatencia::NUM_BUCKETS - 1) {
+        throw runtime_error("valor acima do expoente máximo fora do último bucket");
+    }
+    
+    // Percentis pelo limite superior do bucket: 500ns e 1us ficam abaixo
+    // da mediana; 3ms e 2s, acima
+    HistogramaLatencia& histograma = registro.histograma("ssmh_teste_latencia_segundos");
+    for (uint64_t ns : {500ull, 1000ull, 3000000ull, 2000000000ull}) {
+        histograma.registrar(ns);
+    }
+    ResumoHistograma resumo = histograma.resumir();
+    if (resumo.contagem != 4 || resumo.somaNs != 2003001500ull || resumo.p50Ns != 1023 ||
+        resumo.p90Ns != 2013265919ull || resumo.p99Ns != 2013265919ull || resumo.maxNs != 2013265919ull) {
+        throw runtime_error("resumo do histograma: p50=" + to_string(resumo.p50Ns) +
+                            " p90=" + to_string(resumo.p90Ns) + " max=" + to_string(resumo.maxNs));
+    }
+    cout << "✓ Percentis: p50=" << resumo.p50Ns << "ns, p99=" << resumo.p99Ns << "ns\n";
+    
+    // Formato texto exato; um bucket HDR só entra no `le` que cobre todo o
+    // seu intervalo, então 1000ns (bucket 992-1023) conta a partir de 5us
+    const string esperado =
+        "# TYPE ssmh_teste_latencia_segundos histogram\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"1e-06\"} 1\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"5e-06\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"1e-05\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"2.5e-05\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"5e-05\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.0001\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.00025\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.0005\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.001\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.0025\"} 2\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.005\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.01\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.025\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.05\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.1\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.25\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"0.5\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"1\"} 3\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"2.5\"} 4\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"5\"} 4\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"10\"} 4\n"
+        "ssmh_teste_latencia_segundos_bucket{le=\"+Inf\"} 4\n"
+        "ssmh_teste_latencia_segundos_sum 2.0030015\n"
+        "ssmh_teste_latencia_segundos_count 4\n"
+        "# TYPE ssmh_teste_operacoes_total counter\n"
+        "ssmh_teste_operacoes_total{operacao=\"a\"} 80000\n"
+        "ssmh_teste_operacoes_total{operacao=\"b\"} 3\n";
+    const string exportacao = registro.exportarPrometheus();
+    // Contadores vêm antes dos histogramas na exportação
+    const string obtido = linhasExportadas(exportacao, "ssmh_teste_latencia") +
+                          linhasExportadas(exportacao, "ssmh_teste_operacoes");
+    if (obtido != esperado) {
+        throw runtime_error("exportação Prometheus divergiu:\n" + obtido);
+    }
+    if (exportacao.find("# TYPE ssmh_teste_operacoes_total counter") >
+        exportacao.find("# TYPE ssmh_teste_latencia_segundos histogram")) {
+        throw runtime_error("contadores exportados depois dos histogramas");
+    }
+    
+    // Arquivo: mesmo conteúdo, sem o temporário
+    const string caminho = "test_monitoramento.prom";
+    if (!registro.exportarPrometheusArquivo(caminho)) {
+        throw runtime_error("falha ao gravar a exportação Prometheus");
+    }
+    ifstream arquivo(caminho);
+    string gravado((istreambuf_iterator<char>(arquivo)), istreambuf_iterator<char>());
+    ifstream temporario(caminho + ".tmp");
+    bool sobrouTemporario = temporario.is_open();
+    remove(caminho.c_str());
+    if (linhasExportadas(gravado, "ssmh_teste_") != linhasExportadas(exportacao, "ssmh_teste_") ||
+        sobrouTemporario) {
+        throw runtime_error("arquivo Prometheus difere da exportação");
+    }
+    cout << "✓ Exportação Prometheus no formato texto 0.0.4, idêntica em arquivo\n";
+}
+
+// Linhas de `caminho` que contêm `marcador`
+size_t contarLinhas(const string& caminho, const string& marcador) {
+    ifstream arquivo(caminho);
+    string linha;
+    size_t total = 0;
+    while (getline(arquivo, linha)) {
+        if (linha.find(marcador) != string::npos) {
+            ++total;
+        }
+    }
+    return total;
+}
+
+void testarLoggerAssincrono() {
+    imprimirTitulo("TESTE 8: Logger Assíncrono");
+    
+    Logger& logger = Logger::getInstance();
+    const string caminho = "test_monitoramento_assincrono.log";
+    remove(caminho.c_str());
+    logger.setArquivoLog(caminho);
+    
+    // Desligar sem descarregar grava tudo o que estava nos buffers
+    logger.setModoAssincrono(true);
+    thread([&logger]() {
+        for (int i = 0; i < 1000; ++i) {
+            logger.log(LogLevel::DEBUG, "Teste8", "pendente " + to_string(i));
+        }
+    }).join();
+    logger.setModoAssincrono(false);
+    if (contarLinhas(caminho, "[Teste8] pendente ") != 1000) {
+        throw runtime_error("mensagens perdidas ao desligar o modo assíncrono");
+    }
+    cout << "\n✓ 1000 mensagens pendentes gravadas ao desligar o modo\n";
+    
+    // Threads logando enquanto o modo é desligado: nada se perde
+    uint64_t descartadasAntes = logger.getMensagensDescartadas();
+    logger.setModoAssincrono(true);
+    atomic<bool> parar{false};
+    atomic<size_t> registradas{0};
+    vector<thread> produtores;
+    for (int t = 0; t < 4; ++t) {
+        produtores.emplace_back([&]() {
+            for (int i = 0; i < 50000 && !parar.load(); ++i) {
+                logger.log(LogLevel::DEBUG, "Teste8", "concorrente");
+                registradas.fetch_add(1);
+            }
+        });
+    }
+    this_thread::sleep_for(chrono::milliseconds(2));
+    logger.setModoAssincrono(false);
+    this_thread::sleep_for(chrono::milliseconds(5));
+    parar.store(true);
+    for (auto& t : produtores) {
+        t.join();
+    }
+    size_t gravadas = contarLinhas(caminho, "[Teste8] concorrente");
+    if (gravadas + (logger.getMensagensDescartadas() - descartadasAntes) != registradas.load()) {
+        throw runtime_error(to_string(registradas.load()) + " mensagens registradas, " +
+                            to_string(gravadas) + " gravadas");
+    }
+    cout << "✓ " << registradas.load() << " mensagens de 4 threads contabilizadas durante o desligamento\n";
+    
+    // Buffer cheio: o excedente é descartado, contado e avisado no arquivo
+    descartadasAntes = logger.getMensagensDescartadas();
+    logger.setModoAssincrono(true, 4);
+    thread([&logger]() {
+        for (int i = 0; i < 10000; ++i) {
+            logger.log(LogLevel::DEBUG, "Teste8", "rajada");
+        }
+    }).join();
+    logger.setModoAssincrono(false);
+    uint64_t descartadas = logger.getMensagensDescartadas() - descartadasAntes;
+    size_t gravadasRajada = contarLinhas(caminho, "[Teste8] rajada");
+    if (descartadas == 0 || gravadasRajada + descartadas != 10000 ||
+        contarLinhas(caminho, "mensagens descartadas (buffer cheio)") == 0) {
+        throw runtime_error("descarte: " + to_string(gravadasRajada) + " gravadas, " +
+                            to_string(descartadas) + " descartadas de 10000");
+    }
+    cout << "✓ Buffer de 4 mensagens: " << gravadasRajada << " gravadas, " << descartadas
+         << " descartadas e avisadas\n";
+    
+    logger.setArquivoLog("test_monitoramento.log");
+    remove(caminho.c_str());
+}
+
+void testarMacrosLog() {
+    imprimirTitulo("TESTE 9: Macros SSMH_LOG_* Preguiçosas");
+    
+    Logger& logger = Logger::getInstance();
+    const string caminho = "test_monitoramento_macros.log";
+    remove(caminho.c_str());
+    logger.setArquivoLog(caminho);
+    
+    int avaliacoes = 0;
+    auto montar = [&avaliacoes](int id) {
+        ++avaliacoes;
+        return "mensagem montada " + to_string(id);
+    };
+    
+    // Debug desligado: a expressão da mensagem nem é avaliada
+    Logger::setDebugMode(false);
+    SSMH_LOG_DEBUG("Teste9", montar(1));
+    SSMH_LOGF_DEBUG("Teste9", "formatada {} de {}", montar(2), "SHA001");
+    if (avaliacoes != 0 || contarLinhas(caminho, "[Teste9]") != 0) {
+        throw runtime_error("mensagem de nível desabilitado foi montada");
+    }
+    cout << "\n✓ DEBUG desligado: mensagens não montadas\n";
+    
+    // Debug ligado: monta uma vez e grava, inclusive com argumentos tipados
+    Logger::setDebugMode(true);
+    SSMH_LOG_DEBUG("Teste9", montar(3));
+    SSMH_LOGF_DEBUG("Teste9", "leitura {} do SHA {} ({} L)", 7, "SHA001", 1.5);
+    Logger::setDebugMode(false);
+    logger.descarregar();
+    if (avaliacoes != 1 || contarLinhas(caminho, "[DEBUG] [Teste9] mensagem montada 3") != 1 ||
+        contarLinhas(caminho, "[DEBUG] [Teste9] leitura 7 do SHA SHA001 (1.500000 L)") != 1) {
+        throw runtime_error("mensagem de nível habilitado não foi gravada como esperado");
+    }
+    cout << "✓ DEBUG ligado: mensagens montadas uma vez e gravadas\n";
+    
+    logger.setArquivoLog("test_monitoramento.log");
+    remove(caminho.c_str());
+}
+
+// Saída de ./logdecode (gerado por make logdecode) sem o timestamp de cada linha
+vector<string> decodificarLog(const string& argumentos) {
+    ifstream ferramenta("./logdecode");
+    if (!ferramenta.is_open()) {
+        throw runtime_error("./logdecode não encontrado (make logdecode)");
+    }
+    FILE* saida = popen(("./logdecode " + argumentos).c_str(), "r");
+    if (!saida) {
+        throw runtime_error("falha ao executar ./logdecode");
+    }
+    vector<string> linhas;
+    string linha;
+    int c;
+    while ((c = fgetc(saida)) != EOF) {
+        if (c != '\n') {
+            linha += static_cast<char>(c);
+            continue;
+        }
+        // "[AAAA-MM-DD HH:MM:SS] " tem 22 caracteres
+        if (linha.size() < 22 || linha[0] != '[' || linha[20] != ']') {
+            pclose(saida);
+            throw runtime_error("linha do logdecode sem timestamp: " + linha);
+        }
+        linhas.push_back(linha.substr(22));
+        linha.clear();
+    }
+    if (pclose(saida) != 0) {
+        throw runtime_error("./logdecode terminou com erro");
+    }
+    return linhas;
+}
+
+void testarLogBinario() {
+    imprimirTitulo("TESTE 10: Log Binário e logdecode");
+    
+    Logger& logger = Logger::getInstance();
+    const string caminho = "test_monitoramento.blog";
+    auto removerArquivos = [&caminho]() {
+        remove(caminho.c_str());
+        for (int i = 1; i <= 10; ++i) {
+            remove((caminho + "." + to_string(i)).c_str());
+        }
+    };
+    removerArquivos();
+    
+    // Ida e volta: argumentos tipados gravados sem formatação e
+    // reconstruídos pelo leitor
+    auto ns = []() {
+        return chrono::duration_cast<chrono::nanoseconds>(
+            chrono::system_clock::now().time_since_epoch()).count();
+    };
+    int64_t antes = ns();
+    if (!logger.setArquivoLogBinario(caminho)) {
+        throw runtime_error("falha ao abrir o log binário");
+    }
+    logger.logEstruturado(LogLevel::DEBUG, "Teste10", "leitura {} do SHA {} ({} L)", 7, "SHA001", 1.5);
+    logger.logEstruturado(LogLevel::DEBUG, "Teste10", "negativo {} e texto {}|{}", -42, string("com {} dentro"), "");
+    logger.log(LogLevel::DEBUG, "Teste10::log", "via log() com {} literal");
+    logger.fecharArquivoBinario();
+    int64_t depois = ns();
+    
+    const vector<string> esperadas = {
+        "leitura 7 do SHA SHA001 (1.500000 L)",
+        "negativo -42 e texto com {} dentro|",
+        "via log() com {} literal",
+    };
+    LeitorLogBinario leitor(caminho);
+    LeitorLogBinario::Registro registro;
+    int64_t anterior = antes;
+    size_t lidos = 0;
+    while (leitor.proximo(registro)) {
+        if (lidos >= esperadas.size() || registro.mensagem != esperadas[lidos] ||
+            registro.nivel != static_cast<uint8_t>(LogLevel::DEBUG) ||
+            registro.contexto != (lidos == 2 ? "Teste10::log" : "Teste10") ||
+            registro.timestampNs < anterior || registro.timestampNs > depois) {
+            throw runtime_error("registro binário " + to_string(lidos) + " divergiu: " + registro.mensagem);
+        }
+        anterior = registro.timestampNs;
+        ++lidos;
+    }
+    if (lidos != esperadas.size()) {
+        throw runtime_error(to_string(lidos) + " registros lidos do log binário");
+    }
+    cout << "\n✓ Inteiro, real e textos reconstruídos pelo leitor com nível, contexto e timestamp\n";
+    
+    vector<string> decodificadas = decodificarLog(caminho);
+    if (decodificadas != vector<string>{"[DEBUG] [Teste10] " + esperadas[0],
+                                        "[DEBUG] [Teste10] " + esperadas[1],
+                                        "[DEBUG] [Teste10::log] " + esperadas[2]}) {
+        throw runtime_error("logdecode divergiu do log texto");
+    }
+    cout << "✓ logdecode imprime as linhas no formato do log texto\n";
+    
+    // Rotação: cada arquivo traz o próprio dicionário e decodifica sozinho
+    removerArquivos();
+    logger.setArquivoLogBinario(caminho, 1024, 10);
+    for (int i = 0; i < 100; ++i) {
+        logger.logEstruturado(LogLevel::DEBUG, "Teste10", "mensagem {}", i);
+    }
+    logger.fecharArquivoBinario();
+    
+    string serie;
+    size_t arquivos = 0;
+    size_t registros = 0;
+    for (int i = 10; i >= 0; --i) {
+        string arquivo = i == 0 ? caminho : caminho + "." + to_string(i);
+        if (!ifstream(arquivo).is_open()) {
+            continue;
+        }
+        LeitorLogBinario leitorArquivo(arquivo);
+        while (leitorArquivo.proximo(registro)) {
+            ++registros;
+        }
+        serie += arquivo + " ";
+        ++arquivos;
+    }
+    decodificadas = decodificarLog(serie);
+    bool emOrdem = decodificadas.size() == 100;
+    for (size_t i = 0; emOrdem && i < decodificadas.size(); ++i) {
+        emOrdem = decodificadas[i] == "[DEBUG] [Teste10] mensagem " + to_string(i);
+    }
+    if (arquivos < 3 || registros != 100 || !emOrdem) {
+        throw runtime_error("rotação do log binário: " + to_string(arquivos) + " arquivos, " +
+                            to_string(registros) + " registros");
+    }
+    cout << "✓ " << arquivos << " arquivos rotacionados, cada um decodificável, 100 mensagens em ordem\n";
+    
+    removerArquivos();
+}
+
+// Conteúdo descomprimido de um .gz ("" se não existir)
+string lerGzip(const string& caminho) {
+    gzFile arquivo = gzopen(caminho.c_str(), "rb");
+    if (!arquivo) {
+        return "";
+    }
+    string conteudo;
+    char bloco[4096];
+    int lidos;
+    while ((lidos = gzread(arquivo, bloco, sizeof(bloco))) > 0) {
+        conteudo.append(bloco, static_cast<size_t>(lidos));
+    }
+    gzclose(arquivo);
+    return conteudo;
+}
+
+void testarRotacaoLog() {
+    imprimirTitulo("TESTE 11: Rotação do Log Texto com Compressão");
+    
+    Logger& logger = Logger::getInstance();
+    const string caminho = "test_monitoramento_rotacao.log";
+    const size_t limite = 2048;
+    auto removerArquivos = [&caminho]() {
+        remove(caminho.c_str());
+        for (int i = 1; i <= 5; ++i) {
+            remove((caminho + "." + to_string(i) + ".gz").c_str());
+        }
+    };
+    removerArquivos();
+    
+    logger.setArquivoLog(caminho);
+    logger.setRotacao(limite, 0, 5, true);
+    for (int i = 0; i < 100; ++i) {
+        logger.log(LogLevel::DEBUG, "Teste11", "linha de rotação " + to_string(i));
+    }
+    
+    // A compressão roda em segundo plano: espera todas as linhas aparecerem
+    auto contarTodas = [&]() {
+        size_t total = contarLinhas(caminho, "[Teste11] linha de rotação ");
+        for (int i = 1; i <= 5; ++i) {
+            istringstream conteudo(lerGzip(caminho + "." + to_string(i) + ".gz"));
+            string linha;
+            while (getline(conteudo, linha)) {
+                total += linha.find("[Teste11] linha de rotação ") != string::npos;
+            }
+        }
+        return total;
+    };
+    auto prazo = chrono::steady_clock::now() + chrono::seconds(10);
+    while (contarTodas() != 100 && chrono::steady_clock::now() < prazo) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    
+    // O .1.gz foi aberto pela própria rotação: cabe inteiro no limite e
+    // termina numa linha completa; a última linha está no arquivo atual
+    string maisRecente = lerGzip(caminho + ".1.gz");
+    size_t comprimidos = 0;
+    for (int i = 1; i <= 5; ++i) {
+        comprimidos += ifstream(caminho + "." + to_string(i) + ".gz").is_open();
+    }
+    if (contarTodas() != 100 || comprimidos < 2 || maisRecente.empty() ||
+        maisRecente.size() > limite || maisRecente.back() != '\n' ||
+        contarLinhas(caminho, "[Teste11] linha de rotação 99") != 1 ||
+        ifstream(caminho + ".1").is_open()) {
+        throw runtime_error("rotação: " + to_string(contarTodas()) + " linhas em " +
+                            to_string(comprimidos) + " arquivos comprimidos + atual");
+    }
+    cout << "\n✓ 100 linhas distribuídas entre " << comprimidos << " arquivos .gz (até " << limite
+         << " bytes cada) e o arquivo atual\n";
+    
+    logger.setRotacao(0, 0, 5, false);
+    logger.setArquivoLog("test_monitoramento.log");
+    removerArquivos();
+}
+
+void testarCacheTimestamp() {
+    imprimirTitulo("TESTE 12: Cache do Timestamp do Log");
+    
+    auto referencia = [](time_t instante) {
+        tm ltm;
+        localtime_r(&instante, &ltm);
+        char texto[32];
+        strftime(texto, sizeof(texto), "%Y-%m-%d %H:%M:%S", &ltm);
+        return string(texto);
+    };
+    auto formatar = [](CacheTimestamp& cache, time_t instante, int milissegundos) {
+        char texto[CacheTimestamp::TAMANHO_BUFFER];
+        size_t tamanho = cache.formatar(instante, milissegundos, texto);
+        return string(texto, tamanho);
+    };
+    
+    // Virada de segundo, minuto e dia invalidam o texto; um instante mais
+    // antigo é formatado à parte sem derrubar o segundo em cache
+    CacheTimestamp cache;
+    const time_t base = 1700000000 - 1700000000 % 60 + 59;  // hh:mm:59
+    vector<pair<time_t, int>> sequencia = {
+        {base, -1}, {base, -1}, {base + 1, -1}, {base, 7}, {base + 1, 999},
+        {base + 86400, -1}, {base + 86400, 0}, {base + 86401, 42},
+    };
+    for (const auto& [instante, ms] : sequencia) {
+        string esperado = referencia(instante);
+        if (ms >= 0) {
+            char sufixo[16];
+            snprintf(sufixo, sizeof(sufixo), ".%03d", ms);
+            esperado += sufixo;
+        }
+        string obtido = formatar(cache, instante, ms);
+        if (obtido != esperado) {
+            throw runtime_error("timestamp " + obtido + ", esperado " + esperado);
+        }
+    }
+    cout << "\n✓ Viradas de segundo, minuto e dia e instantes atrasados formatados corretamente\n";
+    
+    // Relógio real: atravessa uma virada de segundo chamando formatarAgora
+    CacheTimestamp cacheAgora;
+    string primeiro;
+    string ultimo;
+    auto prazo = chrono::steady_clock::now() + chrono::milliseconds(1500);
+    while (chrono::steady_clock::now() < prazo) {
+        time_t antes = time(nullptr);
+        char texto[CacheTimestamp::TAMANHO_BUFFER];
+        cacheAgora.formatarAgora(texto);
+        time_t depois = time(nullptr);
+        if (texto != referencia(antes) && texto != referencia(depois)) {
+            throw runtime_error(string("formatarAgora devolveu ") + texto + " fora do segundo corrente");
+        }
+        if (primeiro.empty()) {
+            primeiro = texto;
+        }
+        ultimo = texto;
+        if (ultimo != primeiro) {
+            break;
+        }
+    }
+    if (ultimo == primeiro) {
+        throw runtime_error("formatarAgora não acompanhou a virada do segundo");
+    }
+    cout << "✓ formatarAgora acompanhou a virada " << primeiro << " → " << ultimo << "\n";
+    
+    // Threads avançando o segundo ao mesmo tempo nunca leem texto misturado
+    const int segundos = 1000;
+    vector<string> referencias;
+    for (int i = 0; i < segundos; ++i) {
+        referencias.push_back(referencia(base + i));
+    }
+    CacheTimestamp cacheCompartilhado;
+    atomic<int> divergentes{0};
+    vector<thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < segundos * 100; ++i) {
+                if (formatar(cacheCompartilhado, base + i / 100, -1) != referencias[i / 100]) {
+                    divergentes.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    if (divergentes.load() != 0) {
+        throw runtime_error(to_string(divergentes.load()) + " timestamps divergentes entre threads");
+    }
+    cout << "✓ 4 threads × " << segundos << " viradas sem leituras inconsistentes\n";
+}
+
 void exibirResumo() {
     imprimirTitulo("RESUMO DOS PADRÕES IMPLEMENTADOS");
     
@@ -321,6 +895,12 @@ int main() {
         testarCompositeUsuario();
         testarConsultasAvancadas();
         testarPadroesIntegrados();
+        testarRegistroMetricas();
+        testarLoggerAssincrono();
+        testarMacrosLog();
+        testarLogBinario();
+        testarRotacaoLog();
+        testarCacheTimestamp();
         exibirResumo();
         
         imprimirTitulo("TODOS OS TESTES CONCLUÍDOS COM SUCESSO! ✅");